@@ -27,5 +27,6 @@
 
 #define RF_TLM_PERF_ID 91
 #define RF_TLM_I2C_SEND_PERF_ID 92
+#define RF_TLM_UPLINK_PERF_ID 93
 
 #endif /* RF_TLM_PERFIDS_H */
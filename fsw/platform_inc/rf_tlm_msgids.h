@@ -32,5 +32,6 @@
 #define RF_TLM_SEND_HK_MID 0x18F1
 /* V1 Telemetry Message IDs must be 0x08xx */
 #define RF_TLM_HK_TLM_MID  0x08F1
+#define RF_TLM_LINKTEST_TLM_MID 0x08F2
 
 #endif /* RF_TLM_MSGIDS_H */
@@ -0,0 +1,127 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ * RF Telemetry Output App build profile
+ *
+ * The full profile, the default, builds every feature. Defining RF_TLM_LEAN
+ * (CMake option RF_TLM_LEAN) selects the lean flight profile: debug tracing,
+ * the send and uplink performance markers and the fragment encoding compile
+ * out, and the forwarded sources are resolved from the fixed list below at
+ * compile time. Each RF_TLM_CFG_* switch can also be set on its own.
+ */
+
+#ifndef RF_TLM_PLATFORM_CFG_H
+#define RF_TLM_PLATFORM_CFG_H
+
+#ifdef RF_TLM_LEAN
+#define RF_TLM_CFG_FULL 0
+#else
+#define RF_TLM_CFG_FULL 1
+#endif
+
+/*
+** Debug events for every frame sent, switched by RF_TLM_ENABLE_DEBUG_CC
+*/
+#ifndef RF_TLM_CFG_DEBUG
+#define RF_TLM_CFG_DEBUG RF_TLM_CFG_FULL
+#endif
+
+/*
+** Performance markers around each I2C send and uplink poll. The app's
+** own marker, RF_TLM_PERF_ID, is always built.
+*/
+#ifndef RF_TLM_CFG_PERF_MARKERS
+#define RF_TLM_CFG_PERF_MARKERS RF_TLM_CFG_FULL
+#endif
+
+/*
+** Encodings other than raw. The flight profiles pack their sources, the
+** fragment encoding is only selected by command.
+*/
+#ifndef RF_TLM_CFG_ENC_PACKED
+#define RF_TLM_CFG_ENC_PACKED 1
+#endif
+
+#ifndef RF_TLM_CFG_ENC_FRAGMENT
+#define RF_TLM_CFG_ENC_FRAGMENT RF_TLM_CFG_FULL
+#endif
+
+/*
+** Source lookup by a switch over RF_TLM_SOURCE_LIST instead of a search
+** of the subscribed sources
+*/
+#ifndef RF_TLM_CFG_FIXED_SOURCES
+#define RF_TLM_CFG_FIXED_SOURCES (!RF_TLM_CFG_FULL)
+#endif
+
+/*
+** GPIO hooks for I2C bus recovery: the name of the const uC_recovery_pins
+** the board support package defines for the uC's bus, see gen-uC.h. Left
+** undefined, a hung bus gets no clock-out and recoveries are reported as
+** failed.
+*/
+/* #define RF_TLM_I2C_RECOVERY_PINS bsp_i2c2_recovery_pins */
+
+/*
+** Downlink framing at startup, RF_TLM_FRAMING_*, and the CCSDS channel:
+** spacecraft ID, virtual channel and the APID of the packets that carry
+** time references and acknowledgements
+*/
+#define RF_TLM_FRAMING_DEFAULT RF_TLM_FRAMING_NATIVE
+#define RF_TLM_CCSDS_SCID      0x0AB
+#define RF_TLM_CCSDS_VCID      0
+#define RF_TLM_CCSDS_LINK_APID 0x0F0
+
+/*
+** Downlink compression at startup, RF_TLM_COMPRESS_*
+*/
+#define RF_TLM_COMPRESS_DEFAULT RF_TLM_COMPRESS_OFF
+
+/*
+** Forwarded sources, in subscription order: X(Tag, message ID, name)
+*/
+#define RF_TLM_SOURCE_LIST(X)                             \
+    X(IMU, IMU_APP_RF_DATA_MID, "IMU App")                \
+    X(BLINKY, BLINKY_RF_DATA_MID, "Blinky App")           \
+    X(ALTITUDE, ALTITUDE_APP_RF_DATA_MID, "Altitude App") \
+    X(TEMP, TEMP_APP_RF_DATA_MID, "Temp App")
+
+/*
+** Apps whose events are sent over RF, X(ES app name, lowest event type
+** sent at startup). The index in the list is the app code in event
+** frames, so the ground decoder must be built from the same list. Apps
+** not listed are filtered by RF_TLM_EVENT_OTHER_MIN_TYPE.
+*/
+#define RF_TLM_EVENT_APP_LIST(X)               \
+    X("CFE_ES", CFE_EVS_EventType_ERROR)       \
+    X("CFE_EVS", CFE_EVS_EventType_ERROR)      \
+    X("CFE_SB", CFE_EVS_EventType_ERROR)       \
+    X("CFE_TBL", CFE_EVS_EventType_ERROR)      \
+    X("CFE_TIME", CFE_EVS_EventType_ERROR)     \
+    X("RF_TLM", CFE_EVS_EventType_ERROR)       \
+    X("IMU_APP", CFE_EVS_EventType_ERROR)      \
+    X("BLINKY", CFE_EVS_EventType_ERROR)       \
+    X("ALTITUDE_APP", CFE_EVS_EventType_ERROR) \
+    X("TEMP_APP", CFE_EVS_EventType_ERROR)
+
+#define RF_TLM_EVENT_OTHER_MIN_TYPE CFE_EVS_EventType_CRITICAL
+
+#endif /* RF_TLM_PLATFORM_CFG_H */
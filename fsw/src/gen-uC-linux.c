@@ -0,0 +1,153 @@
+/**
+ * @file
+ *
+ * @brief Generic uC Driver, Linux i2c-dev transport
+ *
+ * Talks to the uC through /dev/i2c-N with I2C_RDWR. The bus is opened once
+ * on attach and kept open, so each transfer is a single ioctl.
+ *
+ * @ingroup I2CMicroController
+ */
+
+#ifdef __linux__
+
+#include "gen-uC.h"
+
+#include <linux/i2c.h>
+#include <linux/i2c-dev.h>
+
+static char bus_path[UC_PATH_MAX] = UC_BUS_PATH;
+static int  bus_fd = -1;
+
+static int linux_open(void){
+  if (bus_fd < 0) {
+    bus_fd = open(&bus_path[0], O_RDWR);
+    if (bus_fd < 0) {
+      return -errno;
+    }
+  }
+
+  return 0;
+}
+
+static int linux_transfer(struct i2c_msg *msgs, uint32_t nmsgs){
+  int rv;
+
+  struct i2c_rdwr_ioctl_data payload = {
+    .msgs = msgs,
+    .nmsgs = nmsgs,
+  };
+
+  rv = linux_open();
+  if (rv < 0) {
+    return rv;
+  }
+
+  rv = ioctl(bus_fd, I2C_RDWR, &payload);
+  if (rv < 0) {
+    rv = -errno;
+
+    /* Reopen on the next transfer in case the adapter went away */
+    close(bus_fd);
+    bus_fd = -1;
+  }
+
+  return rv;
+}
+
+static int linux_attach(const char *bus, const char *dev){
+  (void)dev; /* i2c-dev has no per-device node */
+
+  if (bus_fd >= 0) {
+    close(bus_fd);
+    bus_fd = -1;
+  }
+  strncpy(bus_path, bus, sizeof(bus_path) - 1);
+
+  return linux_open();
+}
+
+static int linux_probe(void){
+  unsigned long funcs = 0;
+  int rv;
+
+  rv = linux_open();
+  if (rv < 0) {
+    return rv;
+  }
+
+  if (ioctl(bus_fd, I2C_FUNCS, &funcs) < 0) {
+    return -errno;
+  }
+  if ((funcs & I2C_FUNC_I2C) == 0) {
+    return -EOPNOTSUPP;
+  }
+
+  /* Zero-length write: the uC ACKs its address without consuming data */
+  if (funcs & I2C_FUNC_SMBUS_QUICK) {
+    struct i2c_msg msg = {
+      .addr = UC_ADDRESS,
+      .flags = 0,
+      .len = 0,
+      .buf = NULL,
+    };
+
+    rv = linux_transfer(&msg, 1);
+    if (rv < 0) {
+      return rv;
+    }
+  }
+
+  return 0;
+}
+
+static int linux_write(uint16_t addr, const uint8_t *buf, uint16_t len){
+  struct i2c_msg msg = {
+    .addr = addr,
+    .flags = 0,
+    .len = len,
+    .buf = (uint8_t *)buf,
+  };
+
+  return linux_transfer(&msg, 1);
+}
+
+static int linux_read(uint16_t addr, uint8_t reg, uint8_t *buf, uint16_t len){
+  int rv;
+  uint8_t data_address = reg;
+
+  struct i2c_msg msgs[] = {{
+    .addr = addr,
+    .flags = 0,
+    .len = 1,
+    .buf = &data_address,
+  }, {
+    .addr = addr,
+    .flags = I2C_M_RD,
+    .len = len,
+    .buf = buf,
+  }};
+
+  rv = linux_transfer(msgs, sizeof(msgs)/sizeof(msgs[0]));
+
+  return (rv < 0) ? rv : len;
+}
+
+/*
+ * Clock a slave holding SDA free through the board's pins, see
+ * uC_set_recovery(). A failed transfer already reopens the adapter.
+ */
+static int linux_recover(void){
+  return uC_clock_out();
+}
+
+const uC_transport uC_linux_transport = {
+  .name = "linux",
+  .attach = linux_attach,
+  .probe = linux_probe,
+  .write = linux_write,
+  .read = linux_read,
+  .recover = linux_recover,
+};
+
+#endif /* __linux__ */
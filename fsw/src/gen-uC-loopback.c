@@ -0,0 +1,157 @@
+/**
+ * @file
+ *
+ * @brief Generic uC Driver, in-memory loopback transport
+ *
+ * No bus is touched. Every write is recorded with its monotonic timestamp
+ * in a ring of the last UC_LOOPBACK_FRAMES frames, and reads are served
+ * from bytes queued with uC_loopback_queue_rx(). Used to run the forwarding
+ * code on hosts without the uC and to time it without bus cost.
+ * uC_loopback_set_hang() makes transfers stall like a uC holding SCL low,
+ * until the time runs out or the bus is recovered.
+ *
+ * @ingroup I2CMicroController
+ */
+
+#include "gen-uC.h"
+
+#define UC_LOOPBACK_RX_BYTES 256
+
+static uC_loopback_frame frames[UC_LOOPBACK_FRAMES];
+static uint32_t          frame_total;
+
+static uint8_t  rx_buf[UC_LOOPBACK_RX_BYTES];
+static uint16_t rx_len;
+
+static int fail_errnum;
+static volatile uint32_t hang_ms;
+
+void uC_loopback_reset(void){
+  frame_total = 0;
+  rx_len = 0;
+  fail_errnum = 0;
+  hang_ms = 0;
+}
+
+uint32_t uC_loopback_count(void){
+  return (frame_total < UC_LOOPBACK_FRAMES) ? frame_total : UC_LOOPBACK_FRAMES;
+}
+
+const uC_loopback_frame *uC_loopback_get(uint32_t index){
+  uint32_t count = uC_loopback_count();
+
+  if (index >= count) {
+    return NULL;
+  }
+
+  /* index 0 is the oldest frame still held */
+  return &frames[(frame_total - count + index) % UC_LOOPBACK_FRAMES];
+}
+
+int uC_loopback_queue_rx(const uint8_t *data, uint16_t len){
+  if (len > UC_LOOPBACK_RX_BYTES - rx_len) {
+    return -ENOSPC;
+  }
+
+  memcpy(&rx_buf[rx_len], data, len);
+  rx_len += len;
+
+  return 0;
+}
+
+void uC_loopback_set_fail(int errnum){
+  fail_errnum = errnum;
+}
+
+void uC_loopback_set_hang(uint32_t ms){
+  hang_ms = ms;
+}
+
+static int loopback_stall(void){
+  uint64_t start = uC_monotonic_ns();
+
+  while (hang_ms != 0) {
+    if (uC_monotonic_ns() - start >= (uint64_t)hang_ms * 1000000ull) {
+      return -EIO;
+    }
+    usleep(1000);
+  }
+
+  return 0;
+}
+
+static int loopback_recover(void){
+  hang_ms = 0;
+
+  return 0;
+}
+
+static int loopback_attach(const char *bus, const char *dev){
+  (void)bus;
+  (void)dev;
+
+  return -fail_errnum;
+}
+
+static int loopback_probe(void){
+  if (loopback_stall() < 0) {
+    return -EIO;
+  }
+
+  return -fail_errnum;
+}
+
+static int loopback_write(uint16_t addr, const uint8_t *buf, uint16_t len){
+  uC_loopback_frame *frame;
+
+  if (loopback_stall() < 0) {
+    return -EIO;
+  }
+
+  if (fail_errnum != 0) {
+    return -fail_errnum;
+  }
+
+  frame = &frames[frame_total % UC_LOOPBACK_FRAMES];
+  frame->addr = addr;
+  frame->len = (len < UC_LOOPBACK_FRAME_MAX) ? len : UC_LOOPBACK_FRAME_MAX;
+  frame->t_ns = uC_monotonic_ns();
+  memcpy(frame->data, buf, frame->len);
+  frame_total++;
+
+  return 0;
+}
+
+static int loopback_read(uint16_t addr, uint8_t reg, uint8_t *buf, uint16_t len){
+  uint16_t n;
+
+  (void)addr;
+  (void)reg;
+
+  if (loopback_stall() < 0) {
+    return -EIO;
+  }
+
+  if (fail_errnum != 0) {
+    return -fail_errnum;
+  }
+
+  /* Queued bytes first, then zeros, like a uC with nothing to say */
+  n = (len < rx_len) ? len : rx_len;
+  memcpy(buf, rx_buf, n);
+  memset(&buf[n], 0, len - n);
+
+  memmove(rx_buf, &rx_buf[n], rx_len - n);
+  rx_len -= n;
+
+  return len;
+}
+
+const uC_transport uC_loopback_transport = {
+  .name = "loopback",
+  .attach = loopback_attach,
+  .probe = loopback_probe,
+  .write = loopback_write,
+  .read = loopback_read,
+  .recover = loopback_recover,
+};
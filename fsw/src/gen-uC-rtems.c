@@ -0,0 +1,155 @@
+/**
+ * @file
+ *
+ * @brief Generic uC Driver, RTEMS I2C framework transport
+ *
+ * @ingroup I2CMicroController
+ */
+
+#ifdef __rtems__
+
+#include "gen-uC.h"
+
+#include <dev/i2c/i2c.h>
+
+static char bus_path[UC_PATH_MAX] = UC_BUS_PATH;
+static char dev_path[UC_PATH_MAX] = UC_DEV_PATH;
+
+static int uC_ioctl(i2c_dev *dev, ioctl_command_t command, void *arg);
+
+static int rtems_transfer(i2c_msg *msgs, uint32_t nmsgs){
+  int fd;
+  int rv;
+
+  struct i2c_rdwr_ioctl_data payload = {
+    .msgs = msgs,
+    .nmsgs = nmsgs,
+  };
+
+  fd = open(&bus_path[0], O_RDWR);
+  if (fd < 0) {
+    return -errno;
+  }
+
+  rv = ioctl(fd, I2C_RDWR, &payload);
+  if (rv < 0) {
+    rv = -errno;
+  }
+  close(fd);
+
+  return rv;
+}
+
+static int rtems_attach(const char *bus, const char *dev){
+  int rv;
+
+  strncpy(bus_path, bus, sizeof(bus_path) - 1);
+  strncpy(dev_path, dev, sizeof(dev_path) - 1);
+
+  rv = i2c_dev_register_uC(bus_path, dev_path);
+
+  /* A restarted app finds its device node already registered */
+  if (rv != 0 && errno != EEXIST) {
+    return -errno;
+  }
+
+  return 0;
+}
+
+static int rtems_probe(void){
+  int fd;
+
+  fd = open(&dev_path[0], O_RDWR);
+  if (fd < 0) {
+    return -errno;
+  }
+  close(fd);
+
+  return 0;
+}
+
+static int rtems_write(uint16_t addr, const uint8_t *buf, uint16_t len){
+  i2c_msg msgs[] = {{
+    .addr = addr,
+    .flags = 0,
+    .buf = (uint8_t *)buf,
+    .len = len,
+  }};
+
+  return rtems_transfer(msgs, sizeof(msgs)/sizeof(msgs[0]));
+}
+
+static int rtems_read(uint16_t addr, uint8_t reg, uint8_t *buf, uint16_t len){
+  int rv;
+  uint8_t data_address = reg;
+
+  i2c_msg msgs[] = {{
+    .addr = addr,
+    .flags = 0,
+    .buf = &data_address,
+    .len = 1,
+  }, {
+    .addr = addr,
+    .flags = I2C_M_RD,
+    .buf = buf,
+    .len = len,
+  }};
+
+  rv = rtems_transfer(msgs, sizeof(msgs)/sizeof(msgs[0]));
+
+  return (rv < 0) ? rv : len;
+}
+
+/* Clock a slave holding SDA free through the board's pins, see uC_set_recovery() */
+static int rtems_recover(void){
+  return uC_clock_out();
+}
+
+const uC_transport uC_rtems_transport = {
+  .name = "rtems",
+  .attach = rtems_attach,
+  .probe = rtems_probe,
+  .write = rtems_write,
+  .read = rtems_read,
+  .recover = rtems_recover,
+};
+
+int i2c_dev_register_uC(const char *bus_path, const char *dev_path){
+  i2c_dev *dev;
+
+  dev = i2c_dev_alloc_and_init(sizeof(*dev), bus_path, UC_ADDRESS);
+  if (dev == NULL) {
+    return -1;
+  }
+
+  dev->ioctl = uC_ioctl;
+
+  return i2c_dev_register(dev, dev_path);
+}
+
+static int uC_ioctl(i2c_dev *dev, ioctl_command_t command, void *arg){
+  int err;
+
+  // Variables for the Send test
+  uint8_t test[3] = {0x03, 0x06, 0x09};
+  uint8_t *val = test;
+
+  switch (command) {
+    case UC_SEND_TEST:
+
+      err = uC_set_bytes(UC_ADDRESS, &val, sizeof(test)); //Send 0x03, 0x06 and 0x09 to the uC default address
+      break;
+
+    default:
+      err = -ENOTTY;
+      break;
+  }
+
+  return err;
+}
+
+int uC_send_test(int fd){
+  return ioctl(fd, UC_SEND_TEST, NULL);
+}
+
+#endif /* __rtems__ */
@@ -3,143 +3,517 @@
  *
  * @brief Generic uC Driver Implementation
  *
+ * The bus access itself lives in a transport backend (gen-uC-rtems.c,
+ * gen-uC-linux.c, gen-uC-loopback.c). This file selects the backend and
+ * keeps the transfer statistics, so transport cost can be measured apart
+ * from the callers.
+ *
+ * Attach, probes, writes and reads run on a worker, a cFE child task of the app
+ * started by uC_start(), and the caller waits for at most the transfer
+ * deadline. A transfer still running at the deadline is abandoned: the
+ * caller gets -ETIMEDOUT after recovering the bus itself, which frees the
+ * stuck call in the transport. New transfers fail with -EBUSY until that
+ * call returns. A worker still stuck UC_WORKER_RESTART_DEADLINES deadlines
+ * later is deleted and replaced. The worker owns the transfer buffer, so a
+ * late transfer never writes into caller memory.
+ *
+ * Callers take the worker one at a time under the transfer lock. The time
+ * each waits for it and the time spent on the bus are kept in the
+ * statistics.
+ *
  * @ingroup I2CMicroController
  */
 
 #include "gen-uC.h"
 
-static const char bus_path[] = "/dev/i2c-2";
+#include "cfe.h"
 
-static int uC_ioctl(i2c_dev *dev, ioctl_command_t command, void *arg);
+#include <time.h>
 
-int uC_set_bytes(uint16_t chip_address, uint8_t **val, int numBytes){
+/*
+ * Default backend: the platform one, unless UC_DEFAULT_TRANSPORT_LOOPBACK
+ * is defined to run the driver without any bus.
+ */
+#if defined(UC_DEFAULT_TRANSPORT_LOOPBACK)
+static const uC_transport *transport = &uC_loopback_transport;
+#elif defined(__rtems__)
+static const uC_transport *transport = &uC_rtems_transport;
+#elif defined(__linux__)
+static const uC_transport *transport = &uC_linux_transport;
+#else
+static const uC_transport *transport = &uC_loopback_transport;
+#endif
+
+static uC_stats stats;
+
+static uint32_t deadline_ms = UC_XFER_DEADLINE_MS;
+static const uC_recovery_pins *recovery_pins;
+
+typedef enum {
+  UC_OP_ATTACH,
+  UC_OP_PROBE,
+  UC_OP_MSG
+} uC_op;
+
+/*
+ * One message: a write sends len bytes from buf, a read writes the
+ * register byte then reads len bytes into buf with a repeated START.
+ * An attach carries the bus and device paths instead.
+ */
+typedef struct {
+  uint16_t    addr;
+  uint8_t     read;
+  uint8_t     reg;
+  uint16_t    len;
+  uint8_t    *buf;
+  const char *bus;
+  const char *dev;
+} uC_msg;
+
+/* Transfer handed to the worker task, guarded by lock */
+static struct {
+  osal_id_t       xfer_lock; /* one caller at a time */
+  osal_id_t       lock;
+  osal_id_t       go;        /* given with a request pending */
+  osal_id_t       done;      /* given as each request completes */
+  osal_id_t       stats_lock;
+  CFE_ES_TaskId_t task;
+  uint16_t        priority;
+  int             started;
+  int             running;   /* a worker task exists */
+  int             pending;   /* request waiting for the worker */
+  int             busy;      /* worker inside the transport */
+  uint64_t        abandoned_ns; /* when the running request was abandoned */
+  uint32_t        gen;       /* generation of the last request */
+  uint32_t        done_gen;  /* generation of the last completed request */
+  uC_op           op;
+  uC_msg          msg;       /* buf points into data, bus and dev into the paths */
+  uint8_t         data[UC_XFER_MAX];
+  char            bus[UC_PATH_MAX];
+  char            dev[UC_PATH_MAX];
+  int             rv;
+} worker;
+
+/* Locks are only needed once the worker runs, before that there is one caller */
+static void uC_lock(osal_id_t id){
+  if (worker.started) {
+    OS_MutSemTake(id);
+  }
+}
 
-  int fd;
-  int rv;
+static void uC_unlock(osal_id_t id){
+  if (worker.started) {
+    OS_MutSemGive(id);
+  }
+}
 
-  if(chip_address == 0){
-    chip_address = (uint16_t) UC_ADDRESS;
+uint64_t uC_monotonic_ns(void){
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+
+  return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static int uC_run_msg(const uC_msg *msg){
+  if (msg->read) {
+    return transport->read(msg->addr, msg->reg, msg->buf, msg->len);
   }
 
-  uint8_t writebuff[numBytes];
+  return transport->write(msg->addr, msg->buf, msg->len);
+}
 
-  for(int i = 0; i<numBytes; i++){
-    writebuff[i] = (*val)[i];
+static int uC_run_op(uC_op op, const uC_msg *msg){
+  switch (op) {
+    case UC_OP_ATTACH:
+      return transport->attach(msg->bus, msg->dev);
+    case UC_OP_PROBE:
+      return transport->probe();
+    default:
+      return uC_run_msg(msg);
   }
+}
 
-  i2c_msg msgs[] = {{
-    .addr = chip_address,
-    .flags = 0,
-    .buf = writebuff,
-    .len = numBytes,
-  }};
-  struct i2c_rdwr_ioctl_data payload = {
-    .msgs = msgs,
-    .nmsgs = sizeof(msgs)/sizeof(msgs[0]),
-  };
+/*
+ * Clock SCL until a slave holding SDA low lets go, then issue a STOP,
+ * through the pins the board registered. Returns 0 once SDA reads high.
+ */
+int uC_clock_out(void){
+  const uC_recovery_pins *pins = recovery_pins;
+  int i;
 
-  fd = open(&bus_path[0], O_RDWR);
-  if (fd < 0) {
-    printf("Couldn't open bus...\n");
-    return 1;
+  if (pins == NULL) {
+    return -ENOTSUP;
   }
 
-  rv = ioctl(fd, I2C_RDWR, &payload);
-  if (rv < 0) {
-    perror("ioctl failed");
+  pins->set_sda(1);
+  for (i = 0; i < UC_RECOVERY_CLOCKS && !pins->get_sda(); i++) {
+    pins->set_scl(0);
+    pins->half_period();
+    pins->set_scl(1);
+    pins->half_period();
   }
-  close(fd);
 
-  return rv;
+  /* STOP: SDA rises while SCL is high */
+  pins->set_scl(0);
+  pins->half_period();
+  pins->set_sda(0);
+  pins->half_period();
+  pins->set_scl(1);
+  pins->half_period();
+  pins->set_sda(1);
+  pins->half_period();
+
+  return pins->get_sda() ? 0 : -EIO;
 }
 
-int uC_read_bytes(uint16_t nr_bytes, uint8_t **buff){
-  int fd;
-  uint16_t i2c_address = (uint16_t) UC_ADDRESS;
-  uint8_t data_address = (uint8_t) 0;
+static void uC_recover(void){
+  int rv = (transport->recover != NULL) ? transport->recover() : -ENOTSUP;
 
-  fd = open(&bus_path[0], O_RDWR);
-  if (fd < 0) {
-    printf("Couldn't open bus...\n");
-    return 1;
+  uC_lock(worker.stats_lock);
+  stats.recoveries++;
+  if (rv < 0) {
+    stats.recovery_failures++;
   }
+  uC_unlock(worker.stats_lock);
+}
 
+static void uC_worker_main(void){
   int rv;
-  uint8_t value[nr_bytes];
-  i2c_msg msgs[] = {{
-    .addr = i2c_address,
-    .flags = 0,
-    .buf = &data_address,
-    .len = 1,
-  }, {
-    .addr = i2c_address,
-    .flags = I2C_M_RD,
-    .buf = value,
-    .len = nr_bytes,
-  }};
-  struct i2c_rdwr_ioctl_data payload = {
-    .msgs = msgs,
-    .nmsgs = sizeof(msgs)/sizeof(msgs[0]),
-  };
-  uint16_t i;
-
-  rv = ioctl(fd, I2C_RDWR, &payload);
-  if (rv < 0) {
-    printf("ioctl failed...\n");
-  } else {
-
-    free(*buff);
-    *buff = malloc(nr_bytes * sizeof(uint8_t));
 
-    for (i = 0; i < nr_bytes; ++i) {
-      (*buff)[i] = value[i];
+  while (OS_BinSemTake(worker.go) == OS_SUCCESS) {
+    OS_MutSemTake(worker.lock);
+    if (!worker.pending) {
+      /* Withdrawn at its deadline before it was picked up */
+      OS_MutSemGive(worker.lock);
+      continue;
     }
+    worker.pending = 0;
+    worker.busy = 1;
+    OS_MutSemGive(worker.lock);
+
+    rv = uC_run_op(worker.op, &worker.msg);
+
+    OS_MutSemTake(worker.lock);
+    worker.rv = rv;
+    worker.done_gen = worker.gen;
+    worker.busy = 0;
+    OS_MutSemGive(worker.lock);
+
+    OS_BinSemGive(worker.done);
   }
 
-  return rv;
+  CFE_ES_ExitChildTask();
 }
 
-int i2c_dev_register_uC(const char *bus_path, const char *dev_path){
-  i2c_dev *dev;
+static int uC_worker_spawn(void){
+  if (CFE_ES_CreateChildTask(&worker.task, "UC_XFER", uC_worker_main, CFE_ES_TASK_STACK_ALLOCATE,
+                             UC_WORKER_STACK, worker.priority, 0) != CFE_SUCCESS) {
+    return -1;
+  }
+
+  worker.running = 1;
+  return 0;
+}
 
-  dev = i2c_dev_alloc_and_init(sizeof(*dev), bus_path, UC_ADDRESS);
-  if (dev == NULL) {
+/*
+ * Delete a worker stuck in the transport. The bus is recovered again once
+ * nothing is left on it; uC_run() starts the next worker.
+ */
+static int uC_worker_stop(void){
+  if (CFE_ES_DeleteChildTask(worker.task) != CFE_SUCCESS) {
     return -1;
   }
+  worker.running = 0;
+
+  OS_MutSemTake(worker.lock);
+  worker.pending = 0;
+  worker.busy = 0;
+  worker.done_gen = worker.gen;
+  OS_MutSemGive(worker.lock);
 
-  dev->ioctl = uC_ioctl;
+  uC_recover();
 
-  return i2c_dev_register(dev, dev_path);
+  uC_lock(worker.stats_lock);
+  stats.worker_restarts++;
+  uC_unlock(worker.stats_lock);
+
+  return 0;
 }
 
-static int uC_ioctl(i2c_dev *dev, ioctl_command_t command, void *arg){
-  int err;
+static int uC_reject(void){
+  uC_lock(worker.stats_lock);
+  stats.busy_rejects++;
+  uC_unlock(worker.stats_lock);
 
-  // Variables for the Send test
-  int numBytes = 3;
-  uint8_t *val;
+  return -EBUSY;
+}
 
-  switch (command) {
-    case UC_SEND_TEST:
+/*
+ * Run one transfer on the worker and wait for it until the deadline.
+ * Write data is copied in before and read data out after.
+ */
+static int uC_run(uC_op op, uC_msg *msg){
+  uint64_t start, waited;
+  uint64_t limit = (uint64_t)deadline_ms * 1000000ull;
+  uint32_t my_gen;
+  int      stuck;
+  int      rv;
+
+  if (!worker.started) {
+    /* No task to watch the transfer, run it without a deadline */
+    return uC_run_op(op, msg);
+  }
 
-      val = NULL;
-      val = malloc(numBytes * sizeof(uint8_t));
+  OS_MutSemTake(worker.lock);
+  stuck = worker.busy && uC_monotonic_ns() - worker.abandoned_ns >= UC_WORKER_RESTART_DEADLINES * limit;
+  if (worker.busy && !stuck) {
+    /* The abandoned transfer has not returned yet */
+    OS_MutSemGive(worker.lock);
+    return uC_reject();
+  }
+  OS_MutSemGive(worker.lock);
 
-      val[0] = 0x03;
-      val[1] = 0x06;
-      val[2] = 0x09;
+  /* Only the app's main task can start a worker, other callers wait for it to */
+  if ((stuck && uC_worker_stop() != 0) || (!worker.running && uC_worker_spawn() != 0)) {
+    return uC_reject();
+  }
 
-      err = uC_set_bytes(UC_ADDRESS, &val, numBytes); //Send 0x03, 0x06 and 0x09 to the uC default address
-      break;
+  OS_MutSemTake(worker.lock);
+  worker.op = op;
+  if (op == UC_OP_ATTACH) {
+    strcpy(worker.bus, msg->bus);
+    strcpy(worker.dev, msg->dev);
+    worker.msg.bus = worker.bus;
+    worker.msg.dev = worker.dev;
+  } else if (op == UC_OP_MSG) {
+    worker.msg = *msg;
+    worker.msg.buf = worker.data;
+    if (!msg->read && msg->len > 0) {
+      memcpy(worker.data, msg->buf, msg->len);
+    }
+  }
+  my_gen = ++worker.gen;
+  worker.pending = 1;
+  OS_MutSemGive(worker.lock);
+  OS_BinSemGive(worker.go);
+
+  /* A done given by an earlier, abandoned request only wakes this wait once more */
+  start = uC_monotonic_ns();
+  for (;;) {
+    OS_MutSemTake(worker.lock);
+    if (worker.done_gen == my_gen) {
+      rv = worker.rv;
+      if (op == UC_OP_MSG && msg->read && rv >= 0) {
+        memcpy(msg->buf, worker.data, msg->len);
+      }
+      OS_MutSemGive(worker.lock);
+      return rv;
+    }
 
-    default:
-      err = -ENOTTY;
+    waited = uC_monotonic_ns() - start;
+    if (waited >= limit) {
       break;
+    }
+    OS_MutSemGive(worker.lock);
+
+    OS_BinSemTimedWait(worker.done, (uint32_t)((limit - waited + 999999ull) / 1000000ull));
+  }
+
+  if (worker.pending) {
+    /* The worker never picked the request up, the bus was not touched */
+    worker.pending = 0;
+    stuck = 0;
+  } else {
+    worker.abandoned_ns = uC_monotonic_ns();
+    stuck = 1;
+  }
+  OS_MutSemGive(worker.lock);
+
+  uC_lock(worker.stats_lock);
+  stats.timeouts++;
+  uC_unlock(worker.stats_lock);
+
+  /* Free the bus under the stuck call rather than wait for a call that may never return */
+  if (stuck) {
+    uC_recover();
+  }
+
+  return -ETIMEDOUT;
+}
+
+/* Take the bus, run one transfer and charge it to the statistics */
+static int uC_xfer(uC_op op, uC_msg *msg){
+  uint64_t queued, start, wait, elapsed;
+  int rv;
+
+  if (msg != NULL && msg->len > UC_XFER_MAX) {
+    return -EINVAL;
+  }
+
+  queued = uC_monotonic_ns();
+  uC_lock(worker.xfer_lock);
+  start = uC_monotonic_ns();
+
+  rv = uC_run(op, msg);
+
+  elapsed = uC_monotonic_ns() - start;
+  wait = start - queued;
+
+  uC_lock(worker.stats_lock);
+  stats.busy_ns += elapsed;
+  if (elapsed > stats.max_ns) {
+    stats.max_ns = (elapsed > UINT32_MAX) ? UINT32_MAX : (uint32_t)elapsed;
+  }
+  if (wait > stats.max_wait_ns) {
+    stats.max_wait_ns = (wait > UINT32_MAX) ? UINT32_MAX : (uint32_t)wait;
+  }
+  if (rv < 0) {
+    stats.errors++;
+  }
+  if (op == UC_OP_MSG && msg->read) {
+    stats.reads++;
+    stats.bytes_read += (rv >= 0) ? msg->len : 0;
+  } else if (op == UC_OP_MSG) {
+    stats.writes++;
+    stats.bytes_written += (rv >= 0) ? msg->len : 0;
+  }
+  uC_unlock(worker.stats_lock);
+
+  uC_unlock(worker.xfer_lock);
+
+  return rv;
+}
+
+/*
+ * Create the worker and its semaphores. Call from the app's main task,
+ * which owns them, so ES deletes them with the app.
+ */
+int uC_start(uint16_t priority){
+  if (worker.started) {
+    return 0;
+  }
+
+  if (OS_MutSemCreate(&worker.xfer_lock, "UC_XFER_LOCK", 0) != OS_SUCCESS ||
+      OS_MutSemCreate(&worker.lock, "UC_WORKER", 0) != OS_SUCCESS ||
+      OS_MutSemCreate(&worker.stats_lock, "UC_STATS", 0) != OS_SUCCESS ||
+      OS_BinSemCreate(&worker.go, "UC_GO", OS_SEM_EMPTY, 0) != OS_SUCCESS ||
+      OS_BinSemCreate(&worker.done, "UC_DONE", OS_SEM_EMPTY, 0) != OS_SUCCESS) {
+    return -ENOMEM;
+  }
+
+  worker.priority = priority;
+  if (uC_worker_spawn() != 0) {
+    return -EAGAIN;
+  }
+
+  worker.started = 1;
+  return 0;
+}
+
+void uC_set_deadline_ms(uint32_t ms){
+  deadline_ms = (ms == 0) ? UC_XFER_DEADLINE_MS : ms;
+}
+
+uint32_t uC_get_deadline_ms(void){
+  return deadline_ms;
+}
+
+void uC_set_recovery(const uC_recovery_pins *pins){
+  recovery_pins = pins;
+}
+
+void uC_set_transport(const uC_transport *t){
+  if (t != NULL) {
+    transport = t;
+  }
+}
+
+const uC_transport *uC_get_transport(void){
+  return transport;
+}
+
+void uC_get_stats(uC_stats *out){
+  uC_lock(worker.stats_lock);
+  *out = stats;
+  uC_unlock(worker.stats_lock);
+}
+
+void uC_reset_stats(void){
+  uC_lock(worker.stats_lock);
+  memset(&stats, 0, sizeof(stats));
+  uC_unlock(worker.stats_lock);
+}
+
+int uC_attach(const char *bus_path, const char *dev_path){
+  uC_msg msg;
+
+  if (strlen(bus_path) >= UC_PATH_MAX || strlen(dev_path) >= UC_PATH_MAX) {
+    return -ENAMETOOLONG;
+  }
+
+  memset(&msg, 0, sizeof(msg));
+  msg.bus = bus_path;
+  msg.dev = dev_path;
+
+  return uC_xfer(UC_OP_ATTACH, &msg);
+}
+
+int uC_probe(void){
+  return uC_xfer(UC_OP_PROBE, NULL);
+}
+
+int uC_set_bytes(uint16_t chip_address, uint8_t **val, int numBytes){
+  uC_msg msg;
+
+  if(chip_address == 0){
+    chip_address = (uint16_t) UC_ADDRESS;
   }
 
-  return err;
+  if (numBytes < 0 || numBytes > UINT16_MAX) {
+    return -EINVAL;
+  }
+
+  msg.addr = chip_address;
+  msg.read = 0;
+  msg.reg = 0;
+  msg.len = (uint16_t)numBytes;
+  msg.buf = *val;
+
+  return uC_xfer(UC_OP_MSG, &msg);
 }
 
-int uC_send_test(int fd){
-  return ioctl(fd, UC_SEND_TEST, NULL);
+int uC_read_buffer(uint16_t chip_address, uint8_t reg, uint8_t *buff, uint16_t nr_bytes){
+  uC_msg msg;
+
+  if(chip_address == 0){
+    chip_address = (uint16_t) UC_ADDRESS;
+  }
+
+  msg.addr = chip_address;
+  msg.read = 1;
+  msg.reg = reg;
+  msg.len = nr_bytes;
+  msg.buf = buff;
+
+  return uC_xfer(UC_OP_MSG, &msg);
+}
+
+int uC_read_bytes(uint16_t nr_bytes, uint8_t **buff){
+  uint8_t value[nr_bytes];
+  int rv;
+
+  /* Failures reach the caller and the bus stats, the driver prints nothing */
+  rv = uC_read_buffer((uint16_t) UC_ADDRESS, 0, value, nr_bytes);
+  if (rv >= 0) {
+    free(*buff);
+    *buff = malloc(nr_bytes * sizeof(uint8_t));
+    if (*buff == NULL) {
+      return -ENOMEM;
+    }
+
+    memcpy(*buff, value, nr_bytes);
+  }
+
+  return rv;
 }
@@ -9,14 +9,13 @@
 #ifndef _DEV_I2C_uC_H
 #define _DEV_I2C_uC_H
 
-#include <dev/i2c/i2c.h>
 #include <fcntl.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <sys/ioctl.h>
 #include <sys/stat.h>
 #include <errno.h>
-#include <fcntl.h>
 #include <string.h>
 #include <unistd.h>
 
@@ -27,6 +26,15 @@ extern "C" {
 // Device address
 #define UC_ADDRESS 0x36
 
+// Bus the uC sits on and the device node registered for it
+#define UC_BUS_PATH "/dev/i2c-2"
+#define UC_DEV_PATH "/dev/i2c-2.genuC-0"
+#define UC_PATH_MAX 64 /* including the NUL, as the transports keep them */
+
+// Read registers of the uplink mailbox, see rf_tlm_frame.h
+#define UC_REG_UPLINK_HDR  0x10 // Header of the oldest pending uplink frame
+#define UC_REG_UPLINK_DATA 0x11 // Its command packet, reading it frees the slot
+
 /**
  * @defgroup I2CMicroController Driver
  *
@@ -41,14 +49,140 @@ typedef enum {
   UC_SEND_TEST
 } uC_command;
 
+/**
+ * @brief I2C transport used to reach the uC.
+ *
+ * Every operation returns 0 (or the number of bytes for read) on success
+ * and a negative errno value on failure.
+ */
+typedef struct {
+  const char *name;
+
+  /** Prepare the bus and register the device node, if the platform has one */
+  int (*attach)(const char *bus_path, const char *dev_path);
+
+  /** Check that the uC can be reached */
+  int (*probe)(void);
+
+  /** Single write transfer of len bytes to addr */
+  int (*write)(uint16_t addr, const uint8_t *buf, uint16_t len);
+
+  /** Write the register byte then read len bytes back in one transfer */
+  int (*read)(uint16_t addr, uint8_t reg, uint8_t *buf, uint16_t len);
+
+  /** Free a hung bus after a transfer missed its deadline, may be NULL */
+  int (*recover)(void);
+} uC_transport;
+
+/**
+ * @brief Transfer deadline.
+ *
+ * Every attach, probe, write and read is abandoned if it has not
+ * completed within the deadline, and the caller recovers the bus before
+ * it returns, so no call waits on the transport for longer than the
+ * deadline plus one recovery. A 32-byte write takes about 3 ms at 100 kHz.
+ */
+#define UC_XFER_DEADLINE_MS 25
+
+/** Deadlines an abandoned call may stay stuck before its worker is replaced */
+#define UC_WORKER_RESTART_DEADLINES 4
+
+/** Stack of the worker task */
+#define UC_WORKER_STACK 8192
+
+/** Largest single transfer */
+#define UC_XFER_MAX 64
+
+/** SCL pulses clocked out to free a slave holding SDA low */
+#define UC_RECOVERY_CLOCKS 9
+
+/**
+ * @brief GPIO access to the bus lines, supplied by the board for recovery.
+ *
+ * set_* drive the line low (0) or release it high (1), half_period waits
+ * half a bus clock. The board takes the pins from the I2C controller for
+ * the clock-out and hands them back after. The RTEMS and Linux transports
+ * recover through them with uC_clock_out().
+ */
+typedef struct {
+  void (*set_scl)(int level);
+  void (*set_sda)(int level);
+  int  (*get_sda)(void);
+  void (*half_period)(void);
+} uC_recovery_pins;
+
+/**
+ * @brief Transfer statistics kept for whichever transport is active.
+ */
+typedef struct {
+  uint32_t writes;
+  uint32_t reads;
+  uint32_t errors;
+  uint32_t bytes_written;
+  uint32_t bytes_read;
+  uint64_t busy_ns;     /**< Time spent inside transport calls */
+  uint32_t max_ns;      /**< Longest single transport call */
+  uint32_t timeouts;    /**< Transfers abandoned at the deadline */
+  uint32_t recoveries;  /**< Bus recoveries run after a timeout */
+  uint32_t recovery_failures; /**< Recoveries that left the bus hung or had no means to run */
+  uint32_t busy_rejects;      /**< Transfers refused while an abandoned one was still stuck */
+  uint32_t max_wait_ns; /**< Longest wait for another caller's transfer to finish */
+  uint32_t worker_restarts;   /**< Workers replaced after staying stuck in the transport */
+} uC_stats;
+
+#ifdef __rtems__
+extern const uC_transport uC_rtems_transport;
+#endif
+#ifdef __linux__
+extern const uC_transport uC_linux_transport;
+#endif
+extern const uC_transport uC_loopback_transport;
+
+void                 uC_set_transport(const uC_transport *transport);
+const uC_transport  *uC_get_transport(void);
+void                 uC_get_stats(uC_stats *stats);
+void                 uC_reset_stats(void);
+uint64_t             uC_monotonic_ns(void);
+void                 uC_set_deadline_ms(uint32_t ms);
+uint32_t             uC_get_deadline_ms(void);
+void                 uC_set_recovery(const uC_recovery_pins *pins);
+int                  uC_clock_out(void);
+int                  uC_start(uint16_t priority);
+
+int uC_attach(const char *bus_path, const char *dev_path);
+int uC_probe(void);
+
+#ifdef __rtems__
 int i2c_dev_register_uC(const char *bus_path, const char *dev_path);
 int uC_send_test(int fd);
+#endif
 
 
 // I2C functions
 
 int uC_set_bytes(uint16_t chip_address, uint8_t **val, int numBytes);
 int uC_read_bytes(uint16_t nr_bytes, uint8_t **buff);
+int uC_read_buffer(uint16_t chip_address, uint8_t reg, uint8_t *buff, uint16_t nr_bytes);
+
+
+// Loopback transport: records every write and serves queued reads
+
+#define UC_LOOPBACK_FRAMES    64
+#define UC_LOOPBACK_FRAME_MAX 64
+
+typedef struct {
+  uint16_t addr;
+  uint16_t len;
+  uint64_t t_ns;        /**< Monotonic time of the write */
+  uint8_t  data[UC_LOOPBACK_FRAME_MAX];
+} uC_loopback_frame;
+
+void                      uC_loopback_reset(void);
+uint32_t                  uC_loopback_count(void);
+const uC_loopback_frame  *uC_loopback_get(uint32_t index);
+int                       uC_loopback_queue_rx(const uint8_t *data, uint16_t len);
+void                      uC_loopback_set_fail(int errnum);
+void                      uC_loopback_set_hang(uint32_t ms);
 
 
 /** @} */
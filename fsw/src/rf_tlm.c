@@ -30,11 +30,28 @@
 
 #include <string.h>
 
+#ifdef RF_TLM_I2C_RECOVERY_PINS
+extern const uC_recovery_pins RF_TLM_I2C_RECOVERY_PINS;
+#endif
+
 /*
 ** global data
 */
 RF_TLM_Data_t RF_TLM_Data;
 
+/*
+** Telemetry sources forwarded over RF
+*/
+static const struct
+{
+    CFE_SB_MsgId_Atom_t MsgId;
+    const char         *Name;
+} RF_TLM_SourceList[] = {
+#define RF_TLM_SOURCE_ENTRY(Tag, MsgId, Name) {MsgId, Name},
+    RF_TLM_SOURCE_LIST(RF_TLM_SOURCE_ENTRY)
+#undef RF_TLM_SOURCE_ENTRY
+};
+
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *  * *  * * * * **/
 /*                                                                            */
 /* Application entry point and main process loop                              */
@@ -44,12 +61,16 @@ void RF_TLM_Main(void)
 {
     int32            status;
     CFE_SB_Buffer_t *SBBufPtr;
+    uint32           StartMsec;
+    uint32           WaitMsec;
 
     /*
     ** Create the first Performance Log entry
     */
     CFE_ES_PerfLogEntry(RF_TLM_PERF_ID);
 
+    StartMsec = RF_TLM_GetMsec();
+
     /*
     ** Perform application specific initialization
     ** If the Initialization fails, set the RunStatus to
@@ -60,7 +81,21 @@ void RF_TLM_Main(void)
     {
         RF_TLM_Data.RunStatus = CFE_ES_RunStatus_APP_ERROR;
     }else{
-      RF_TLM_openTLM();
+      /* The uC is registered and probed from the run loop, see RF_TLM_Dev_Step() */
+      uC_set_deadline_ms(RF_TLM_I2C_DEADLINE_MSEC);
+#ifdef RF_TLM_I2C_RECOVERY_PINS
+      uC_set_recovery(&RF_TLM_I2C_RECOVERY_PINS);
+#endif
+      if (uC_start(RF_TLM_I2C_WORKER_PRIORITY) < 0){
+        CFE_EVS_SendEvent(RF_TLM_GENUC_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "RF TLM: genuC worker not started, I2C transfers run without a deadline");
+      }
+      RF_TLM_Dev_Init(StartMsec);
+      RF_TLM_Uplink_Init();
+      RF_TLM_Cpu_Init(RF_TLM_CPU_BUDGET_PERMILLE);
+      RF_TLM_Slot_Init();
+      RF_TLM_Contact_Init();
+      RF_TLM_Cds_Init();
       RF_TLM_Data.downlink_on = true;
     }
 
@@ -74,16 +109,52 @@ void RF_TLM_Main(void)
 
         CFE_ES_PerfLogEntry(RF_TLM_PERF_ID);
 
+        RF_TLM_Cpu_Step();
+
+        RF_TLM_Cpu_Enter(RF_TLM_STAGE_DEV);
+        RF_TLM_Dev_Step();
+
+        RF_TLM_forward_events();
         RF_TLM_forward_telemetry();
 
-        /* Pend on receipt of command packet */
-        status = CFE_SB_ReceiveBuffer(&SBBufPtr, RF_TLM_Data.CommandPipe, CFE_SB_PEND_FOREVER);
+        /* Uplink polls and downlink sends share the bus, one after the other */
+        RF_TLM_Cpu_Enter(RF_TLM_STAGE_UPLINK);
+        RF_TLM_Uplink_Step();
+
+        /* A link test run takes the downlink, telemetry stays queued until it ends */
+        RF_TLM_Cpu_Enter(RF_TLM_STAGE_SEND);
+        RF_TLM_Contact_Step();
+        if (RF_TLM_Data.LinkTest.Active)
+        {
+            RF_TLM_LinkTest_Step();
+        }
+        else
+        {
+            RF_TLM_send_queued();
+        }
+        RF_TLM_Cds_Step();
+
+        /* Pend on receipt of command packet, the timeout paces the loop and wakes it for the next slot or window */
+        RF_TLM_Cpu_Enter(RF_TLM_STAGE_IDLE);
+        WaitMsec = RF_TLM_Contact_IntervalMsec();
+        WaitMsec = RF_TLM_Contact_WaitMsec((WaitMsec < RF_TLM_TASK_MSEC) ? WaitMsec : RF_TLM_TASK_MSEC);
+        WaitMsec = RF_TLM_Slot_WaitMsec(WaitMsec);
+        WaitMsec = RF_TLM_LinkTest_WaitMsec(WaitMsec);
+        WaitMsec = RF_TLM_Uplink_WaitMsec(WaitMsec);
+        if (WaitMsec < 1)
+        {
+            /* A zero timeout would poll the command pipe instead of pending */
+            WaitMsec = 1;
+        }
+        status = CFE_SB_ReceiveBuffer(&SBBufPtr, RF_TLM_Data.CommandPipe, WaitMsec);
+
+        RF_TLM_Cpu_Enter(RF_TLM_STAGE_COMMAND);
 
         if (status == CFE_SUCCESS)
         {
             RF_TLM_ProcessCommandPacket(SBBufPtr);
         }
-        else
+        else if (status != CFE_SB_TIME_OUT)
         {
             CFE_EVS_SendEvent(RF_TLM_PIPE_ERR_EID, CFE_EVS_EventType_ERROR,
                               "RF TLM APP: SB Pipe Read Error, App Will Exit\n");
@@ -159,6 +230,50 @@ int32 RF_TLM_Init(void)
     RF_TLM_Data.EventFilters[10].Mask    = 0x0000;
     RF_TLM_Data.EventFilters[11].EventID = RF_TLM_DEV_INF_EID;
     RF_TLM_Data.EventFilters[11].Mask    = 0x0000;
+    RF_TLM_Data.EventFilters[12].EventID = RF_TLM_COMMANDDEBUG_INF_EID;
+    RF_TLM_Data.EventFilters[12].Mask    = 0x0000;
+    RF_TLM_Data.EventFilters[13].EventID = RF_TLM_SETRATE_INF_EID;
+    RF_TLM_Data.EventFilters[13].Mask    = 0x0000;
+    RF_TLM_Data.EventFilters[14].EventID = RF_TLM_SETENC_INF_EID;
+    RF_TLM_Data.EventFilters[14].Mask    = 0x0000;
+    RF_TLM_Data.EventFilters[15].EventID = RF_TLM_UPLINK_INF_EID;
+    RF_TLM_Data.EventFilters[15].Mask    = 0x0000;
+    RF_TLM_Data.EventFilters[16].EventID = RF_TLM_UPLINK_ERR_EID;
+    RF_TLM_Data.EventFilters[16].Mask    = 0x0000;
+    RF_TLM_Data.EventFilters[17].EventID = RF_TLM_BUSHANG_ERR_EID;
+    RF_TLM_Data.EventFilters[17].Mask    = 0x0000;
+    RF_TLM_Data.EventFilters[18].EventID = RF_TLM_SETDEADBAND_INF_EID;
+    RF_TLM_Data.EventFilters[18].Mask    = 0x0000;
+    RF_TLM_Data.EventFilters[19].EventID = RF_TLM_SETPROFILE_INF_EID;
+    RF_TLM_Data.EventFilters[19].Mask    = 0x0000;
+    RF_TLM_Data.EventFilters[20].EventID = RF_TLM_CPU_ERR_EID;
+    RF_TLM_Data.EventFilters[20].Mask    = 0x0000;
+    RF_TLM_Data.EventFilters[21].EventID = RF_TLM_CPU_INF_EID;
+    RF_TLM_Data.EventFilters[21].Mask    = 0x0000;
+    RF_TLM_Data.EventFilters[22].EventID = RF_TLM_SETSLOTS_INF_EID;
+    RF_TLM_Data.EventFilters[22].Mask    = 0x0000;
+    RF_TLM_Data.EventFilters[23].EventID = RF_TLM_LINKTEST_INF_EID;
+    RF_TLM_Data.EventFilters[23].Mask    = 0x0000;
+    RF_TLM_Data.EventFilters[24].EventID = RF_TLM_LINKTEST_ERR_EID;
+    RF_TLM_Data.EventFilters[24].Mask    = 0x0000;
+    RF_TLM_Data.EventFilters[25].EventID = RF_TLM_SETFRAMING_INF_EID;
+    RF_TLM_Data.EventFilters[25].Mask    = 0x0000;
+    RF_TLM_Data.EventFilters[26].EventID = RF_TLM_SETSUMMARY_INF_EID;
+    RF_TLM_Data.EventFilters[26].Mask    = 0x0000;
+    RF_TLM_Data.EventFilters[27].EventID = RF_TLM_SETEVTFILTER_INF_EID;
+    RF_TLM_Data.EventFilters[27].Mask    = 0x0000;
+    RF_TLM_Data.EventFilters[28].EventID = RF_TLM_CDS_INF_EID;
+    RF_TLM_Data.EventFilters[28].Mask    = 0x0000;
+    RF_TLM_Data.EventFilters[29].EventID = RF_TLM_CDS_ERR_EID;
+    RF_TLM_Data.EventFilters[29].Mask    = 0x0000;
+    RF_TLM_Data.EventFilters[30].EventID = RF_TLM_SETCOMPRESS_INF_EID;
+    RF_TLM_Data.EventFilters[30].Mask    = 0x0000;
+    RF_TLM_Data.EventFilters[31].EventID = RF_TLM_SETCONTACTS_INF_EID;
+    RF_TLM_Data.EventFilters[31].Mask    = 0x0000;
+    RF_TLM_Data.EventFilters[32].EventID = RF_TLM_CONTACT_INF_EID;
+    RF_TLM_Data.EventFilters[32].Mask    = 0x0000;
+    RF_TLM_Data.EventFilters[33].EventID = RF_TLM_SNAPSHOT_INF_EID;
+    RF_TLM_Data.EventFilters[33].Mask    = 0x0000;
 
     /*
     ** Register the events
@@ -174,12 +289,22 @@ int32 RF_TLM_Init(void)
     */
     RF_TLM_Data_Init();
 
+    RF_TLM_Queue_Init(&RF_TLM_Data.FrameQueue, RF_TLM_Data.FrameStore, RF_TLM_FRAME_QUEUE_DEPTH);
+    RF_TLM_Seq_Init(&RF_TLM_Data.Dest, UC_ADDRESS);
+    RF_TLM_Data.NextSendMsec = 0;
+
+    RF_TLM_Data.PackedFrameCount = 0;
+    RF_TLM_Data.PackedBytesSaved = 0;
+
     /*
     ** Initialize housekeeping packet (clear user data area).
     */
     CFE_MSG_Init(CFE_MSG_PTR(RF_TLM_Data.HkTlm.TelemetryHeader), CFE_SB_ValueToMsgId(RF_TLM_HK_TLM_MID),
                  sizeof(RF_TLM_Data.HkTlm));
 
+    RF_TLM_LinkTest_Init();
+    RF_TLM_Evs_Init();
+
     /*
     ** Software Bus message pipe.
     */
@@ -219,65 +344,57 @@ int32 RF_TLM_Init(void)
     }
 
     /*
-    ** Subscribe to IMU App RF packets
+    ** Software Bus event pipe, read ahead of the telemetry pipe
     */
-    // status = CFE_SB_Subscribe(CFE_SB_ValueToMsgId(IMU_APP_RF_DATA_MID), RF_TLM_Data.TlmPipe);
-    status = CFE_SB_SubscribeEx(CFE_SB_ValueToMsgId(IMU_APP_RF_DATA_MID),  /* Msg Id to Receive */
-                                RF_TLM_Data.TlmPipe,                            /* Pipe Msg is to be Rcvd on */
-                                CFE_SB_DEFAULT_QOS,                             /* Quality of Service */
-                                10);                                            /* Max Number to Queue */
-    if (status != CFE_SUCCESS){
-       CFE_EVS_SendEvent(RF_TLM_SUBSCRIBE_ERR_EID, CFE_EVS_EventType_ERROR,
-         "RF Telemetry Output App: Error Subscribing to IMU App, RC = 0x%08lX\n",
-         (unsigned long)status);
-       return status;
+    status = CFE_SB_CreatePipe(&RF_TLM_Data.EventPipe, RF_TLM_EVENT_PIPE_DEPTH, "RF_TLM_EVS_PIPE");
+    if (status == CFE_SUCCESS){
+        status = CFE_SB_Subscribe(CFE_SB_ValueToMsgId(CFE_EVS_LONG_EVENT_MSG_MID), RF_TLM_Data.EventPipe);
     }
-
-    /*
-    ** Subscribe to Blinky App RF packets
-    */
-    // status = CFE_SB_Subscribe(CFE_SB_ValueToMsgId(BLINKY_RF_DATA_MID), RF_TLM_Data.TlmPipe);
-    status = CFE_SB_SubscribeEx(CFE_SB_ValueToMsgId(BLINKY_RF_DATA_MID),  /* Msg Id to Receive */
-                                RF_TLM_Data.TlmPipe,                            /* Pipe Msg is to be Rcvd on */
-                                CFE_SB_DEFAULT_QOS,                             /* Quality of Service */
-                                10);                                            /* Max Number to Queue */
-    if (status != CFE_SUCCESS){
-       CFE_EVS_SendEvent(RF_TLM_SUBSCRIBE_ERR_EID, CFE_EVS_EventType_ERROR,
-         "RF Telemetry Output App: Error Subscribing to Blinky App, RC = 0x%08lX\n",
-         (unsigned long)status);
-       return status;
+    if (status == CFE_SUCCESS){
+        status = CFE_SB_Subscribe(CFE_SB_ValueToMsgId(CFE_EVS_SHORT_EVENT_MSG_MID), RF_TLM_Data.EventPipe);
     }
-
-    /*
-    ** Subscribe to Altitude App RF packets
-    */
-    // status = CFE_SB_Subscribe(CFE_SB_ValueToMsgId(ALTITUDE_APP_RF_DATA_MID), RF_TLM_Data.TlmPipe);
-    status = CFE_SB_SubscribeEx(CFE_SB_ValueToMsgId(ALTITUDE_APP_RF_DATA_MID),  /* Msg Id to Receive */
-                                RF_TLM_Data.TlmPipe,                            /* Pipe Msg is to be Rcvd on */
-                                CFE_SB_DEFAULT_QOS,                             /* Quality of Service */
-                                10);                                            /* Max Number to Queue */
     if (status != CFE_SUCCESS){
-       CFE_EVS_SendEvent(RF_TLM_SUBSCRIBE_ERR_EID, CFE_EVS_EventType_ERROR,
-         "RF Telemetry Output App: Error Subscribing to Altitude App, RC = 0x%08lX\n",
-         (unsigned long)status);
-       return status;
+        CFE_EVS_SendEvent(RF_TLM_PIPE_ERR_EID, CFE_EVS_EventType_ERROR, "RF Can't subscribe to events status %i\n",(int)status);
+        return status;
     }
 
     /*
-    ** Subscribe to Temperature App RF packets
+    ** Subscribe to the RF packets of every source app
     */
-    // status = CFE_SB_Subscribe(CFE_SB_ValueToMsgId(TEMP_APP_RF_DATA_MID), RF_TLM_Data.TlmPipe);
-    status = CFE_SB_SubscribeEx(CFE_SB_ValueToMsgId(TEMP_APP_RF_DATA_MID),  /* Msg Id to Receive */
-                                RF_TLM_Data.TlmPipe,                            /* Pipe Msg is to be Rcvd on */
-                                CFE_SB_DEFAULT_QOS,                             /* Quality of Service */
-                                10);                                            /* Max Number to Queue */
-    if (status != CFE_SUCCESS){
-       CFE_EVS_SendEvent(RF_TLM_SUBSCRIBE_ERR_EID, CFE_EVS_EventType_ERROR,
-         "RF Telemetry Output App: Error Subscribing to Temp App, RC = 0x%08lX\n",
-         (unsigned long)status);
-       return status;
+    RF_TLM_Data.SourceCount = 0;
+    for (uint16 i = 0; i < sizeof(RF_TLM_SourceList) / sizeof(RF_TLM_SourceList[0]); i++){
+        status = CFE_SB_SubscribeEx(CFE_SB_ValueToMsgId(RF_TLM_SourceList[i].MsgId), /* Msg Id to Receive */
+                                    RF_TLM_Data.TlmPipe,                              /* Pipe Msg is to be Rcvd on */
+                                    CFE_SB_DEFAULT_QOS,                               /* Quality of Service */
+                                    10);                                              /* Max Number to Queue */
+        if (status != CFE_SUCCESS){
+           CFE_EVS_SendEvent(RF_TLM_SUBSCRIBE_ERR_EID, CFE_EVS_EventType_ERROR,
+             "RF Telemetry Output App: Error Subscribing to %s, RC = 0x%08lX\n",
+             RF_TLM_SourceList[i].Name, (unsigned long)status);
+           return status;
+        }
+
+        memset(&RF_TLM_Data.Sources[i], 0, sizeof(RF_TLM_Data.Sources[i]));
+        RF_TLM_Data.Sources[i].MsgId = CFE_SB_ValueToMsgId(RF_TLM_SourceList[i].MsgId);
+        RF_TLM_Queue_Init(&RF_TLM_Data.Sources[i].Queue, RF_TLM_Data.SourceStore[i], RF_TLM_SOURCE_QUEUE_DEPTH);
+        RF_TLM_Rate_Set(&RF_TLM_Data.Sources[i].Rate, 0, 0);
+        RF_TLM_Data.Sources[i].Encoding = RF_TLM_ENC_RAW;
+        RF_TLM_Summary_Init(&RF_TLM_Data.Sources[i].Summary);
+        RF_TLM_Data.Sources[i].Schema   = RF_TLM_Pack_FindSchema((uint16)RF_TLM_SourceList[i].MsgId,
+                                                                 &RF_TLM_Data.Sources[i].SchemaId);
+        if (RF_TLM_Data.Sources[i].Schema != NULL){
+            RF_TLM_Deadband_Init(&RF_TLM_Data.Sources[i].Deadband, (uint16)RF_TLM_SourceList[i].MsgId);
+        }
+        RF_TLM_Data.SourceCount++;
     }
 
+    /* Rates, weights and encodings come from the startup profile */
+    RF_TLM_Profile_Apply(0);
+    RF_TLM_Ccsds_Init();
+    RF_TLM_Lz_Init();
+    RF_TLM_Snap_Init();
+    RF_TLM_Data.ProfileSwitches = 0;
+
     CFE_EVS_SendEvent(RF_TLM_STARTUP_INF_EID, CFE_EVS_EventType_INFORMATION, "RF Tlm App Initialized.%s",
                      RF_TLM_VERSION_STRING);
 
@@ -425,6 +542,110 @@ void RF_TLM_ProcessGroundCommand(CFE_SB_Buffer_t *SBBufPtr){
 
             break;
 
+        case RF_TLM_SET_RATE_CC:
+            if (RF_TLM_VerifyCmdLength(&SBBufPtr->Msg, sizeof(RF_TLM_SetRateCmd_t)))
+            {
+                RF_TLM_SetRate((const RF_TLM_SetRateCmd_t *)SBBufPtr);
+            }
+
+            break;
+
+        case RF_TLM_SET_ENCODING_CC:
+            if (RF_TLM_VerifyCmdLength(&SBBufPtr->Msg, sizeof(RF_TLM_SetEncodingCmd_t)))
+            {
+                RF_TLM_SetEncoding((const RF_TLM_SetEncodingCmd_t *)SBBufPtr);
+            }
+
+            break;
+
+        case RF_TLM_SET_DEADBAND_CC:
+            if (RF_TLM_VerifyCmdLength(&SBBufPtr->Msg, sizeof(RF_TLM_SetDeadbandCmd_t)))
+            {
+                RF_TLM_SetDeadband((const RF_TLM_SetDeadbandCmd_t *)SBBufPtr);
+            }
+
+            break;
+
+        case RF_TLM_SET_PROFILE_CC:
+            if (RF_TLM_VerifyCmdLength(&SBBufPtr->Msg, sizeof(RF_TLM_SetProfileCmd_t)))
+            {
+                RF_TLM_SetProfile((const RF_TLM_SetProfileCmd_t *)SBBufPtr);
+            }
+
+            break;
+
+        case RF_TLM_SET_CPU_BUDGET_CC:
+            if (RF_TLM_VerifyCmdLength(&SBBufPtr->Msg, sizeof(RF_TLM_SetCpuBudgetCmd_t)))
+            {
+                RF_TLM_SetCpuBudget((const RF_TLM_SetCpuBudgetCmd_t *)SBBufPtr);
+            }
+
+            break;
+
+        case RF_TLM_SET_SLOTS_CC:
+            if (RF_TLM_VerifyCmdLength(&SBBufPtr->Msg, sizeof(RF_TLM_SetSlotsCmd_t)))
+            {
+                RF_TLM_SetSlots((const RF_TLM_SetSlotsCmd_t *)SBBufPtr);
+            }
+
+            break;
+
+        case RF_TLM_LINK_TEST_CC:
+            if (RF_TLM_VerifyCmdLength(&SBBufPtr->Msg, sizeof(RF_TLM_LinkTestCmd_t)))
+            {
+                RF_TLM_LinkTest((const RF_TLM_LinkTestCmd_t *)SBBufPtr);
+            }
+
+            break;
+
+        case RF_TLM_SET_FRAMING_CC:
+            if (RF_TLM_VerifyCmdLength(&SBBufPtr->Msg, sizeof(RF_TLM_SetFramingCmd_t)))
+            {
+                RF_TLM_SetFraming((const RF_TLM_SetFramingCmd_t *)SBBufPtr);
+            }
+
+            break;
+
+        case RF_TLM_SET_SUMMARY_CC:
+            if (RF_TLM_VerifyCmdLength(&SBBufPtr->Msg, sizeof(RF_TLM_SetSummaryCmd_t)))
+            {
+                RF_TLM_SetSummary((const RF_TLM_SetSummaryCmd_t *)SBBufPtr);
+            }
+
+            break;
+
+        case RF_TLM_SET_EVT_FILTER_CC:
+            if (RF_TLM_VerifyCmdLength(&SBBufPtr->Msg, sizeof(RF_TLM_SetEventFilterCmd_t)))
+            {
+                RF_TLM_SetEventFilter((const RF_TLM_SetEventFilterCmd_t *)SBBufPtr);
+            }
+
+            break;
+
+        case RF_TLM_SET_COMPRESS_CC:
+            if (RF_TLM_VerifyCmdLength(&SBBufPtr->Msg, sizeof(RF_TLM_SetCompressCmd_t)))
+            {
+                RF_TLM_SetCompress((const RF_TLM_SetCompressCmd_t *)SBBufPtr);
+            }
+
+            break;
+
+        case RF_TLM_SET_CONTACTS_CC:
+            if (RF_TLM_VerifyCmdLength(&SBBufPtr->Msg, sizeof(RF_TLM_SetContactsCmd_t)))
+            {
+                RF_TLM_SetContacts((const RF_TLM_SetContactsCmd_t *)SBBufPtr);
+            }
+
+            break;
+
+        case RF_TLM_SNAPSHOT_CC:
+            if (RF_TLM_VerifyCmdLength(&SBBufPtr->Msg, sizeof(RF_TLM_SnapshotCmd_t)))
+            {
+                RF_TLM_Snapshot((const RF_TLM_SnapshotCmd_t *)SBBufPtr);
+            }
+
+            break;
+
         /* default case already found during FC vs length test */
         default:
             CFE_EVS_SendEvent(RF_TLM_COMMAND_ERR_EID, CFE_EVS_EventType_ERROR,
@@ -443,6 +664,7 @@ void RF_TLM_ProcessGroundCommand(CFE_SB_Buffer_t *SBBufPtr){
 /* * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * *  * *  * * * * */
 int32 RF_TLM_ReportHousekeeping(const CFE_MSG_CommandHeader_t *Msg)
 {
+    uC_stats bus;
 
     /*
     ** Get command execution counters...
@@ -453,6 +675,155 @@ int32 RF_TLM_ReportHousekeeping(const CFE_MSG_CommandHeader_t *Msg)
     RF_TLM_Data.HkTlm.Payload.PcktCounter = RF_TLM_Data.PcktCounter;
     RF_TLM_Data.HkTlm.Payload.PcktErrCounter = RF_TLM_Data.PcktErrCounter;
 
+    RF_TLM_Data.HkTlm.Payload.RateSuppressedCount = 0;
+    RF_TLM_Data.HkTlm.Payload.DeadbandSuppressedCount = 0;
+    for (uint16 i = 0; i < RF_TLM_MAX_SOURCES; i++){
+        if (i < RF_TLM_Data.SourceCount){
+            RF_TLM_Data.HkTlm.Payload.SourceSuppressedCount[i] = RF_TLM_Data.Sources[i].Rate.SuppressedCount;
+            RF_TLM_Data.HkTlm.Payload.RateSuppressedCount += RF_TLM_Data.Sources[i].Rate.SuppressedCount;
+            RF_TLM_Data.HkTlm.Payload.SourceDeadbandSuppressed[i] = RF_TLM_Data.Sources[i].Deadband.SuppressedCount;
+            RF_TLM_Data.HkTlm.Payload.DeadbandSuppressedCount += RF_TLM_Data.Sources[i].Deadband.SuppressedCount;
+        }else{
+            RF_TLM_Data.HkTlm.Payload.SourceSuppressedCount[i] = 0;
+            RF_TLM_Data.HkTlm.Payload.SourceDeadbandSuppressed[i] = 0;
+        }
+    }
+
+    RF_TLM_Data.HkTlm.Payload.DevState          = RF_TLM_Data.Dev.State;
+    RF_TLM_Data.HkTlm.Payload.DevProbeAttempts  = RF_TLM_Data.Dev.ProbeAttempts;
+    RF_TLM_Data.HkTlm.Payload.DevProbeFailures  = RF_TLM_Data.Dev.ProbeFailures;
+    RF_TLM_Data.HkTlm.Payload.DevReadyMsec      = RF_TLM_Data.Dev.ReadyMsec;
+    RF_TLM_Data.HkTlm.Payload.FirstFrameMsec    = RF_TLM_Data.Dev.FirstFrameMsec;
+    RF_TLM_Data.HkTlm.Payload.DevTimingValid    = (RF_TLM_Data.Dev.WasReady ? 0x01 : 0) |
+                                                  (RF_TLM_Data.Dev.FrameSent ? 0x02 : 0);
+    RF_TLM_Data.HkTlm.Payload.FrameQueueCount   = RF_TLM_Data.FrameQueue.Count;
+    RF_TLM_Data.HkTlm.Payload.FrameQueueDropped = RF_TLM_Data.FrameQueue.DroppedCount;
+    for (uint16 i = 0; i < RF_TLM_Data.SourceCount; i++){
+        RF_TLM_Data.HkTlm.Payload.FrameQueueCount   += RF_TLM_Data.Sources[i].Queue.Count;
+        RF_TLM_Data.HkTlm.Payload.FrameQueueDropped += RF_TLM_Data.Sources[i].Queue.DroppedCount;
+    }
+    RF_TLM_Data.HkTlm.Payload.PackedFrameCount  = RF_TLM_Data.PackedFrameCount;
+    RF_TLM_Data.HkTlm.Payload.PackedBytesSaved  = RF_TLM_Data.PackedBytesSaved;
+    RF_TLM_Data.HkTlm.Payload.TimeRefCount      = RF_TLM_Data.Dest.TimeRefCount;
+    RF_TLM_Data.HkTlm.Payload.FrameSeq          = RF_TLM_Data.Dest.Seq;
+    RF_TLM_Data.HkTlm.Payload.FramesSinceRef    = RF_TLM_Data.Dest.FramesSinceRef;
+    RF_TLM_Data.HkTlm.Payload.UplinkPolls           = RF_TLM_Data.Uplink.Polls;
+    RF_TLM_Data.HkTlm.Payload.UplinkEmptyPolls      = RF_TLM_Data.Uplink.EmptyPolls;
+    RF_TLM_Data.HkTlm.Payload.UplinkAccepted        = RF_TLM_Data.Uplink.Accepted;
+    RF_TLM_Data.HkTlm.Payload.UplinkRejected        = RF_TLM_Data.Uplink.Rejected;
+    RF_TLM_Data.HkTlm.Payload.UplinkDuplicates      = RF_TLM_Data.Uplink.Duplicates;
+    RF_TLM_Data.HkTlm.Payload.UplinkPollBusyUsec    = (uint32)(RF_TLM_Data.Uplink.PollBusyNs / 1000);
+    RF_TLM_Data.HkTlm.Payload.UplinkLastLatencyMsec = RF_TLM_Data.Uplink.LastLatencyMsec;
+    RF_TLM_Data.HkTlm.Payload.UplinkMaxLatencyMsec  = RF_TLM_Data.Uplink.MaxLatencyMsec;
+    RF_TLM_Data.HkTlm.Payload.UplinkPollMsec        = (uint16)RF_TLM_Data.Uplink.PollMsec;
+
+    uC_get_stats(&bus);
+    RF_TLM_Data.HkTlm.Payload.BusTimeouts         = bus.timeouts;
+    RF_TLM_Data.HkTlm.Payload.BusRecoveries       = bus.recoveries;
+    RF_TLM_Data.HkTlm.Payload.BusRecoveryFailures = bus.recovery_failures;
+    RF_TLM_Data.HkTlm.Payload.BusBusyRejects      = bus.busy_rejects;
+    RF_TLM_Data.HkTlm.Payload.BusWorkerRestarts   = bus.worker_restarts;
+
+    RF_TLM_Data.HkTlm.Payload.BusWaitMaxUsec      = bus.max_wait_ns / 1000;
+    RF_TLM_Data.HkTlm.Payload.BusBusyUsec         = (uint32)(bus.busy_ns / 1000);
+
+    strncpy(RF_TLM_Data.HkTlm.Payload.ProfileName, RF_TLM_Profiles[RF_TLM_Data.ProfileId].Name,
+            sizeof(RF_TLM_Data.HkTlm.Payload.ProfileName) - 1);
+    RF_TLM_Data.HkTlm.Payload.ProfileId           = RF_TLM_Data.ProfileId;
+    RF_TLM_Data.HkTlm.Payload.ProfileSwitches     = RF_TLM_Data.ProfileSwitches;
+    RF_TLM_Data.HkTlm.Payload.ProfileDroppedCount = RF_TLM_Data.ProfileDroppedCount;
+    RF_TLM_Data.HkTlm.Payload.SendIntervalMsec    = RF_TLM_Data.SendIntervalMsec;
+    RF_TLM_Data.HkTlm.Payload.FramesPerCycle      = RF_TLM_Data.FramesPerCycle;
+    RF_TLM_Data.HkTlm.Payload.FragMessages        = RF_TLM_Data.FragMessages;
+    RF_TLM_Data.HkTlm.Payload.FragFrames          = RF_TLM_Data.FragFrames;
+    RF_TLM_Data.HkTlm.Payload.FragBytes           = RF_TLM_Data.FragBytes;
+    RF_TLM_Data.HkTlm.Payload.FragOversize        = RF_TLM_Data.FragOversize;
+    RF_TLM_Data.HkTlm.Payload.FragQueueFull       = RF_TLM_Data.FragQueueFull;
+    RF_TLM_Data.HkTlm.Payload.ShortMsgCount       = RF_TLM_Data.ShortMsgCount;
+
+    memcpy(RF_TLM_Data.HkTlm.Payload.CpuStagePermille, RF_TLM_Data.Cpu.StagePermille,
+           sizeof(RF_TLM_Data.HkTlm.Payload.CpuStagePermille));
+    RF_TLM_Data.HkTlm.Payload.CpuActivePermille  = RF_TLM_Data.Cpu.ActivePermille;
+    RF_TLM_Data.HkTlm.Payload.CpuBudgetPermille  = RF_TLM_Data.Cpu.BudgetPermille;
+    RF_TLM_Data.HkTlm.Payload.CpuLoopMaxUsec     = RF_TLM_Data.Cpu.ReportedLoopMaxUsec;
+    RF_TLM_Data.HkTlm.Payload.CpuOverBudgetCount = RF_TLM_Data.Cpu.OverBudgetCount;
+
+    RF_TLM_Data.HkTlm.Payload.SlotPeriodMsec   = (RF_TLM_Data.Slot.Count == 0) ? 0 : RF_TLM_Data.Slot.Table.PeriodMsec;
+    RF_TLM_Data.HkTlm.Payload.SlotCount        = RF_TLM_Data.Slot.Slots;
+    RF_TLM_Data.HkTlm.Payload.SlotUsedCount    = RF_TLM_Data.Slot.SlotsUsed;
+    RF_TLM_Data.HkTlm.Payload.SlotMissedCount  = RF_TLM_Data.Slot.SlotsMissed;
+    RF_TLM_Data.HkTlm.Payload.SlotFrameCount   = RF_TLM_Data.Slot.Frames;
+    RF_TLM_Data.HkTlm.Payload.SlotUtilPermille = RF_TLM_Data.Slot.UtilPermille;
+    RF_TLM_Data.HkTlm.Payload.SlotLateMsec     = RF_TLM_Data.Slot.LateMsec;
+    RF_TLM_Data.HkTlm.Payload.SlotLateMaxMsec  = RF_TLM_Data.Slot.LateMaxMsec;
+
+    RF_TLM_Data.HkTlm.Payload.LinkTestRun   = RF_TLM_Data.LinkTest.Tlm.Payload.Run;
+    RF_TLM_Data.HkTlm.Payload.LinkTestState = RF_TLM_Data.LinkTest.Tlm.Payload.State;
+
+    RF_TLM_Data.HkTlm.Payload.FramingMode    = RF_TLM_Data.Ccsds.Mode;
+    RF_TLM_Data.HkTlm.Payload.FramingVcid    = RF_TLM_Data.Ccsds.Vcid;
+    RF_TLM_Data.HkTlm.Payload.FramingScid    = RF_TLM_Data.Ccsds.Scid;
+    RF_TLM_Data.HkTlm.Payload.CcsdsFrames    = RF_TLM_Data.Ccsds.Frames;
+    RF_TLM_Data.HkTlm.Payload.CcsdsPackets   = RF_TLM_Data.Ccsds.Packets;
+    RF_TLM_Data.HkTlm.Payload.CcsdsIdleBytes = RF_TLM_Data.Ccsds.IdleBytes;
+
+    RF_TLM_Data.HkTlm.Payload.SummarySamples = 0;
+    RF_TLM_Data.HkTlm.Payload.SummaryWindows = 0;
+    RF_TLM_Data.HkTlm.Payload.SummaryMask    = 0;
+    for (uint16 i = 0; i < RF_TLM_Data.SourceCount; i++){
+        RF_TLM_Data.HkTlm.Payload.SummarySamples += RF_TLM_Data.Sources[i].Summary.Samples;
+        RF_TLM_Data.HkTlm.Payload.SummaryWindows += RF_TLM_Data.Sources[i].Summary.Windows;
+        if (RF_TLM_Data.Sources[i].Summary.WindowMsec != 0){
+            RF_TLM_Data.HkTlm.Payload.SummaryMask |= (uint8)(1u << i);
+        }
+    }
+    RF_TLM_Data.HkTlm.Payload.SummaryFrames = RF_TLM_Data.SummaryFrames;
+
+    RF_TLM_Data.HkTlm.Payload.EventsSeen          = RF_TLM_Data.Evs.Seen;
+    RF_TLM_Data.HkTlm.Payload.EventsFiltered      = RF_TLM_Data.Evs.Filtered;
+    RF_TLM_Data.HkTlm.Payload.EventsQueued        = RF_TLM_Data.Evs.Queued;
+    RF_TLM_Data.HkTlm.Payload.EventsSent          = RF_TLM_Data.Evs.Sent;
+    RF_TLM_Data.HkTlm.Payload.EventsDropped       = RF_TLM_Data.Evs.Queue.DroppedCount;
+    RF_TLM_Data.HkTlm.Payload.EventLatencyMsec    = RF_TLM_Data.Evs.LatencyMsec;
+    RF_TLM_Data.HkTlm.Payload.EventLatencyMaxMsec = RF_TLM_Data.Evs.LatencyMaxMsec;
+
+    RF_TLM_Data.HkTlm.Payload.CdsState       = RF_TLM_Data.Cds.State;
+    RF_TLM_Data.HkTlm.Payload.CdsBacklog     = RF_TLM_Data.Cds.Backlog;
+    RF_TLM_Data.HkTlm.Payload.CdsRestored    = RF_TLM_Data.Cds.Restored;
+    RF_TLM_Data.HkTlm.Payload.CdsCheckpoints = RF_TLM_Data.Cds.Checkpoints;
+    RF_TLM_Data.HkTlm.Payload.CdsErrors      = RF_TLM_Data.Cds.Errors;
+    RF_TLM_Data.HkTlm.Payload.CdsLastUsec    = RF_TLM_Data.Cds.LastUsec;
+    RF_TLM_Data.HkTlm.Payload.CdsMaxUsec     = RF_TLM_Data.Cds.MaxUsec;
+
+    RF_TLM_Data.HkTlm.Payload.CompressMode          = RF_TLM_Data.Lz.Mode;
+    RF_TLM_Data.HkTlm.Payload.CompressRatioPermille =
+        (RF_TLM_Data.Lz.InBytes == 0)
+            ? 0
+            : (uint16)(((uint64)RF_TLM_Data.Lz.OutBytes * 1000u + RF_TLM_Data.Lz.InBytes / 2) / RF_TLM_Data.Lz.InBytes);
+    RF_TLM_Data.HkTlm.Payload.CompressBlocks       = RF_TLM_Data.Lz.Blocks;
+    RF_TLM_Data.HkTlm.Payload.CompressStored       = RF_TLM_Data.Lz.Stored;
+    RF_TLM_Data.HkTlm.Payload.CompressInBytes      = RF_TLM_Data.Lz.InBytes;
+    RF_TLM_Data.HkTlm.Payload.CompressOutBytes     = RF_TLM_Data.Lz.OutBytes;
+    RF_TLM_Data.HkTlm.Payload.CompressFrameNsec    = RF_TLM_Data.Lz.FrameNsec;
+    RF_TLM_Data.HkTlm.Payload.CompressFrameNsecMax = RF_TLM_Data.Lz.FrameNsecMax;
+
+    RF_TLM_Data.HkTlm.Payload.ContactState        = RF_TLM_Data.Contact.State;
+    RF_TLM_Data.HkTlm.Payload.ContactUtilPermille = RF_TLM_Data.Contact.UtilPermille;
+    RF_TLM_Data.HkTlm.Payload.ContactWindows      = RF_TLM_Data.Contact.Windows;
+    RF_TLM_Data.HkTlm.Payload.ContactFrames       = RF_TLM_Data.Contact.Frames;
+    RF_TLM_Data.HkTlm.Payload.ContactNextSec      = RF_TLM_Contact_NextSec();
+    RF_TLM_Data.HkTlm.Payload.ContactBacklog      = RF_TLM_Data.Contact.Backlog;
+    RF_TLM_Data.HkTlm.Payload.ContactCarried      = RF_TLM_Data.Contact.Carried;
+    RF_TLM_Data.HkTlm.Payload.ContactCarriedBytes = RF_TLM_Data.Contact.CarriedBytes;
+
+    RF_TLM_Data.HkTlm.Payload.SnapPullMask    = RF_TLM_Data.Snap.PullMask;
+    RF_TLM_Data.HkTlm.Payload.SnapLatencyMsec = RF_TLM_Data.Snap.LatencyMsec;
+    RF_TLM_Data.HkTlm.Payload.SnapRequests    = RF_TLM_Data.Snap.Requests;
+    RF_TLM_Data.HkTlm.Payload.SnapFrames      = RF_TLM_Data.Snap.Queued;
+    RF_TLM_Data.HkTlm.Payload.SnapSent        = RF_TLM_Data.Snap.Sent;
+    RF_TLM_Data.HkTlm.Payload.SnapMissing     = RF_TLM_Data.Snap.Missing;
+    RF_TLM_Data.HkTlm.Payload.SnapHeld        = RF_TLM_Data.Snap.Held;
+
     /*
     ** Send housekeeping telemetry packet...
     */
@@ -469,10 +840,15 @@ int32 RF_TLM_ReportHousekeeping(const CFE_MSG_CommandHeader_t *Msg)
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
 int32 RF_TLM_Enable_Debug(const RF_TLM_EnableDebugCmd_t *Msg)
 {
+#if RF_TLM_CFG_DEBUG
     RF_TLM_Data.CmdCounter++;
     RF_TLM_Data.tlm_debug = true;
 
     CFE_EVS_SendEvent(RF_TLM_COMMANDDEBUG_INF_EID, CFE_EVS_EventType_INFORMATION, "RF TLM: Debug enabled");
+#else
+    RF_TLM_Data.ErrCounter++;
+    CFE_EVS_SendEvent(RF_TLM_COMMAND_ERR_EID, CFE_EVS_EventType_ERROR, "RF TLM: Debug not built into this profile");
+#endif
 
     return CFE_SUCCESS;
 }
@@ -494,200 +870,1185 @@ int32 RF_TLM_Disable_Debug(const RF_TLM_DisableDebugCmd_t *Msg)
 
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
 /*                                                                            */
-/* RF TLM NOOP commands                                                       */
+/* RF TLM Set Rate command                                                    */
 /*                                                                            */
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
-int32 RF_TLM_Noop(const RF_TLM_NoopCmd_t *Msg)
+int32 RF_TLM_SetRate(const RF_TLM_SetRateCmd_t *Msg)
 {
+    RF_TLM_Source_t *Source;
+
+    Source = RF_TLM_FindSource(CFE_SB_ValueToMsgId(Msg->Payload.MsgId));
+    if (Source == NULL)
+    {
+        RF_TLM_Data.ErrCounter++;
+        CFE_EVS_SendEvent(RF_TLM_COMMAND_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "RF TLM: Set rate for unknown source MID = 0x%x", (unsigned int)Msg->Payload.MsgId);
+        return CFE_SUCCESS;
+    }
+
+    RF_TLM_Rate_Set(&Source->Rate, Msg->Payload.Decimation, Msg->Payload.MinIntervalMsec);
     RF_TLM_Data.CmdCounter++;
 
-    CFE_EVS_SendEvent(RF_TLM_COMMANDNOP_INF_EID, CFE_EVS_EventType_INFORMATION, "RF TLM: NOOP command %s",
-                      RF_TLM_VERSION);
+    CFE_EVS_SendEvent(RF_TLM_SETRATE_INF_EID, CFE_EVS_EventType_INFORMATION,
+                      "RF TLM: MID 0x%x decimation %u, min interval %lu ms", (unsigned int)Msg->Payload.MsgId,
+                      (unsigned int)Msg->Payload.Decimation, (unsigned long)Msg->Payload.MinIntervalMsec);
 
     return CFE_SUCCESS;
 }
 
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
 /*                                                                            */
-/*  Purpose:                                                                  */
-/*         This function resets all the global counter variables that are     */
-/*         part of the task telemetry.                                        */
+/* RF TLM Set Encoding command                                                */
 /*                                                                            */
-/* * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * *  * *  * * * * */
-int32 RF_TLM_ResetCounters(const RF_TLM_ResetCountersCmd_t *Msg)
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+int32 RF_TLM_SetEncoding(const RF_TLM_SetEncodingCmd_t *Msg)
 {
-    RF_TLM_Data.CmdCounter = 0;
-    RF_TLM_Data.ErrCounter = 0;
+    RF_TLM_Source_t *Source;
 
-    CFE_EVS_SendEvent(RF_TLM_COMMANDRST_INF_EID, CFE_EVS_EventType_INFORMATION, "RF TLM: RESET command");
+    Source = RF_TLM_FindSource(CFE_SB_ValueToMsgId(Msg->Payload.MsgId));
+    if (Source == NULL || !RF_TLM_ENC_BUILT(Msg->Payload.Encoding) ||
+        (Msg->Payload.Encoding == RF_TLM_ENC_PACKED && Source->Schema == NULL))
+    {
+        RF_TLM_Data.ErrCounter++;
+        CFE_EVS_SendEvent(RF_TLM_COMMAND_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "RF TLM: Invalid encoding %u for MID = 0x%x", (unsigned int)Msg->Payload.Encoding,
+                          (unsigned int)Msg->Payload.MsgId);
+        return CFE_SUCCESS;
+    }
+
+    Source->Encoding = Msg->Payload.Encoding;
+    RF_TLM_Data.CmdCounter++;
+
+    CFE_EVS_SendEvent(RF_TLM_SETENC_INF_EID, CFE_EVS_EventType_INFORMATION, "RF TLM: MID 0x%x encoding %s",
+                      (unsigned int)Msg->Payload.MsgId,
+                      (Source->Encoding == RF_TLM_ENC_PACKED)     ? "packed"
+                      : (Source->Encoding == RF_TLM_ENC_FRAGMENT) ? "fragment"
+                                                                  : "raw");
 
     return CFE_SUCCESS;
 }
 
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
 /*                                                                            */
-/* Verify command packet length                                               */
+/* RF TLM Set Deadband command                                                */
 /*                                                                            */
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
-bool RF_TLM_VerifyCmdLength(CFE_MSG_Message_t *MsgPtr, size_t ExpectedLength)
+int32 RF_TLM_SetDeadband(const RF_TLM_SetDeadbandCmd_t *Msg)
 {
-    bool              result       = true;
-    size_t            ActualLength = 0;
-    CFE_SB_MsgId_t    MsgId        = CFE_SB_INVALID_MSG_ID;
-    CFE_MSG_FcnCode_t FcnCode      = 0;
-
-    CFE_MSG_GetSize(MsgPtr, &ActualLength);
-
-    /*
-    ** Verify the command packet length.
-    */
-    if (ExpectedLength != ActualLength)
+    RF_TLM_Source_t *Source;
+    float            Abs = Msg->Payload.AbsThreshold;
+    float            Rel = Msg->Payload.RelThreshold;
+
+    /* Thresholds are compared against field values, so the source needs a schema */
+    Source = RF_TLM_FindSource(CFE_SB_ValueToMsgId(Msg->Payload.MsgId));
+    if (Source == NULL || Source->Schema == NULL || Msg->Payload.Field >= RF_TLM_RAW_FIELD_COUNT ||
+        !(Abs >= 0.0f) || !(Rel >= 0.0f))
     {
-        CFE_MSG_GetMsgId(MsgPtr, &MsgId);
-        CFE_MSG_GetFcnCode(MsgPtr, &FcnCode);
-
-        CFE_EVS_SendEvent(RF_TLM_LEN_ERR_EID, CFE_EVS_EventType_ERROR,
-                          "Invalid Msg length: ID = 0x%X,  CC = %u, Len = %u, Expected = %u",
-                          (unsigned int)CFE_SB_MsgIdToValue(MsgId), (unsigned int)FcnCode, (unsigned int)ActualLength,
-                          (unsigned int)ExpectedLength);
-
-        result = false;
-
         RF_TLM_Data.ErrCounter++;
+        CFE_EVS_SendEvent(RF_TLM_COMMAND_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "RF TLM: Invalid deadband for MID = 0x%x field %u", (unsigned int)Msg->Payload.MsgId,
+                          (unsigned int)Msg->Payload.Field);
+        return CFE_SUCCESS;
     }
 
-    return result;
-}
+    RF_TLM_Deadband_SetField(&Source->Deadband, Msg->Payload.Field, Abs, Rel);
+    RF_TLM_Deadband_SetHeartbeat(&Source->Deadband, Msg->Payload.HeartbeatMsec);
+    RF_TLM_Data.CmdCounter++;
 
-/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
-/*                                                                 */
-/* RF_TLM_openTLM() -- Open TLM                                    */
-/*                                                                 */
-/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
-void RF_TLM_openTLM(void){
-    int32 status;
+    CFE_EVS_SendEvent(RF_TLM_SETDEADBAND_INF_EID, CFE_EVS_EventType_INFORMATION,
+                      "RF TLM: MID 0x%x field %u deadband abs %g rel %g, heartbeat %lu ms",
+                      (unsigned int)Msg->Payload.MsgId, (unsigned int)Msg->Payload.Field, (double)Abs, (double)Rel,
+                      (unsigned long)Msg->Payload.HeartbeatMsec);
 
-    status = genuC_driver_open();
-    if (status != CFE_SUCCESS){
-      CFE_EVS_SendEvent(RF_TLM_GENUC_ERR_EID, CFE_EVS_EventType_ERROR, "RF TLM: Error opening the genuC driver");
-    }
+    return CFE_SUCCESS;
 }
 
-/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
-/*                                                                 */
-/* RF_TLM_forward_telemetry() -- Forward telemetry                 */
-/*                                                                 */
-/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
-void RF_TLM_forward_telemetry(void){
-    int32            status = 0;
-    int32            CFE_SB_status = CFE_SUCCESS;
-    CFE_SB_Buffer_t* TlmMsgPtr = NULL;
-    CFE_SB_MsgId_t   TlmMsgId;
-
-
-    SUBS_APP_OutData_t* dataPtr = NULL;
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RF TLM Set Profile command                                                 */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+int32 RF_TLM_SetProfile(const RF_TLM_SetProfileCmd_t *Msg)
+{
+    char  Name[RF_TLM_PROFILE_NAME_LEN];
+    int32 ProfileId;
 
-    do{
-        CFE_SB_status = CFE_SB_ReceiveBuffer(&TlmMsgPtr, RF_TLM_Data.TlmPipe, CFE_SB_POLL);
-        dataPtr = NULL;
+    memcpy(Name, Msg->Payload.Name, sizeof(Name));
+    Name[sizeof(Name) - 1] = '\0';
 
-        if (CFE_SB_status == CFE_SUCCESS){
-            if((RF_TLM_Data.suppress_sendto == false) && (RF_TLM_Data.downlink_on == true)){
-              CFE_MSG_GetMsgId(&TlmMsgPtr->Msg, &TlmMsgId);
+    ProfileId = RF_TLM_Profile_Find(Name);
+    if (ProfileId < 0)
+    {
+        RF_TLM_Data.ErrCounter++;
+        CFE_EVS_SendEvent(RF_TLM_COMMAND_ERR_EID, CFE_EVS_EventType_ERROR, "RF TLM: Unknown link profile '%s'",
+                          Name);
+        return CFE_SUCCESS;
+    }
 
-              /* Update the private data */
-              dataPtr = (SUBS_APP_OutData_t *)TlmMsgPtr;
-              RF_TLM_Data.AppID_H = dataPtr->AppID_H;
-              RF_TLM_Data.AppID_L = dataPtr->AppID_L;
-              RF_TLM_Data.Ext_CmdCounter = dataPtr->CommandCounter;
-              RF_TLM_Data.Ext_ErrCounter = dataPtr->CommandErrorCounter;
-              for(int i=0;i<4;i++){
-                RF_TLM_Data.byte_group_1[i] = dataPtr->byte_group_1[i];
-                RF_TLM_Data.byte_group_2[i] = dataPtr->byte_group_2[i];
-                RF_TLM_Data.byte_group_3[i] = dataPtr->byte_group_3[i];
-                RF_TLM_Data.byte_group_4[i] = dataPtr->byte_group_4[i];
-                RF_TLM_Data.byte_group_5[i] = dataPtr->byte_group_5[i];
-                RF_TLM_Data.byte_group_6[i] = dataPtr->byte_group_6[i];
-              }
+    /* Commands run between loop steps, so the switch is never seen half done */
+    RF_TLM_Profile_Apply((uint8)ProfileId);
+    RF_TLM_Data.ProfileSwitches++;
+    RF_TLM_Data.CmdCounter++;
 
-              CFE_ES_PerfLogEntry(RF_TLM_I2C_SEND_PERF_ID);
+    CFE_EVS_SendEvent(RF_TLM_SETPROFILE_INF_EID, CFE_EVS_EventType_INFORMATION,
+                      "RF TLM: Link profile %s, %u frames every %lu ms", RF_TLM_Profiles[ProfileId].Name,
+                      (unsigned int)RF_TLM_Data.FramesPerCycle, (unsigned long)RF_TLM_Data.SendIntervalMsec);
 
-              status = send_tlm_data();
+    return CFE_SUCCESS;
+}
 
-              CFE_ES_PerfLogExit(RF_TLM_I2C_SEND_PERF_ID);
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RF TLM Set CPU Budget command                                              */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+int32 RF_TLM_SetCpuBudget(const RF_TLM_SetCpuBudgetCmd_t *Msg)
+{
+    if (Msg->Payload.BudgetPermille > 1000)
+    {
+        RF_TLM_Data.ErrCounter++;
+        CFE_EVS_SendEvent(RF_TLM_COMMAND_ERR_EID, CFE_EVS_EventType_ERROR, "RF TLM: Invalid CPU budget %u permille",
+                          (unsigned int)Msg->Payload.BudgetPermille);
+        return CFE_SUCCESS;
+    }
 
-              if(RF_TLM_Data.tlm_debug){
-                switch (CFE_SB_MsgIdToValue(TlmMsgId)){
+    RF_TLM_Data.Cpu.BudgetPermille = Msg->Payload.BudgetPermille;
+    RF_TLM_Data.Cpu.OverBudget     = false;
+    RF_TLM_Data.CmdCounter++;
 
-                  case IMU_APP_RF_DATA_MID:
-                    CFE_EVS_SendEvent(RF_TLM_INVALID_MSGID_ERR_EID, CFE_EVS_EventType_INFORMATION,
-                                      "RF TLM - Enviando IMU app con status %d",status);
-                    break;
+    CFE_EVS_SendEvent(RF_TLM_CPU_INF_EID, CFE_EVS_EventType_INFORMATION, "RF TLM: CPU budget %u.%u%%",
+                      Msg->Payload.BudgetPermille / 10, Msg->Payload.BudgetPermille % 10);
 
-                  case BLINKY_RF_DATA_MID:
-                    CFE_EVS_SendEvent(RF_TLM_INVALID_MSGID_ERR_EID, CFE_EVS_EventType_INFORMATION,
-                                      "RF TLM - Enviando Blinky app con status %d",status);
-                    break;
+    return CFE_SUCCESS;
+}
 
-                  case ALTITUDE_APP_RF_DATA_MID:
-                    CFE_EVS_SendEvent(RF_TLM_INVALID_MSGID_ERR_EID, CFE_EVS_EventType_INFORMATION,
-                                      "RF TLM - Enviando Altitud app con status %d",status);
-                    break;
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RF TLM Set Slots command                                                   */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+int32 RF_TLM_SetSlots(const RF_TLM_SetSlotsCmd_t *Msg)
+{
+    if (!RF_TLM_Slot_Load(&Msg->Payload))
+    {
+        RF_TLM_Data.ErrCounter++;
+        CFE_EVS_SendEvent(RF_TLM_COMMAND_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "RF TLM: Invalid slot table, period %u ms", (unsigned int)Msg->Payload.PeriodMsec);
+        return CFE_SUCCESS;
+    }
 
-                  case TEMP_APP_RF_DATA_MID:
-                    CFE_EVS_SendEvent(RF_TLM_INVALID_MSGID_ERR_EID, CFE_EVS_EventType_INFORMATION,
-                                      "RF TLM - Enviando Temp app con status %d",status);
-                    break;
+    RF_TLM_Data.CmdCounter++;
 
-                  default:
-                    CFE_EVS_SendEvent(RF_TLM_INVALID_MSGID_ERR_EID, CFE_EVS_EventType_ERROR,
-                                      "RF TLM - Recvd invalid TLM msgId (0x%08X)", CFE_SB_MsgIdToValue(TlmMsgId));
-                    break;
-                }
-              }
-            }else{
-                status = 0;
-            }
+    CFE_EVS_SendEvent(RF_TLM_SETSLOTS_INF_EID, CFE_EVS_EventType_INFORMATION,
+                      "RF TLM: Slot period %u ms, %u windows, guard %u ms",
+                      (unsigned int)Msg->Payload.PeriodMsec, (unsigned int)RF_TLM_Data.Slot.Count,
+                      (unsigned int)Msg->Payload.GuardMsec);
 
-            if (status < 0){
-                CFE_EVS_SendEvent(RF_TLM_TLMOUTSTOP_ERR_EID, CFE_EVS_EventType_ERROR,
-                                  "RF TLM: RF send tlm error. Tlm output suppressed\n");
-                RF_TLM_Data.suppress_sendto = true;
-            }
-        }else if(CFE_SB_status == CFE_SB_NO_MESSAGE){
-          // The pipe is empty
-          break;
-        }else if(CFE_SB_status == CFE_SB_TIME_OUT){
-          CFE_EVS_SendEvent(RF_TLM_PIPE_ERR_EID, CFE_EVS_EventType_INFORMATION,
-                            "RF TLM: Message fails to arrive within the specified timeout period\n");
-          break;
-        }
-        // RF_TLM_Data_Init();
-        OS_TaskDelay(RF_TLM_TASK_MSEC); /*2 Hz*/
-    }while(CFE_SB_status == CFE_SUCCESS);
+    return CFE_SUCCESS;
 }
 
-int32 send_tlm_data(){
-  int rv;
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RF TLM Set Contacts command                                                */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+int32 RF_TLM_SetContacts(const RF_TLM_SetContactsCmd_t *Msg)
+{
+    if (!RF_TLM_Contact_Load(&Msg->Payload))
+    {
+        RF_TLM_Data.ErrCounter++;
+        CFE_EVS_SendEvent(RF_TLM_COMMAND_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "RF TLM: Invalid contact table, summary window %lu ms",
+                          (unsigned long)Msg->Payload.SummaryMsec);
+        return CFE_SUCCESS;
+    }
 
-  uint8_t *val;
-  val = NULL;
-  val = malloc(RF_PAYLOAD_BYTES * sizeof(uint8_t));
+    RF_TLM_Data.CmdCounter++;
 
-  if(RF_TLM_Data.tlm_debug){
-    CFE_EVS_SendEvent(RF_TLM_TLMOUTSTOP_ERR_EID, CFE_EVS_EventType_ERROR,
-                      "RF TLM: Sending packet from [AppID]: 0x%x%x",RF_TLM_Data.AppID_H, RF_TLM_Data.AppID_L);
-  }
+    CFE_EVS_SendEvent(RF_TLM_SETCONTACTS_INF_EID, CFE_EVS_EventType_INFORMATION,
+                      "RF TLM: %u contact windows, interval %u ms, summary window %lu ms",
+                      (unsigned int)RF_TLM_Data.Contact.Count, (unsigned int)Msg->Payload.IntervalMsec,
+                      (unsigned long)Msg->Payload.SummaryMsec);
 
-  val[0] = RF_TLM_Data.AppID_H;
-  val[1] = RF_TLM_Data.AppID_L;
-  val[2] = RF_TLM_Data.Ext_ErrCounter;
-  val[3] = RF_TLM_Data.Ext_CmdCounter;
-  val[4] = 0;
-  val[5] = 0;
+    return CFE_SUCCESS;
+}
 
-  for(int i=0;i<4;i++){
-    val[i+6] = RF_TLM_Data.byte_group_1[i];
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RF TLM Snapshot command                                                    */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+int32 RF_TLM_Snapshot(const RF_TLM_SnapshotCmd_t *Msg)
+{
+    RF_TLM_Snap_t   *Snap = &RF_TLM_Data.Snap;
+    RF_TLM_Source_t *Source;
+    uint8            Mask = 0;
+    uint8            Whole = 0;
+    uint8            bit;
+    uint16           Index;
+    uint16           Named = 0;
+    uint16           Queued = 0;
+
+    if (Msg->Payload.Forward > RF_TLM_SNAP_FWD_PUSH)
+    {
+        RF_TLM_Data.ErrCounter++;
+        CFE_EVS_SendEvent(RF_TLM_COMMAND_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "RF TLM: Invalid snapshot forwarding %u", (unsigned int)Msg->Payload.Forward);
+        return CFE_SUCCESS;
+    }
+
+    /* Every MID must name a source, or nothing is sent */
+    for (Named = 0; Named < RF_TLM_SNAP_MAX_MIDS && Msg->Payload.MsgId[Named] != 0; Named++)
+    {
+        if (RF_TLM_FindSource(CFE_SB_ValueToMsgId(Msg->Payload.MsgId[Named])) == NULL)
+        {
+            RF_TLM_Data.ErrCounter++;
+            CFE_EVS_SendEvent(RF_TLM_COMMAND_ERR_EID, CFE_EVS_EventType_ERROR,
+                              "RF TLM: Snapshot of unknown source MID = 0x%x",
+                              (unsigned int)Msg->Payload.MsgId[Named]);
+            return CFE_SUCCESS;
+        }
+    }
+
+    if (Named == 0)
+    {
+        RF_TLM_Data.ErrCounter++;
+        CFE_EVS_SendEvent(RF_TLM_COMMAND_ERR_EID, CFE_EVS_EventType_ERROR, "RF TLM: Snapshot names no source");
+        return CFE_SUCCESS;
+    }
+
+    /* Frames go out in the order named, a source named twice once */
+    Snap->RequestMsec = RF_TLM_GetMsec();
+    ++Snap->Requests;
+    for (uint16 i = 0; i < Named; i++)
+    {
+        Source = RF_TLM_FindSource(CFE_SB_ValueToMsgId(Msg->Payload.MsgId[i]));
+        Index  = (uint16)(Source - RF_TLM_Data.Sources);
+        bit    = (uint8)(1u << Index);
+        if ((Mask & bit) == 0)
+        {
+            Mask |= bit;
+            Queued += RF_TLM_Snap_Queue(Index) ? 1 : 0;
+        }
+        if (!RF_TLM_Snap_Allowed(Index))
+        {
+            /* On pull it could never be sent */
+            Whole |= bit;
+        }
+    }
+
+    if (Msg->Payload.Forward == RF_TLM_SNAP_FWD_PULL)
+    {
+        Snap->PullMask |= (uint8)(Mask & ~Whole);
+    }
+    else if (Msg->Payload.Forward == RF_TLM_SNAP_FWD_PUSH)
+    {
+        Snap->PullMask &= (uint8)~Mask;
+    }
+
+    RF_TLM_Data.CmdCounter++;
+
+    CFE_EVS_SendEvent(RF_TLM_SNAPSHOT_INF_EID, CFE_EVS_EventType_INFORMATION,
+                      "RF TLM: Snapshot of %u sources, %u queued, pull mask 0x%02x", (unsigned int)Named,
+                      (unsigned int)Queued, (unsigned int)Snap->PullMask);
+
+    return CFE_SUCCESS;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RF TLM Link Test command                                                   */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+int32 RF_TLM_LinkTest(const RF_TLM_LinkTestCmd_t *Msg)
+{
+    if (Msg->Payload.DurationMsec == 0)
+    {
+        if (!RF_TLM_Data.LinkTest.Active)
+        {
+            RF_TLM_Data.ErrCounter++;
+            CFE_EVS_SendEvent(RF_TLM_LINKTEST_ERR_EID, CFE_EVS_EventType_ERROR, "RF TLM: No link test running");
+            return CFE_SUCCESS;
+        }
+
+        RF_TLM_LinkTest_Stop(RF_TLM_LINKTEST_STOPPED);
+        RF_TLM_Data.CmdCounter++;
+        return CFE_SUCCESS;
+    }
+
+    if (RF_TLM_LinkTest_Start(&Msg->Payload))
+    {
+        RF_TLM_Data.CmdCounter++;
+    }
+    else
+    {
+        RF_TLM_Data.ErrCounter++;
+    }
+
+    return CFE_SUCCESS;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RF TLM Set Framing command                                                 */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+int32 RF_TLM_SetFraming(const RF_TLM_SetFramingCmd_t *Msg)
+{
+    uint16 dropped;
+
+    if (Msg->Payload.Mode > RF_TLM_FRAMING_CCSDS || Msg->Payload.Vcid > RF_TLM_TM_VCID_MAX ||
+        Msg->Payload.Scid > RF_TLM_TM_SCID_MAX)
+    {
+        RF_TLM_Data.ErrCounter++;
+        CFE_EVS_SendEvent(RF_TLM_COMMAND_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "RF TLM: Invalid framing mode %u, VC %u, SCID 0x%x", (unsigned int)Msg->Payload.Mode,
+                          (unsigned int)Msg->Payload.Vcid, (unsigned int)Msg->Payload.Scid);
+        return CFE_SUCCESS;
+    }
+
+    dropped = RF_TLM_Ccsds_Configure(Msg->Payload.Mode, Msg->Payload.Scid, Msg->Payload.Vcid);
+    RF_TLM_Data.CmdCounter++;
+
+    CFE_EVS_SendEvent(RF_TLM_SETFRAMING_INF_EID, CFE_EVS_EventType_INFORMATION,
+                      "RF TLM: Framing %s, SCID 0x%x VC %u, %u unsent bytes dropped",
+                      (Msg->Payload.Mode == RF_TLM_FRAMING_CCSDS) ? "CCSDS" : "native",
+                      (unsigned int)Msg->Payload.Scid, (unsigned int)Msg->Payload.Vcid, (unsigned int)dropped);
+
+    return CFE_SUCCESS;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RF TLM Set Summary command                                                 */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+int32 RF_TLM_SetSummary(const RF_TLM_SetSummaryCmd_t *Msg)
+{
+    RF_TLM_Source_t *Source;
+    uint8            used = 0;
+
+    /* Statistics are taken over field values, so the source needs a schema */
+    Source = RF_TLM_FindSource(CFE_SB_ValueToMsgId(Msg->Payload.MsgId));
+    if (Source != NULL && Source->Schema != NULL){
+        for (uint8 f = 0; f < RF_TLM_RAW_FIELD_COUNT; f++){
+            if (Source->Schema->Fields[f].Kind != RF_TLM_FIELD_UNUSED){
+                used |= (uint8)(1u << f);
+            }
+        }
+    }
+
+    if (Source == NULL || Source->Schema == NULL || Msg->Payload.WindowMsec > RF_TLM_SUMMARY_MAX_WINDOW_MSEC ||
+        (Msg->Payload.WindowMsec != 0 && (Msg->Payload.FieldMask == 0 || (Msg->Payload.FieldMask & ~used) != 0)))
+    {
+        RF_TLM_Data.ErrCounter++;
+        CFE_EVS_SendEvent(RF_TLM_COMMAND_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "RF TLM: Invalid summary for MID = 0x%x, window %lu ms, fields 0x%02x",
+                          (unsigned int)Msg->Payload.MsgId, (unsigned long)Msg->Payload.WindowMsec,
+                          (unsigned int)Msg->Payload.FieldMask);
+        return CFE_SUCCESS;
+    }
+
+    /* The window in progress is sent as it stands rather than lost */
+    if (Source->Summary.WindowMsec != 0 && Source->Summary.Count != 0){
+        RF_TLM_summary_close(Source);
+    }
+
+    /* The ground's setting stands, contact windows no longer switch the source */
+    RF_TLM_Summary_Configure(&Source->Summary, Msg->Payload.WindowMsec, Msg->Payload.FieldMask);
+    RF_TLM_Data.Contact.AutoSummary &= (uint8)~(1u << (Source - RF_TLM_Data.Sources));
+    RF_TLM_Data.CmdCounter++;
+
+    if (Msg->Payload.WindowMsec != 0){
+        CFE_EVS_SendEvent(RF_TLM_SETSUMMARY_INF_EID, CFE_EVS_EventType_INFORMATION,
+                          "RF TLM: MID 0x%x summarized over %lu ms, fields 0x%02x", (unsigned int)Msg->Payload.MsgId,
+                          (unsigned long)Msg->Payload.WindowMsec, (unsigned int)Msg->Payload.FieldMask);
+    }else{
+        CFE_EVS_SendEvent(RF_TLM_SETSUMMARY_INF_EID, CFE_EVS_EventType_INFORMATION,
+                          "RF TLM: MID 0x%x forwarded raw", (unsigned int)Msg->Payload.MsgId);
+    }
+
+    return CFE_SUCCESS;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RF TLM Set Event Filter command                                            */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+int32 RF_TLM_SetEventFilter(const RF_TLM_SetEventFilterCmd_t *Msg)
+{
+    char  AppName[CFE_MISSION_MAX_API_LEN];
+    uint8 MinType = Msg->Payload.MinType;
+
+    memcpy(AppName, Msg->Payload.AppName, sizeof(AppName));
+    AppName[sizeof(AppName) - 1] = '\0';
+
+    if ((MinType < CFE_EVS_EventType_DEBUG || MinType > CFE_EVS_EventType_CRITICAL) && MinType != RF_TLM_EVENT_MUTED)
+    {
+        RF_TLM_Data.ErrCounter++;
+        CFE_EVS_SendEvent(RF_TLM_COMMAND_ERR_EID, CFE_EVS_EventType_ERROR, "RF TLM: Invalid event type %u",
+                          (unsigned int)MinType);
+        return CFE_SUCCESS;
+    }
+
+    if (RF_TLM_Evs_SetFilter(AppName, MinType) < 0)
+    {
+        RF_TLM_Data.ErrCounter++;
+        CFE_EVS_SendEvent(RF_TLM_COMMAND_ERR_EID, CFE_EVS_EventType_ERROR, "RF TLM: App %s has no event code",
+                          AppName);
+        return CFE_SUCCESS;
+    }
+
+    RF_TLM_Data.CmdCounter++;
+
+    CFE_EVS_SendEvent(RF_TLM_SETEVTFILTER_INF_EID, CFE_EVS_EventType_INFORMATION,
+                      "RF TLM: Events of %s sent from type %u", (AppName[0] != '\0') ? AppName : "other apps",
+                      (unsigned int)MinType);
+
+    return CFE_SUCCESS;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RF TLM Set Compress command                                                */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+int32 RF_TLM_SetCompress(const RF_TLM_SetCompressCmd_t *Msg)
+{
+    uint16 dropped;
+
+    if (Msg->Payload.Mode > RF_TLM_COMPRESS_LZSS)
+    {
+        RF_TLM_Data.ErrCounter++;
+        CFE_EVS_SendEvent(RF_TLM_COMMAND_ERR_EID, CFE_EVS_EventType_ERROR, "RF TLM: Invalid compression mode %u",
+                          (unsigned int)Msg->Payload.Mode);
+        return CFE_SUCCESS;
+    }
+
+    dropped = RF_TLM_Lz_Configure(Msg->Payload.Mode);
+    RF_TLM_Data.CmdCounter++;
+
+    CFE_EVS_SendEvent(RF_TLM_SETCOMPRESS_INF_EID, CFE_EVS_EventType_INFORMATION,
+                      "RF TLM: Compression %s, %u unsent frames dropped",
+                      (Msg->Payload.Mode == RF_TLM_COMPRESS_LZSS) ? "LZSS" : "off", (unsigned int)dropped);
+
+    return CFE_SUCCESS;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RF TLM NOOP commands                                                       */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+int32 RF_TLM_Noop(const RF_TLM_NoopCmd_t *Msg)
+{
+    RF_TLM_Data.CmdCounter++;
+
+    CFE_EVS_SendEvent(RF_TLM_COMMANDNOP_INF_EID, CFE_EVS_EventType_INFORMATION, "RF TLM: NOOP command %s",
+                      RF_TLM_VERSION);
+
+    return CFE_SUCCESS;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         This function resets all the global counter variables that are     */
+/*         part of the task telemetry.                                        */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * *  * *  * * * * */
+int32 RF_TLM_ResetCounters(const RF_TLM_ResetCountersCmd_t *Msg)
+{
+    RF_TLM_Data.CmdCounter = 0;
+    RF_TLM_Data.ErrCounter = 0;
+
+    CFE_EVS_SendEvent(RF_TLM_COMMANDRST_INF_EID, CFE_EVS_EventType_INFORMATION, "RF TLM: RESET command");
+
+    return CFE_SUCCESS;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Verify command packet length                                               */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+bool RF_TLM_VerifyCmdLength(CFE_MSG_Message_t *MsgPtr, size_t ExpectedLength)
+{
+    bool              result       = true;
+    size_t            ActualLength = 0;
+    CFE_SB_MsgId_t    MsgId        = CFE_SB_INVALID_MSG_ID;
+    CFE_MSG_FcnCode_t FcnCode      = 0;
+
+    CFE_MSG_GetSize(MsgPtr, &ActualLength);
+
+    /*
+    ** Verify the command packet length.
+    */
+    if (ExpectedLength != ActualLength)
+    {
+        CFE_MSG_GetMsgId(MsgPtr, &MsgId);
+        CFE_MSG_GetFcnCode(MsgPtr, &FcnCode);
+
+        CFE_EVS_SendEvent(RF_TLM_LEN_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "Invalid Msg length: ID = 0x%X,  CC = %u, Len = %u, Expected = %u",
+                          (unsigned int)CFE_SB_MsgIdToValue(MsgId), (unsigned int)FcnCode, (unsigned int)ActualLength,
+                          (unsigned int)ExpectedLength);
+
+        result = false;
+
+        RF_TLM_Data.ErrCounter++;
+    }
+
+    return result;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_forward_events() -- Move events to the fast lane         */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void RF_TLM_forward_events(void){
+    CFE_SB_Buffer_t* EvtMsgPtr = NULL;
+
+    RF_TLM_Cpu_Enter(RF_TLM_STAGE_RECEIVE);
+    while (CFE_SB_ReceiveBuffer(&EvtMsgPtr, RF_TLM_Data.EventPipe, CFE_SB_POLL) == CFE_SUCCESS){
+        /* Events are not held while the output is off, the pipe is still drained */
+        if((RF_TLM_Data.suppress_sendto == false) && (RF_TLM_Data.downlink_on == true)){
+            RF_TLM_Evs_Forward(EvtMsgPtr);
+        }
+    }
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_forward_telemetry() -- Forward telemetry                 */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void RF_TLM_forward_telemetry(void){
+    int32            CFE_SB_status = CFE_SUCCESS;
+    CFE_SB_Buffer_t* TlmMsgPtr = NULL;
+    CFE_SB_MsgId_t   TlmMsgId;
+    RF_TLM_Source_t* Source;
+    RF_TLM_Frame_t   Frame;
+    uint32           NowMsec;
+    CFE_MSG_Size_t   MsgSize;
+    uint16           Index;
+
+    SUBS_APP_OutData_t* dataPtr = NULL;
+
+    do{
+        RF_TLM_Cpu_Enter(RF_TLM_STAGE_RECEIVE);
+        CFE_SB_status = CFE_SB_ReceiveBuffer(&TlmMsgPtr, RF_TLM_Data.TlmPipe, CFE_SB_POLL);
+        RF_TLM_Cpu_Enter(RF_TLM_STAGE_ENCODE);
+        dataPtr = NULL;
+
+        if (CFE_SB_status == CFE_SUCCESS){
+            if((RF_TLM_Data.suppress_sendto == false) && (RF_TLM_Data.downlink_on == true)){
+              CFE_MSG_GetMsgId(&TlmMsgPtr->Msg, &TlmMsgId);
+
+              Source = RF_TLM_FindSource(TlmMsgId);
+
+              /* Every sample is kept as its source's latest for snapshots, before any filtering */
+              if (Source != NULL){
+                  Index = (uint16)(Source - RF_TLM_Data.Sources);
+                  RF_TLM_Snap_Keep(Index, TlmMsgPtr);
+                  if ((RF_TLM_Data.Snap.PullMask & (1u << Index)) && RF_TLM_Snap_Allowed(Index)){
+                      /* Sent on request only, unless since switched to fragments */
+                      ++RF_TLM_Data.Snap.Held;
+                      continue;
+                  }
+              }
+
+              /* Rate shaping: suppressed samples are never queued */
+              if (Source != NULL && Source->Weight == 0){
+                  /* Not forwarded under the active profile */
+                  ++RF_TLM_Data.ProfileDroppedCount;
+                  continue;
+              }
+
+              NowMsec = RF_TLM_GetMsec();
+
+              /* A summarized source takes every sample; rate shaping and deadband thin raw forwarding only */
+              if (Source != NULL && Source->Summary.WindowMsec != 0){
+                  RF_TLM_forward_summary(Source, TlmMsgPtr, NowMsec);
+                  continue;
+              }
+
+              /* Frames wait in the queue until the uC is ready and the send slot comes up */
+              Frame.MsgId = TlmMsgId;
+              CFE_MSG_GetMsgTime(&TlmMsgPtr->Msg, &Frame.SampleTime);
+              if (Frame.SampleTime.Seconds == 0 && Frame.SampleTime.Subseconds == 0){
+                  /* Source did not timestamp the packet */
+                  Frame.SampleTime = CFE_TIME_GetTime();
+              }
+
+              CFE_MSG_GetSize(&TlmMsgPtr->Msg, &MsgSize);
+#if RF_TLM_CFG_ENC_FRAGMENT
+              if (Source != NULL && Source->Encoding == RF_TLM_ENC_FRAGMENT){
+                  /* Whole messages have no deadband, only rate shaping thins them */
+                  if (RF_TLM_Rate_Admit(&Source->Rate, NowMsec)){
+                      RF_TLM_forward_fragments(Source, TlmMsgPtr, MsgSize, &Frame);
+                  }
+                  continue;
+              }
+#endif
+
+              /* Raw and packed frames read the fixed sample layout */
+              if (MsgSize < sizeof(SUBS_APP_OutData_t)){
+                  ++RF_TLM_Data.ShortMsgCount;
+                  continue;
+              }
+
+              /* Deadband, then rate shaping: unchanged or too frequent samples are dropped before encoding */
+              dataPtr = (SUBS_APP_OutData_t *)TlmMsgPtr;
+              if (Source != NULL && !RF_TLM_sample_admit(Source, dataPtr, NowMsec)){
+                  continue;
+              }
+
+              /* Update the private data */
+              RF_TLM_store_sample(dataPtr);
+
+              RF_TLM_encode_frame(&Frame, Source);
+              RF_TLM_Queue_Push((Source != NULL) ? &Source->Queue : &RF_TLM_Data.FrameQueue, &Frame);
+            }
+        }else if(CFE_SB_status == CFE_SB_NO_MESSAGE){
+          // The pipe is empty
+          break;
+        }else if(CFE_SB_status == CFE_SB_TIME_OUT){
+          CFE_EVS_SendEvent(RF_TLM_PIPE_ERR_EID, CFE_EVS_EventType_INFORMATION,
+                            "RF TLM: Message fails to arrive within the specified timeout period\n");
+          break;
+        }
+        // RF_TLM_Data_Init();
+    }while(CFE_SB_status == CFE_SUCCESS);
+
+    /* Windows of sources that went quiet are closed on time */
+    NowMsec = RF_TLM_GetMsec();
+    for (uint16 i = 0; i < RF_TLM_Data.SourceCount; i++){
+        Source = &RF_TLM_Data.Sources[i];
+        if (Source->Summary.WindowMsec != 0 && RF_TLM_Summary_Due(&Source->Summary, NowMsec)){
+            RF_TLM_summary_close(Source);
+        }
+    }
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_forward_summary() -- Take a sample into its source's     */
+/*                             summary window                      */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void RF_TLM_forward_summary(RF_TLM_Source_t *Source, const CFE_SB_Buffer_t *TlmMsgPtr, uint32 NowMsec){
+    const SUBS_APP_OutData_t *dataPtr = (const SUBS_APP_OutData_t *)TlmMsgPtr;
+    const uint8              *Groups[RF_TLM_RAW_FIELD_COUNT] = {dataPtr->byte_group_1, dataPtr->byte_group_2,
+                                                                dataPtr->byte_group_3, dataPtr->byte_group_4,
+                                                                dataPtr->byte_group_5, dataPtr->byte_group_6};
+    CFE_MSG_Size_t            MsgSize;
+    CFE_TIME_SysTime_t        SampleTime;
+
+    /* Fields are read from the fixed sample layout */
+    CFE_MSG_GetSize(&TlmMsgPtr->Msg, &MsgSize);
+    if (MsgSize < sizeof(SUBS_APP_OutData_t)){
+        ++RF_TLM_Data.ShortMsgCount;
+        return;
+    }
+
+    CFE_MSG_GetMsgTime(&TlmMsgPtr->Msg, &SampleTime);
+    if (SampleTime.Seconds == 0 && SampleTime.Subseconds == 0){
+        SampleTime = CFE_TIME_GetTime();
+    }
+
+    /* A sample past the end of the window starts the next one */
+    if (RF_TLM_Summary_Due(&Source->Summary, NowMsec)){
+        RF_TLM_summary_close(Source);
+    }
+
+    RF_TLM_Summary_Add(&Source->Summary, Source->Schema, Groups, NowMsec, SampleTime);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_summary_close() -- Queue one summary frame per field of  */
+/*                           the window and start the next one     */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void RF_TLM_summary_close(RF_TLM_Source_t *Source){
+    RF_TLM_Frame_t Frame;
+
+    Frame.MsgId      = Source->MsgId;
+    Frame.SampleTime = Source->Summary.LastTime;
+
+    for (uint8 f = 0; f < RF_TLM_RAW_FIELD_COUNT; f++){
+        if ((Source->Summary.FieldMask & (1u << f)) == 0){
+            continue;
+        }
+
+        Frame.Length = RF_TLM_Summary_BuildFrame(&Source->Summary, Source->SchemaId, f, Frame.Data);
+        RF_TLM_Queue_Push(&Source->Queue, &Frame);
+        ++RF_TLM_Data.SummaryFrames;
+    }
+
+    RF_TLM_Summary_Close(&Source->Summary);
+}
+
+#if RF_TLM_CFG_ENC_FRAGMENT
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_forward_fragments() -- Queue a whole message as fragment */
+/*                               frames                            */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void RF_TLM_forward_fragments(RF_TLM_Source_t *Source, const CFE_SB_Buffer_t *TlmMsgPtr, CFE_MSG_Size_t MsgSize,
+                              RF_TLM_Frame_t *Frame){
+    uint16 count;
+
+    /* All fragments must fit the queue together, or the first would be dropped for the last */
+    count = (MsgSize > RF_TLM_FRAG_MAX_MSG_BYTES) ? 0 : RF_TLM_Frame_FragCount((uint16)MsgSize);
+    if (count == 0 || count > Source->Queue.Limit){
+        ++RF_TLM_Data.FragOversize;
+        return;
+    }
+
+    /* Pushing into a full queue would drop the oldest frames, cutting up a message already queued */
+    if (count > Source->Queue.Limit - Source->Queue.Count){
+        ++RF_TLM_Data.FragQueueFull;
+        return;
+    }
+
+    for (uint16 i = 0; i < count; i++){
+        Frame->Length = RF_TLM_Frame_BuildFragment(Frame->Data, (const uint8 *)TlmMsgPtr, (uint16)MsgSize,
+                                                   RF_TLM_Data.FragMsgNum, (uint8)i);
+        RF_TLM_Queue_Push(&Source->Queue, Frame);
+    }
+
+    ++RF_TLM_Data.FragMsgNum;
+    ++RF_TLM_Data.FragMessages;
+    RF_TLM_Data.FragFrames += count;
+    RF_TLM_Data.FragBytes  += (uint32)MsgSize;
+}
+#endif
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_next_queue() -- Queue the next frame is sent from, NULL  */
+/*                        when every queue is empty                */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+RF_TLM_FrameQueue_t *RF_TLM_next_queue(void){
+    RF_TLM_Source_t *Source;
+
+    /* Events preempt everything else */
+    if (RF_TLM_Data.Evs.Queue.Count != 0){
+        return &RF_TLM_Data.Evs.Queue;
+    }
+
+    /* Snapshots the ground asked for, then frames not tied to a source, acknowledgements mostly */
+    if (RF_TLM_Data.Snap.Queue.Count != 0){
+        return &RF_TLM_Data.Snap.Queue;
+    }
+
+    if (RF_TLM_Data.FrameQueue.Count != 0){
+        return &RF_TLM_Data.FrameQueue;
+    }
+
+    if (RF_TLM_Data.SourceCount == 0){
+        return NULL;
+    }
+
+    /* Weighted round robin: each source sends up to Weight frames per round */
+    for (uint16 i = 0; i <= RF_TLM_Data.SourceCount; i++){
+        Source = &RF_TLM_Data.Sources[RF_TLM_Data.SchedSource];
+        if (Source->Queue.Count != 0 && RF_TLM_Data.SchedCredit != 0){
+            return &Source->Queue;
+        }
+
+        RF_TLM_Data.SchedSource = (uint16)((RF_TLM_Data.SchedSource + 1) % RF_TLM_Data.SourceCount);
+        Source = &RF_TLM_Data.Sources[RF_TLM_Data.SchedSource];
+
+        /* A source the profile dropped still drains what it had queued */
+        RF_TLM_Data.SchedCredit = (Source->Weight != 0) ? Source->Weight : 1;
+    }
+
+    return NULL;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_sample_admit() -- Run a packet through the deadband and  */
+/*                          the rate shaping of its source         */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+bool RF_TLM_sample_admit(RF_TLM_Source_t *Source, const SUBS_APP_OutData_t *dataPtr, uint32 NowMsec){
+    const uint8 *Groups[RF_TLM_RAW_FIELD_COUNT] = {dataPtr->byte_group_1, dataPtr->byte_group_2,
+                                                   dataPtr->byte_group_3, dataPtr->byte_group_4,
+                                                   dataPtr->byte_group_5, dataPtr->byte_group_6};
+    const uint8  Counters[2] = {dataPtr->CommandErrorCounter, dataPtr->CommandCounter};
+
+    /* Unchanged samples do not use up a decimation or interval slot, and only sent ones become the reference */
+    if (!RF_TLM_Deadband_Check(&Source->Deadband, Source->Schema, Counters, Groups, NowMsec) ||
+        !RF_TLM_Rate_Admit(&Source->Rate, NowMsec)){
+        return false;
+    }
+
+    RF_TLM_Deadband_Sent(&Source->Deadband, Source->Schema, Counters, Groups, NowMsec);
+
+    return true;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_store_sample() -- Copy a packet's fields to private data */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void RF_TLM_store_sample(const SUBS_APP_OutData_t *dataPtr){
+    RF_TLM_Data.AppID_H = dataPtr->AppID_H;
+    RF_TLM_Data.AppID_L = dataPtr->AppID_L;
+    RF_TLM_Data.Ext_CmdCounter = dataPtr->CommandCounter;
+    RF_TLM_Data.Ext_ErrCounter = dataPtr->CommandErrorCounter;
+    for(int i=0;i<4;i++){
+      RF_TLM_Data.byte_group_1[i] = dataPtr->byte_group_1[i];
+      RF_TLM_Data.byte_group_2[i] = dataPtr->byte_group_2[i];
+      RF_TLM_Data.byte_group_3[i] = dataPtr->byte_group_3[i];
+      RF_TLM_Data.byte_group_4[i] = dataPtr->byte_group_4[i];
+      RF_TLM_Data.byte_group_5[i] = dataPtr->byte_group_5[i];
+      RF_TLM_Data.byte_group_6[i] = dataPtr->byte_group_6[i];
+    }
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_send_queued() -- Send queued frames once the uC is ready */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void RF_TLM_send_queued(void){
+    int32                status;
+    uint32               now;
+    uint16               delta;
+    uint16               frames;
+    int16                fresh;
+    bool                 early;
+    RF_TLM_FrameQueue_t* Queue;
+    RF_TLM_Frame_t*      Frame;
+    RF_TLM_Frame_t       RefFrame;
+#if RF_TLM_CFG_DEBUG
+    uint8                Stage;
+#endif
+
+    if (!RF_TLM_Dev_IsReady() || (RF_TLM_Data.suppress_sendto == true) || (RF_TLM_Data.downlink_on == false)){
+        return;
+    }
+
+    /* Frames are held in their queues until the slot comes up and, with a contact table, a window is open */
+    if (!RF_TLM_Slot_Open() || !RF_TLM_Contact_Open()){
+        return;
+    }
+
+    /* Output held back from an earlier slot goes out as soon as the link allows, ahead of any new frame */
+    if (!RF_TLM_output_ready()){
+        return;
+    }
+
+    /* Paces the output at the profile's frames per send interval; events and snapshots go out between intervals */
+    now   = RF_TLM_GetMsec();
+    early = ((int32)(now - RF_TLM_Data.NextSendMsec) < 0);
+    if (early){
+        if (RF_TLM_Data.Evs.Queue.Count == 0 && RF_TLM_Data.Snap.Queue.Count == 0){
+            return;
+        }
+        frames = RF_TLM_EVENT_QUEUE_DEPTH + RF_TLM_SNAP_QUEUE_DEPTH;
+    }else{
+        RF_TLM_Data.NextSendMsec = now + RF_TLM_Contact_IntervalMsec();
+        frames = RF_TLM_Data.FramesPerCycle;
+    }
+
+    for (uint16 n = 0; n < frames; n++){
+        Queue = RF_TLM_next_queue();
+        if (Queue == NULL || (early && Queue != &RF_TLM_Data.Evs.Queue && Queue != &RF_TLM_Data.Snap.Queue) ||
+            (n > 0 && !RF_TLM_Slot_Open()) || !RF_TLM_output_ready()){
+            break;
+        }
+
+        /* Early in a contact window the newest frame of each source goes ahead of the backlog */
+        fresh = (Queue != &RF_TLM_Data.Evs.Queue && Queue != &RF_TLM_Data.Snap.Queue &&
+                 Queue != &RF_TLM_Data.FrameQueue)
+                    ? RF_TLM_Contact_FreshSource()
+                    : -1;
+        if (fresh >= 0){
+            Queue = &RF_TLM_Data.Sources[fresh].Queue;
+            Frame = RF_TLM_Queue_PeekNewest(Queue);
+        }else{
+            Frame = RF_TLM_Queue_Peek(Queue);
+        }
+
+        /* A time reference takes the slot when the sample time cannot be sent as a delta */
+        if (!RF_TLM_Seq_Delta(&RF_TLM_Data.Dest, Frame->SampleTime, &delta)){
+            RF_TLM_Seq_BuildTimeRef(&RF_TLM_Data.Dest, Frame->SampleTime, &RefFrame);
+            if (RF_TLM_transmit(&RefFrame, 0) < 0){
+                break;
+            }
+            continue;
+        }
+
+        RF_TLM_Seq_Stamp(&RF_TLM_Data.Dest, Frame, delta);
+
+        status = RF_TLM_transmit(Frame, (Queue == &RF_TLM_Data.Snap.Queue) ? RF_TLM_SENT_SNAP : 0);
+
+#if RF_TLM_CFG_DEBUG
+        if(RF_TLM_Data.tlm_debug){
+          Stage = RF_TLM_Cpu_Enter(RF_TLM_STAGE_EVENT);
+          switch (CFE_SB_MsgIdToValue(Frame->MsgId)){
+
+            case IMU_APP_RF_DATA_MID:
+              CFE_EVS_SendEvent(RF_TLM_INVALID_MSGID_ERR_EID, CFE_EVS_EventType_INFORMATION,
+                                "RF TLM - Enviando IMU app con status %d",(int)status);
+              break;
+
+            case BLINKY_RF_DATA_MID:
+              CFE_EVS_SendEvent(RF_TLM_INVALID_MSGID_ERR_EID, CFE_EVS_EventType_INFORMATION,
+                                "RF TLM - Enviando Blinky app con status %d",(int)status);
+              break;
+
+            case ALTITUDE_APP_RF_DATA_MID:
+              CFE_EVS_SendEvent(RF_TLM_INVALID_MSGID_ERR_EID, CFE_EVS_EventType_INFORMATION,
+                                "RF TLM - Enviando Altitud app con status %d",(int)status);
+              break;
+
+            case TEMP_APP_RF_DATA_MID:
+              CFE_EVS_SendEvent(RF_TLM_INVALID_MSGID_ERR_EID, CFE_EVS_EventType_INFORMATION,
+                                "RF TLM - Enviando Temp app con status %d",(int)status);
+              break;
+
+            default:
+              CFE_EVS_SendEvent(RF_TLM_INVALID_MSGID_ERR_EID, CFE_EVS_EventType_ERROR,
+                                "RF TLM - Recvd invalid TLM msgId (0x%08X)", (unsigned int)CFE_SB_MsgIdToValue(Frame->MsgId));
+              break;
+          }
+          RF_TLM_Cpu_Enter(Stage);
+        }
+#endif
+
+        /* A failed frame is dropped so it cannot wedge the queue */
+        if (fresh >= 0){
+            RF_TLM_Queue_PopNewest(Queue);
+            RF_TLM_Data.Contact.FreshMask &= (uint8)~(1u << fresh);
+        }else{
+            RF_TLM_Queue_Pop(Queue);
+            if (Queue != &RF_TLM_Data.FrameQueue && Queue != &RF_TLM_Data.Evs.Queue &&
+                Queue != &RF_TLM_Data.Snap.Queue && RF_TLM_Data.SchedCredit > 0){
+                --RF_TLM_Data.SchedCredit;
+            }
+        }
+
+        if (status < 0){
+            break;
+        }
+    }
+
+    /* The cycle's block is flushed, frames do not wait for the next cycle; pieces past the slot wait for the next */
+    if (RF_TLM_Data.Lz.Mode == RF_TLM_COMPRESS_LZSS && RF_TLM_Dev_IsReady() && RF_TLM_Slot_Open()){
+        RF_TLM_Lz_Flush();
+    }
+
+    /* A part-filled transfer frame is completed with idle data, packets do not wait for the next cycle */
+    if (RF_TLM_Data.Ccsds.Mode == RF_TLM_FRAMING_CCSDS && RF_TLM_Dev_IsReady() && RF_TLM_Slot_Open()){
+        RF_TLM_Ccsds_Flush();
+    }
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_output_ready() -- Whether another frame can be taken,    */
+/*                          after writing the output held back     */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+bool RF_TLM_output_ready(void){
+    if (RF_TLM_Data.Ccsds.Mode == RF_TLM_FRAMING_CCSDS && !RF_TLM_Ccsds_Drain()){
+        return false;
+    }
+
+    if (RF_TLM_Data.Lz.Mode == RF_TLM_COMPRESS_LZSS && !RF_TLM_Lz_Drain()){
+        return false;
+    }
+
+    return RF_TLM_Data.SentCount < RF_TLM_SENT_DEPTH;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_transmit() -- Hand one frame to the uC and update the    */
+/*                      link state                                 */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+int32 RF_TLM_transmit(RF_TLM_Frame_t *Frame, uint8 Flags){
+    RF_TLM_Source_t *Source;
+    RF_TLM_Sent_t   *Sent;
+    uint32           token;
+    int32            status;
+
+    /* Taken first, a framed packet can be written before the put returns */
+    Sent             = &RF_TLM_Data.Sent[(RF_TLM_Data.SentHead + RF_TLM_Data.SentCount) % RF_TLM_SENT_DEPTH];
+    Sent->SampleTime = Frame->SampleTime;
+    Sent->Flags      = (uint8)(Flags | ((Frame->Data[0] == RF_TLM_FRAME_EVENT) ? RF_TLM_SENT_EVENT : 0));
+    ++RF_TLM_Data.SentCount;
+    token = ++RF_TLM_Data.SentToken;
+
+    if (RF_TLM_Data.Lz.Mode == RF_TLM_COMPRESS_LZSS){
+        status = RF_TLM_Lz_Put(Frame, token);
+    }else if (RF_TLM_Data.Ccsds.Mode == RF_TLM_FRAMING_CCSDS){
+        /* Time references, acknowledgements and events go out on the link stream */
+        Source = (Frame->Data[0] == RF_TLM_FRAME_TIMEREF || Frame->Data[0] == RF_TLM_FRAME_ACK ||
+                  Frame->Data[0] == RF_TLM_FRAME_EVENT)
+                     ? NULL
+                     : RF_TLM_FindSource(Frame->MsgId);
+        status = RF_TLM_Ccsds_Put(Frame,
+                                  (Source != NULL) ? (uint16)(Source - RF_TLM_Data.Sources) : RF_TLM_CCSDS_LINK_STREAM,
+                                  token);
+    }else{
+        status = RF_TLM_write_frame(Frame);
+        if (status >= 0){
+            RF_TLM_frames_written(token);
+        }
+    }
+
+    if (status < 0){
+        --RF_TLM_Data.SentCount;
+        --RF_TLM_Data.SentToken;
+        return status;
+    }
+
+    /* Numbered in stream order when taken: later frames are stamped after it, and held output is not dropped */
+    RF_TLM_Seq_Accepted(&RF_TLM_Data.Dest, Frame);
+
+    return status;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_frames_written() -- Account the frames taken up to Token */
+/*                            as sent                              */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void RF_TLM_frames_written(uint32 Token){
+    RF_TLM_Sent_t *Sent;
+
+    while (RF_TLM_Data.SentCount != 0 && (int32)(RF_TLM_Data.SentToken - RF_TLM_Data.SentCount + 1 - Token) <= 0){
+        Sent = &RF_TLM_Data.Sent[RF_TLM_Data.SentHead];
+        RF_TLM_Data.SentHead = (uint16)((RF_TLM_Data.SentHead + 1) % RF_TLM_SENT_DEPTH);
+        --RF_TLM_Data.SentCount;
+
+        RF_TLM_Dev_FrameSent();
+        RF_TLM_Contact_Sent();
+        if (Sent->Flags & RF_TLM_SENT_EVENT){
+            RF_TLM_Evs_Sent(Sent->SampleTime);
+        }
+        if (Sent->Flags & RF_TLM_SENT_SNAP){
+            RF_TLM_Snap_Sent();
+        }
+    }
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_frames_lost() -- Forget the frames taken up to Token,    */
+/*                         their output was dropped                */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void RF_TLM_frames_lost(uint32 Token){
+    while (RF_TLM_Data.SentCount != 0 && (int32)(RF_TLM_Data.SentToken - RF_TLM_Data.SentCount + 1 - Token) <= 0){
+        RF_TLM_Data.SentHead = (uint16)((RF_TLM_Data.SentHead + 1) % RF_TLM_SENT_DEPTH);
+        --RF_TLM_Data.SentCount;
+    }
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_write_frame() -- Write one frame to the uC, marking it   */
+/*                         lost on failure                         */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+int32 RF_TLM_write_frame(RF_TLM_Frame_t *Frame){
+    int32  status;
+    uint64 start;
+
+    RF_TLM_PERF_MARK_ENTRY(RF_TLM_I2C_SEND_PERF_ID);
+
+    start  = uC_monotonic_ns();
+    status = send_tlm_data(Frame);
+    RF_TLM_Slot_Released(uC_monotonic_ns() - start);
+
+    RF_TLM_PERF_MARK_EXIT(RF_TLM_I2C_SEND_PERF_ID);
+
+    if (status < 0){
+        CFE_EVS_SendEvent(RF_TLM_TLMOUTSTOP_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "RF TLM: RF send tlm error. Tlm output held until the uC is ready\n");
+        RF_TLM_Dev_Lost();
+    }
+
+    return status;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_FindSource() -- Look up a forwarded source by MID        */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+RF_TLM_Source_t *RF_TLM_FindSource(CFE_SB_MsgId_t MsgId){
+#if RF_TLM_CFG_FIXED_SOURCES
+    /* The source set is fixed, the index of a MID is known at compile time */
+    switch (CFE_SB_MsgIdToValue(MsgId)){
+#define RF_TLM_SOURCE_CASE(Tag, Mid, Name) \
+    case Mid:                              \
+        return (RF_TLM_SOURCE_##Tag < RF_TLM_Data.SourceCount) ? &RF_TLM_Data.Sources[RF_TLM_SOURCE_##Tag] : NULL;
+        RF_TLM_SOURCE_LIST(RF_TLM_SOURCE_CASE)
+#undef RF_TLM_SOURCE_CASE
+      default:
+        return NULL;
+    }
+#else
+    for (uint16 i = 0; i < RF_TLM_Data.SourceCount; i++){
+        if (CFE_SB_MsgId_Equal(RF_TLM_Data.Sources[i].MsgId, MsgId)){
+            return &RF_TLM_Data.Sources[i];
+        }
+    }
+
+    return NULL;
+#endif
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_GetMsec() -- Monotonic time in milliseconds, wraps       */
+/*                                                                 */
+/* Read from the same clock as uC_monotonic_ns(), so millisecond   */
+/* and nanosecond timestamps of the app can be mixed.              */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+uint32 RF_TLM_GetMsec(void){
+    return (uint32)(uC_monotonic_ns() / 1000000u);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_encode_frame() -- Build the RF frame from private data   */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void RF_TLM_encode_frame(RF_TLM_Frame_t *Frame, const RF_TLM_Source_t *Source){
+  uint8  *val = Frame->Data;
+#if RF_TLM_CFG_ENC_PACKED
+  uint8   raw[RF_TLM_RAW_FRAME_BYTES];
+  uint16  body_bytes;
+#endif
+
+  val[0] = RF_TLM_Data.AppID_H;
+  val[1] = RF_TLM_Data.AppID_L;
+  val[2] = RF_TLM_Data.Ext_ErrCounter;
+  val[3] = RF_TLM_Data.Ext_CmdCounter;
+  val[RF_TLM_RAW_SEQ_OFFSET] = 0;
+  val[RF_TLM_RAW_SEQ_OFFSET + 1] = 0;
+
+  for(int i=0;i<4;i++){
+    val[i+6] = RF_TLM_Data.byte_group_1[i];
     val[i+10] = RF_TLM_Data.byte_group_2[i];
     val[i+14] = RF_TLM_Data.byte_group_3[i];
     val[i+18] = RF_TLM_Data.byte_group_4[i];
@@ -695,9 +2056,49 @@ int32 send_tlm_data(){
     val[i+26] = RF_TLM_Data.byte_group_6[i];
   }
 
+  /* Sequence and time delta are stamped when the frame is sent */
+  val[RF_TLM_RAW_DT_OFFSET] = 0;
+  val[RF_TLM_RAW_DT_OFFSET + 1] = 0;
+
+  Frame->Length = RF_TLM_RAW_FRAME_BYTES;
+
+  /* Packed frames replace the raw layout; a schema too wide to fit keeps it */
+#if RF_TLM_CFG_ENC_PACKED
+  if (Source != NULL && Source->Encoding == RF_TLM_ENC_PACKED && Source->Schema != NULL){
+    memcpy(raw, val, sizeof(raw));
+
+    body_bytes = RF_TLM_Pack_Encode(Source->Schema, raw, &val[RF_TLM_PACKED_BITS_OFFSET],
+                                    RF_TLM_MAX_FRAME_BYTES - RF_TLM_PACKED_BITS_OFFSET);
+    if (body_bytes != 0){
+      val[0] = RF_TLM_FRAME_PACKED;
+      val[RF_TLM_PACKED_SCHEMA_OFFSET] = Source->SchemaId;
+      Frame->Length = RF_TLM_PACKED_BITS_OFFSET + body_bytes;
+
+      ++RF_TLM_Data.PackedFrameCount;
+      RF_TLM_Data.PackedBytesSaved += RF_TLM_RAW_FRAME_BYTES - Frame->Length;
+    }
+  }
+#endif
+}
+
+int32 send_tlm_data(RF_TLM_Frame_t *Frame){
+  int rv;
+
+  uint8_t *val = Frame->Data;
+
+#if RF_TLM_CFG_DEBUG
+  uint8    Stage;
+
+  if(RF_TLM_Data.tlm_debug){
+    Stage = RF_TLM_Cpu_Enter(RF_TLM_STAGE_EVENT);
+    CFE_EVS_SendEvent(RF_TLM_TLMOUTSTOP_ERR_EID, CFE_EVS_EventType_ERROR,
+                      "RF TLM: Sending packet from [AppID]: 0x%x%x",val[0], val[1]);
+    RF_TLM_Cpu_Enter(Stage);
+  }
+#endif
 
   // Send the telemetry payload
-  rv = uC_set_bytes(UC_ADDRESS, &val, RF_PAYLOAD_BYTES);
+  rv = uC_set_bytes(UC_ADDRESS, &val, Frame->Length);
   if(rv == 1 || rv < 0){
     ++RF_TLM_Data.PcktErrCounter;
     return -1;    // Couldn't open bus or ioctl failed
@@ -706,31 +2107,3 @@ int32 send_tlm_data(){
     return 0;     // Succeded
   }
 }
-
-int32 genuC_driver_open(){
-
-int rv;
-int fd;
-
-// Device registration
-rv = i2c_dev_register_uC(
-  &bus_path[0],
-  &genuC_path[0]
-);
-if(rv == 0)
-  CFE_EVS_SendEvent(RF_TLM_DEV_INF_EID, CFE_EVS_EventType_INFORMATION, "RF: Device registered correctly at %s",
-                    genuC_path);
-
-fd = open(&genuC_path[0], O_RDWR);
-if(fd >= 0)
-  CFE_EVS_SendEvent(RF_TLM_DEV_INF_EID, CFE_EVS_EventType_INFORMATION, "RF: Device opened correctly at %s",
-                    genuC_path);
-close(fd);
-
-if(rv == 0 && fd >=0){
-  return CFE_SUCCESS;
-}else{
-  return -1;
-}
-
-}
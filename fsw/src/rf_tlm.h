@@ -33,10 +33,30 @@
 #include "cfe_evs.h"
 #include "cfe_sb.h"
 #include "cfe_es.h"
+#include "cfe_psp.h"
 
 #include "rf_tlm_perfids.h"
 #include "rf_tlm_msgids.h"
+#include "rf_tlm_platform_cfg.h"
 #include "rf_tlm_msg.h"
+#include "rf_tlm_rate.h"
+#include "rf_tlm_queue.h"
+#include "rf_tlm_seq.h"
+#include "rf_tlm_dev.h"
+#include "rf_tlm_uplink.h"
+#include "rf_tlm_pack.h"
+#include "rf_tlm_deadband.h"
+#include "rf_tlm_profile.h"
+#include "rf_tlm_cpu.h"
+#include "rf_tlm_slot.h"
+#include "rf_tlm_linktest.h"
+#include "rf_tlm_ccsds.h"
+#include "rf_tlm_summary.h"
+#include "rf_tlm_evs.h"
+#include "rf_tlm_cds.h"
+#include "rf_tlm_lz.h"
+#include "rf_tlm_contact.h"
+#include "rf_tlm_snap.h"
 
 /*
 ** Includes of the apps that send telemetry
@@ -58,12 +78,63 @@
 ** Include and constants for I2C
 */
 #include "gen-uC.h"
-
-static const char bus_path[] = "/dev/i2c-2";
-static const char genuC_path[] = "/dev/i2c-2.genuC-0";
 /***********************************************************************/
 #define RF_TLM_TASK_MSEC 500 /* run at 2 Hz */
 
+#define RF_TLM_FRAMES_PER_CYCLE   1  /* Frames sent each RF_TLM_TASK_MSEC by the default profile */
+#define RF_TLM_FRAME_QUEUE_DEPTH  32 /* Acknowledgements and other frames not tied to a source */
+#define RF_TLM_SOURCE_QUEUE_DEPTH 16 /* Frames held per source while the uC is not ready */
+#define RF_TLM_SENT_DEPTH         64 /* Frames taken into buffered output and not written yet: two compressed blocks */
+
+/*
+** Deadline of every I2C transfer. The first transfer to miss it marks the
+** uC lost and the rest of the cycle skips the bus, so a hung bus delays one
+** run loop iteration by at most this plus one bus recovery, a few dozen
+** bus clocks.
+*/
+#define RF_TLM_I2C_DEADLINE_MSEC 25
+
+/*
+** Priority of the gen-uC worker task. It has to run ahead of the app's main
+** task to take a transfer up within its deadline.
+*/
+#define RF_TLM_I2C_WORKER_PRIORITY 60
+
+/*
+** Share of the core, in permille, the run loop may keep busy before an
+** event is raised. Shares are measured over RF_TLM_CPU_WINDOW_MSEC.
+*/
+#define RF_TLM_CPU_BUDGET_PERMILLE 100
+
+/*
+** Optional performance markers, see RF_TLM_CFG_PERF_MARKERS
+*/
+#if RF_TLM_CFG_PERF_MARKERS
+#define RF_TLM_PERF_MARK_ENTRY(Id) CFE_ES_PerfLogEntry(Id)
+#define RF_TLM_PERF_MARK_EXIT(Id)  CFE_ES_PerfLogExit(Id)
+#else
+#define RF_TLM_PERF_MARK_ENTRY(Id) ((void)0)
+#define RF_TLM_PERF_MARK_EXIT(Id)  ((void)0)
+#endif
+
+/*
+** Whether an encoding is built into this profile
+*/
+#define RF_TLM_ENC_BUILT(Enc)                                           \
+    ((Enc) == RF_TLM_ENC_RAW ||                                         \
+     ((Enc) == RF_TLM_ENC_PACKED && RF_TLM_CFG_ENC_PACKED) ||           \
+     ((Enc) == RF_TLM_ENC_FRAGMENT && RF_TLM_CFG_ENC_FRAGMENT))
+
+/*
+** Index of each forwarded source in RF_TLM_Data.Sources
+*/
+#define RF_TLM_SOURCE_INDEX(Tag, MsgId, Name) RF_TLM_SOURCE_##Tag,
+enum
+{
+    RF_TLM_SOURCE_LIST(RF_TLM_SOURCE_INDEX) RF_TLM_SOURCE_COUNT
+};
+#undef RF_TLM_SOURCE_INDEX
+
 #define RF_TLM_UNUSED    CFE_SB_MSGID_RESERVED
 
 #define RF_TLM_PIPE_DEPTH 32 /* Depth of the Command Pipe for Application */
@@ -77,7 +148,21 @@ static const char genuC_path[] = "/dev/i2c-2.genuC-0";
 *************************************************************************/
 
 
-#define RF_PAYLOAD_BYTES 30
+/*
+** Forwarded telemetry source
+*/
+typedef struct
+{
+    CFE_SB_MsgId_t         MsgId;    /**< \brief Subscribed message ID */
+    RF_TLM_RateState_t     Rate;     /**< \brief Decimation and minimum interval */
+    uint8                  Encoding; /**< \brief One of RF_TLM_ENC_* */
+    uint8                  SchemaId; /**< \brief Index of Schema in RF_TLM_Schemas */
+    const RF_TLM_Schema_t *Schema;   /**< \brief Declared field widths, NULL if none */
+    RF_TLM_Deadband_t      Deadband; /**< \brief Per-field change thresholds */
+    RF_TLM_Summary_t       Summary;  /**< \brief Windowed statistics, in place of raw samples */
+    RF_TLM_FrameQueue_t    Queue;    /**< \brief Frames waiting for a send slot */
+    uint8                  Weight;   /**< \brief Frames per scheduling round, 0 when not forwarded */
+} RF_TLM_Source_t;
 
 /*
 ** Global Data
@@ -114,6 +199,107 @@ typedef struct
     int PcktCounter;
     int PcktErrCounter;
 
+    /*
+    ** Forwarded sources, in subscription order
+    */
+    RF_TLM_Source_t Sources[RF_TLM_MAX_SOURCES];
+    uint16          SourceCount;
+    RF_TLM_Frame_t  SourceStore[RF_TLM_MAX_SOURCES][RF_TLM_SOURCE_QUEUE_DEPTH];
+
+    /*
+    ** Active link profile and the weighted round robin over source queues
+    */
+    uint8  ProfileId;
+    uint32 ProfileSwitches;
+    uint32 ProfileDroppedCount; /**< \brief Samples of sources the profile does not forward */
+    uint32 SendIntervalMsec;
+    uint16 FramesPerCycle;
+    uint16 SchedSource;         /**< \brief Source being served */
+    uint16 SchedCredit;         /**< \brief Frames it may still send this round */
+
+    /*
+    ** RF microcontroller state and outgoing frames
+    */
+    RF_TLM_Dev_t        Dev;
+    RF_TLM_FrameQueue_t FrameQueue;
+    RF_TLM_Frame_t      FrameStore[RF_TLM_FRAME_QUEUE_DEPTH];
+    uint32              NextSendMsec;
+    RF_TLM_Dest_t       Dest;
+    RF_TLM_Uplink_t     Uplink;
+
+    uint32 PackedFrameCount;
+    uint32 PackedBytesSaved;
+
+    /*
+    ** Fragmented forwarding
+    */
+    uint8  FragMsgNum; /**< \brief Number of the next fragmented message */
+    uint32 FragMessages;
+    uint32 FragFrames;
+    uint32 FragBytes;
+    uint32 FragOversize;
+    uint32 FragQueueFull;
+    uint32 ShortMsgCount;
+
+    /*
+    ** Summarized forwarding
+    */
+    uint32 SummaryFrames;
+
+    /*
+    ** Event fast lane
+    */
+    RF_TLM_Evs_t Evs;
+
+    /*
+    ** Latest sample per source and on-demand snapshots
+    */
+    RF_TLM_Snap_t Snap;
+
+    /*
+    ** Time accounting per run loop stage
+    */
+    RF_TLM_Cpu_t Cpu;
+
+    /*
+    ** Transmit slot schedule
+    */
+    RF_TLM_Slot_t Slot;
+
+    /*
+    ** Ground contact schedule
+    */
+    RF_TLM_Contact_t Contact;
+
+    /*
+    ** Link throughput test
+    */
+    RF_TLM_LinkTest_t LinkTest;
+
+    /*
+    ** Frames taken into buffered output and not written yet, oldest first.
+    ** Tokens number the frames taken, the newest has SentToken.
+    */
+    RF_TLM_Sent_t Sent[RF_TLM_SENT_DEPTH];
+    uint16        SentHead;
+    uint16        SentCount;
+    uint32        SentToken;
+
+    /*
+    ** CCSDS packet and transfer frame output
+    */
+    RF_TLM_Ccsds_t Ccsds;
+
+    /*
+    ** Downlink compression
+    */
+    RF_TLM_Lz_t Lz;
+
+    /*
+    ** Link state checkpoint for warm restarts
+    */
+    RF_TLM_Cds_t Cds;
+
     /*
     ** Run Status variable used in the main processing loop
     */
@@ -125,6 +311,7 @@ typedef struct
     */
     CFE_SB_PipeId_t CommandPipe;
     CFE_SB_PipeId_t TlmPipe;
+    CFE_SB_PipeId_t EventPipe;
 
     /*
     ** Initialization data (not reported in housekeeping)...
@@ -136,6 +323,8 @@ typedef struct
 
 } RF_TLM_Data_t;
 
+extern RF_TLM_Data_t RF_TLM_Data;
+
 /****************************************************************************/
 /*
 ** Local function prototypes.
@@ -154,12 +343,43 @@ int32 RF_TLM_EnableOutput(const RF_TLM_EnableOutputCmd_t *data);
 int32 RF_TLM_DisableOutput(const RF_TLM_DisableOutputCmd_t *data);
 int32 RF_TLM_Enable_Debug(const RF_TLM_EnableDebugCmd_t *Msg);
 int32 RF_TLM_Disable_Debug(const RF_TLM_DisableDebugCmd_t *Msg);
+int32 RF_TLM_SetRate(const RF_TLM_SetRateCmd_t *Msg);
+int32 RF_TLM_SetEncoding(const RF_TLM_SetEncodingCmd_t *Msg);
+int32 RF_TLM_SetDeadband(const RF_TLM_SetDeadbandCmd_t *Msg);
+int32 RF_TLM_SetProfile(const RF_TLM_SetProfileCmd_t *Msg);
+int32 RF_TLM_SetCpuBudget(const RF_TLM_SetCpuBudgetCmd_t *Msg);
+int32 RF_TLM_SetSlots(const RF_TLM_SetSlotsCmd_t *Msg);
+int32 RF_TLM_LinkTest(const RF_TLM_LinkTestCmd_t *Msg);
+int32 RF_TLM_SetFraming(const RF_TLM_SetFramingCmd_t *Msg);
+int32 RF_TLM_SetSummary(const RF_TLM_SetSummaryCmd_t *Msg);
+int32 RF_TLM_SetEventFilter(const RF_TLM_SetEventFilterCmd_t *Msg);
+int32 RF_TLM_SetCompress(const RF_TLM_SetCompressCmd_t *Msg);
+int32 RF_TLM_SetContacts(const RF_TLM_SetContactsCmd_t *Msg);
+int32 RF_TLM_Snapshot(const RF_TLM_SnapshotCmd_t *Msg);
 
 void  RF_TLM_Data_Init(void);
-void  RF_TLM_openTLM(void);
+void  RF_TLM_forward_events(void);
 void  RF_TLM_forward_telemetry(void);
-int32 genuC_driver_open(void);
-int32 send_tlm_data(void);
+RF_TLM_FrameQueue_t *RF_TLM_next_queue(void);
+#if RF_TLM_CFG_ENC_FRAGMENT
+void  RF_TLM_forward_fragments(RF_TLM_Source_t *Source, const CFE_SB_Buffer_t *TlmMsgPtr, CFE_MSG_Size_t MsgSize,
+                               RF_TLM_Frame_t *Frame);
+#endif
+void  RF_TLM_forward_summary(RF_TLM_Source_t *Source, const CFE_SB_Buffer_t *TlmMsgPtr, uint32 NowMsec);
+void  RF_TLM_summary_close(RF_TLM_Source_t *Source);
+bool  RF_TLM_sample_admit(RF_TLM_Source_t *Source, const SUBS_APP_OutData_t *dataPtr, uint32 NowMsec);
+void  RF_TLM_store_sample(const SUBS_APP_OutData_t *dataPtr);
+void  RF_TLM_encode_frame(RF_TLM_Frame_t *Frame, const RF_TLM_Source_t *Source);
+void  RF_TLM_send_queued(void);
+bool  RF_TLM_output_ready(void);
+int32 RF_TLM_transmit(RF_TLM_Frame_t *Frame, uint8 Flags);
+int32 RF_TLM_write_frame(RF_TLM_Frame_t *Frame);
+void  RF_TLM_frames_written(uint32 Token);
+void  RF_TLM_frames_lost(uint32 Token);
+int32 send_tlm_data(RF_TLM_Frame_t *Frame);
+
+RF_TLM_Source_t *RF_TLM_FindSource(CFE_SB_MsgId_t MsgId);
+uint32           RF_TLM_GetMsec(void);
 
 bool RF_TLM_VerifyCmdLength(CFE_MSG_Message_t *MsgPtr, size_t ExpectedLength);
 
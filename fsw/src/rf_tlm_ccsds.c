@@ -0,0 +1,293 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * \file
+ *   CCSDS space packet and TM transfer frame output of the RF Telemetry
+ *   Output App.
+ *
+ *   In the CCSDS framing mode every frame handed to RF_TLM_transmit() is
+ *   wrapped in a space packet and the packets are laid end to end in
+ *   fixed-length transfer frames on one virtual channel, so time references
+ *   stay ahead of the frames that refer to them. Layout in rf_tlm_frame.h.
+ *
+ *   The identification words of the channel's frames and of each stream's
+ *   packets are computed when the channel is configured; per frame only the
+ *   counters, the first header pointer and the CRC are filled in.
+ *
+ *   A frame is written as soon as its data field is full. RF_TLM_send_queued()
+ *   completes a part-filled frame with an idle packet at the end of each send
+ *   cycle, so packets do not wait for later traffic.
+ *
+ *   A frame that cannot be written, because the slot closed or the write
+ *   failed, is kept with its counters and CRC and written again before
+ *   anything else; no packet is put in while frames are held back. The
+ *   frames taken into packets are accounted as sent once the frame holding
+ *   their last byte is written (RF_TLM_frames_written()).
+ */
+
+#include <string.h>
+
+#include "rf_tlm_events.h"
+#include "rf_tlm.h"
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_Ccsds_Close() -- Finish the frame being filled and write */
+/*                         it, with any held before it             */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static void RF_TLM_Ccsds_Close(void)
+{
+    RF_TLM_Ccsds_t *Ccsds = &RF_TLM_Data.Ccsds;
+    RF_TLM_Frame_t *Tm    = &Ccsds->Tm[(Ccsds->Head + Ccsds->Held) % RF_TLM_CCSDS_TM_DEPTH];
+    uint8          *tm    = Tm->Data;
+
+    RF_TLM_Frame_PutU16(tm, Ccsds->FrameId);
+    tm[RF_TLM_TM_MCCOUNT_OFFSET] = Ccsds->MasterCount++;
+    tm[RF_TLM_TM_VCCOUNT_OFFSET] = Ccsds->VcCount[Ccsds->Vcid]++;
+    RF_TLM_Frame_PutU16(&tm[RF_TLM_TM_DFS_OFFSET], RF_TLM_TM_DFS_STATIC | Ccsds->FirstHeader);
+    RF_TLM_Frame_PutU16(&tm[RF_TLM_TM_FRAME_BYTES - RF_TLM_TM_FECF_BYTES],
+                        RF_TLM_Frame_Crc16(tm, RF_TLM_TM_FRAME_BYTES - RF_TLM_TM_FECF_BYTES));
+    Tm->Length = RF_TLM_TM_FRAME_BYTES;
+
+    ++Ccsds->Held;
+    Ccsds->Fill        = 0;
+    Ccsds->FirstHeader = RF_TLM_TM_FHP_NONE;
+
+    RF_TLM_Ccsds_Drain();
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_Ccsds_Append() -- Add packet bytes to the stream,        */
+/*                          closing every frame they fill          */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static void RF_TLM_Ccsds_Append(const uint8 *Data, uint16 Len, bool Header)
+{
+    RF_TLM_Ccsds_t *Ccsds = &RF_TLM_Data.Ccsds;
+    RF_TLM_Frame_t *Tm;
+    uint16          n;
+
+    if (Header && Ccsds->FirstHeader == RF_TLM_TM_FHP_NONE)
+    {
+        Ccsds->FirstHeader = Ccsds->Fill;
+    }
+
+    while (Len > 0)
+    {
+        n = RF_TLM_TM_DATA_BYTES - Ccsds->Fill;
+        if (n > Len)
+        {
+            n = Len;
+        }
+
+        Tm = &Ccsds->Tm[(Ccsds->Head + Ccsds->Held) % RF_TLM_CCSDS_TM_DEPTH];
+        memcpy(&Tm->Data[RF_TLM_TM_HDR_BYTES + Ccsds->Fill], Data, n);
+        Ccsds->Fill += n;
+        Data += n;
+        Len -= n;
+
+        if (Ccsds->Fill == RF_TLM_TM_DATA_BYTES)
+        {
+            RF_TLM_Ccsds_Close();
+        }
+    }
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_Ccsds_Init() -- Startup framing mode and channel, after  */
+/*                        the sources are subscribed               */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void RF_TLM_Ccsds_Init(void)
+{
+    memset(&RF_TLM_Data.Ccsds, 0, sizeof(RF_TLM_Data.Ccsds));
+    RF_TLM_Data.Ccsds.FirstHeader = RF_TLM_TM_FHP_NONE;
+
+    RF_TLM_Ccsds_Configure(RF_TLM_FRAMING_DEFAULT, RF_TLM_CCSDS_SCID, RF_TLM_CCSDS_VCID);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_Ccsds_Configure() -- Set the framing mode and channel,   */
+/*                             returns the data bytes of frames    */
+/*                             that could not be written           */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+uint16 RF_TLM_Ccsds_Configure(uint8 Mode, uint16 Scid, uint8 Vcid)
+{
+    RF_TLM_Ccsds_t *Ccsds   = &RF_TLM_Data.Ccsds;
+    uint16          dropped = 0;
+    uint32          token   = 0;
+    uint16          apid;
+
+    /* Held frames and the one being filled belong to the old channel: finish them there or drop them */
+    if ((Ccsds->Fill != 0 || Ccsds->Held != 0) && RF_TLM_Dev_IsReady() && RF_TLM_Slot_Open())
+    {
+        RF_TLM_Ccsds_Flush();
+    }
+    if (Ccsds->Fill != 0 || Ccsds->Held != 0)
+    {
+        dropped = (uint16)(Ccsds->Held * RF_TLM_TM_DATA_BYTES + Ccsds->Fill);
+        for (uint16 i = 0; i < RF_TLM_CCSDS_TM_DEPTH; i++)
+        {
+            token             = (Ccsds->TmToken[i] > token) ? Ccsds->TmToken[i] : token;
+            Ccsds->TmToken[i] = 0;
+        }
+        Ccsds->Head        = 0;
+        Ccsds->Held        = 0;
+        Ccsds->Fill        = 0;
+        Ccsds->FirstHeader = RF_TLM_TM_FHP_NONE;
+        RF_TLM_frames_lost(token);
+    }
+
+    Ccsds->Mode    = Mode;
+    Ccsds->Scid    = Scid;
+    Ccsds->Vcid    = Vcid;
+    Ccsds->FrameId = RF_TLM_TM_FRAME_ID(Scid, Vcid);
+
+    for (uint16 i = 0; i < RF_TLM_CCSDS_STREAMS; i++)
+    {
+        apid = (i < RF_TLM_Data.SourceCount) ? (uint16)CFE_SB_MsgIdToValue(RF_TLM_Data.Sources[i].MsgId)
+                                             : RF_TLM_CCSDS_LINK_APID;
+        Ccsds->PacketId[i] = apid & RF_TLM_SP_APID_MASK;
+    }
+
+    return dropped;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_Ccsds_Put() -- Send a frame as a packet of a stream,     */
+/*                       Token is accounted once its last byte is  */
+/*                       written                                   */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+int32 RF_TLM_Ccsds_Put(const RF_TLM_Frame_t *Frame, uint16 Stream, uint32 Token)
+{
+    RF_TLM_Ccsds_t *Ccsds = &RF_TLM_Data.Ccsds;
+    uint8           hdr[RF_TLM_SP_HDR_BYTES];
+    uint16          len   = (uint16)(RF_TLM_SP_HDR_BYTES + Frame->Length);
+
+    /* Every frame the packet closes must fit behind those still held */
+    if (Ccsds->Held + (Ccsds->Fill + len) / RF_TLM_TM_DATA_BYTES >= RF_TLM_CCSDS_TM_DEPTH)
+    {
+        return RF_TLM_CCSDS_HELD;
+    }
+
+    if (Token != 0)
+    {
+        Ccsds->TmToken[(Ccsds->Head + Ccsds->Held + (Ccsds->Fill + len - 1) / RF_TLM_TM_DATA_BYTES) %
+                       RF_TLM_CCSDS_TM_DEPTH] = Token;
+    }
+
+    RF_TLM_Frame_PutU16(hdr, Ccsds->PacketId[Stream]);
+    RF_TLM_Frame_PutU16(&hdr[RF_TLM_SP_SEQ_OFFSET], RF_TLM_SP_SEQ_UNSEGMENTED | Ccsds->PacketCount[Stream]);
+    RF_TLM_Frame_PutU16(&hdr[RF_TLM_SP_LEN_OFFSET], (uint16)(Frame->Length - 1));
+    Ccsds->PacketCount[Stream] = (Ccsds->PacketCount[Stream] + 1) & RF_TLM_SP_SEQ_MASK;
+
+    RF_TLM_Ccsds_Append(hdr, sizeof(hdr), true);
+    RF_TLM_Ccsds_Append(Frame->Data, Frame->Length, false);
+    ++Ccsds->Packets;
+
+    return 0;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_Ccsds_Flush() -- Complete a part-filled frame with an    */
+/*                         idle packet and write it                */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+int32 RF_TLM_Ccsds_Flush(void)
+{
+    RF_TLM_Ccsds_t *Ccsds = &RF_TLM_Data.Ccsds;
+    uint8           hdr[RF_TLM_SP_HDR_BYTES];
+    uint8           fill[RF_TLM_TM_DATA_BYTES];
+    uint16          idle;
+    uint16          n;
+
+    if (!RF_TLM_Ccsds_Drain())
+    {
+        return RF_TLM_CCSDS_HELD;
+    }
+
+    if (Ccsds->Fill == 0)
+    {
+        return 0;
+    }
+
+    /* Too little room for the smallest idle packet: it runs on and fills the next frame as well */
+    idle = RF_TLM_TM_DATA_BYTES - Ccsds->Fill;
+    if (idle < RF_TLM_SP_MIN_BYTES)
+    {
+        idle += RF_TLM_TM_DATA_BYTES;
+    }
+
+    RF_TLM_Frame_PutU16(hdr, RF_TLM_SP_IDLE_APID);
+    RF_TLM_Frame_PutU16(&hdr[RF_TLM_SP_SEQ_OFFSET], RF_TLM_SP_SEQ_UNSEGMENTED);
+    RF_TLM_Frame_PutU16(&hdr[RF_TLM_SP_LEN_OFFSET], (uint16)(idle - RF_TLM_SP_HDR_BYTES - 1));
+    Ccsds->IdleBytes += idle;
+    memset(fill, RF_TLM_SP_IDLE_FILL, sizeof(fill));
+
+    RF_TLM_Ccsds_Append(hdr, sizeof(hdr), true);
+    for (idle -= RF_TLM_SP_HDR_BYTES; idle > 0; idle -= n)
+    {
+        n = (idle < sizeof(fill)) ? idle : sizeof(fill);
+        RF_TLM_Ccsds_Append(fill, n, false);
+    }
+
+    return (Ccsds->Held == 0) ? 0 : RF_TLM_CCSDS_HELD;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_Ccsds_Drain() -- Write the closed frames held back,      */
+/*                         true once none is left                  */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+bool RF_TLM_Ccsds_Drain(void)
+{
+    RF_TLM_Ccsds_t *Ccsds = &RF_TLM_Data.Ccsds;
+    uint32          token;
+
+    /* Each frame gets its own slot check, a frame is never started in the guard time */
+    while (Ccsds->Held != 0)
+    {
+        if (!RF_TLM_Dev_IsReady() || !RF_TLM_Slot_Open() || RF_TLM_write_frame(&Ccsds->Tm[Ccsds->Head]) < 0)
+        {
+            return false;
+        }
+
+        ++Ccsds->Frames;
+        token                       = Ccsds->TmToken[Ccsds->Head];
+        Ccsds->TmToken[Ccsds->Head] = 0;
+        Ccsds->Head                 = (uint16)((Ccsds->Head + 1) % RF_TLM_CCSDS_TM_DEPTH);
+        --Ccsds->Held;
+
+        if (token != 0)
+        {
+            RF_TLM_frames_written(token);
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,79 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ * CCSDS space packet and TM transfer frame output of the RF Telemetry Output App
+ */
+
+#ifndef RF_TLM_CCSDS_H
+#define RF_TLM_CCSDS_H
+
+#include "cfe.h"
+
+#include "rf_tlm_frame.h"
+#include "rf_tlm_msg.h"
+#include "rf_tlm_queue.h"
+
+/*
+** Packet streams: one per source, in RF_TLM_Data.Sources order, then the
+** link stream for time references and acknowledgements
+*/
+#define RF_TLM_CCSDS_LINK_STREAM RF_TLM_MAX_SOURCES
+#define RF_TLM_CCSDS_STREAMS     (RF_TLM_MAX_SOURCES + 1)
+
+/*
+** Transfer frames kept: the one being filled and the two a packet or the
+** idle fill can close while the frames before them cannot be written
+*/
+#define RF_TLM_CCSDS_TM_DEPTH 3
+
+/*
+** Put and flush status while closed frames hold back the output
+*/
+#define RF_TLM_CCSDS_HELD (-1)
+
+typedef struct
+{
+    uint8          Mode;                                /**< \brief RF_TLM_FRAMING_* */
+    uint8          Vcid;                                /**< \brief Virtual channel of the frames */
+    uint16         Scid;                                /**< \brief Spacecraft ID */
+    uint16         FrameId;                             /**< \brief Bytes 0..1 of the channel's frames */
+    uint8          MasterCount;                         /**< \brief Master channel frame count */
+    uint8          VcCount[RF_TLM_TM_VCID_MAX + 1];     /**< \brief Frame count of each virtual channel */
+    uint16         PacketId[RF_TLM_CCSDS_STREAMS];      /**< \brief Bytes 0..1 of each stream's packets */
+    uint16         PacketCount[RF_TLM_CCSDS_STREAMS];   /**< \brief Sequence count of each stream */
+    RF_TLM_Frame_t Tm[RF_TLM_CCSDS_TM_DEPTH];           /**< \brief Closed frames from Head, then the one being filled */
+    uint32         TmToken[RF_TLM_CCSDS_TM_DEPTH];      /**< \brief Newest frame taken that ends in each, 0 if none */
+    uint16         Head;                                /**< \brief Oldest closed frame not written */
+    uint16         Held;                                /**< \brief Closed frames not written */
+    uint16         Fill;                                /**< \brief Data field bytes in the frame being filled */
+    uint16         FirstHeader;                         /**< \brief First header pointer of the frame being filled */
+    uint32         Frames;                              /**< \brief Transfer frames written */
+    uint32         Packets;                             /**< \brief Packets framed, idle ones aside */
+    uint32         IdleBytes;                           /**< \brief Idle packet bytes written */
+} RF_TLM_Ccsds_t;
+
+void   RF_TLM_Ccsds_Init(void);
+uint16 RF_TLM_Ccsds_Configure(uint8 Mode, uint16 Scid, uint8 Vcid);
+int32  RF_TLM_Ccsds_Put(const RF_TLM_Frame_t *Frame, uint16 Stream, uint32 Token);
+int32  RF_TLM_Ccsds_Flush(void);
+bool   RF_TLM_Ccsds_Drain(void);
+
+#endif /* RF_TLM_CCSDS_H */
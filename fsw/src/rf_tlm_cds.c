@@ -0,0 +1,360 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * \file
+ *   Critical Data Store checkpoint of the link state of the RF Telemetry
+ *   Output App.
+ *
+ *   The frame sequence and time reference state, the uplink duplicate
+ *   check, the CCSDS channel and counters, the compression mode and block
+ *   number, the contact table, the active profile, the packet counters and up to
+ *   RF_TLM_CDS_BACKLOG_FRAMES unsent frames are copied
+ *   into one fixed-size CDS block. When ES restarts the app, or the
+ *   processor resets without losing the CDS, the block is found again at
+ *   startup and the link resumes where it stood: queued frames go out first
+ *   and the sequence continues past the guard.
+ *
+ *   A checkpoint is one copy of the whole block, so its cost does not grow
+ *   with the queues. It is written from the run loop after the send, at
+ *   most once per RF_TLM_CDS_PERIOD_MSEC and only when the link state
+ *   moved, and its time is reported in housekeeping.
+ *
+ *   A block written by another layout or for another source list is not
+ *   used, the app then starts cold and overwrites it.
+ */
+
+#include <string.h>
+
+#include "rf_tlm_events.h"
+#include "rf_tlm.h"
+
+#define RF_TLM_CDS_MAGIC   0x5246434Bu /* "RFCK" */
+#define RF_TLM_CDS_VERSION 3
+
+/*
+** Queue of a backlog frame: a source index, or one of these
+*/
+#define RF_TLM_CDS_QUEUE_SHARED 0xFE
+#define RF_TLM_CDS_QUEUE_EVENT  0xFF
+
+typedef struct
+{
+    uint8          Queue;
+    uint8          Spare[3];
+    RF_TLM_Frame_t Frame;
+} RF_TLM_CdsFrame_t;
+
+/*
+** The CDS block
+*/
+typedef struct
+{
+    uint32                Magic;
+    uint16                Version;
+    uint16                Size;
+    uint32                Generation;
+    RF_TLM_Dest_t         Dest;
+    uint32                PcktCounter;
+    uint32                PcktErrCounter;
+    uint8                 ProfileId;
+    uint8                 UplinkHaveSeq;
+    uint8                 UplinkLastSeq;
+    uint8                 FragMsgNum;
+    uint8                 FramingMode;
+    uint8                 FramingVcid;
+    uint16                FramingScid;
+    uint8                 MasterCount;
+    uint8                 VcCount[RF_TLM_TM_VCID_MAX + 1];
+    uint16                PacketCount[RF_TLM_CCSDS_STREAMS];
+    uint8                 CompressMode;
+    uint8                 CompressBlock;
+    RF_TLM_ContactTable_t Contacts;
+    uint16                SourceCount;
+    uint16                BacklogCount;
+    RF_TLM_CdsFrame_t     Backlog[RF_TLM_CDS_BACKLOG_FRAMES];
+} RF_TLM_CdsImage_t;
+
+static RF_TLM_CdsImage_t RF_TLM_CdsImage;
+
+/*
+** Summary of the link state, a checkpoint is due when it changes
+*/
+static uint32 RF_TLM_Cds_Mark(void)
+{
+    uint32 mark;
+
+    mark = ((uint32)RF_TLM_Data.Dest.Seq << 16) ^ RF_TLM_Data.Dest.TimeRefCount;
+    mark = mark * 31u + RF_TLM_Data.FrameQueue.Count + RF_TLM_Data.FrameQueue.DroppedCount;
+    mark = mark * 31u + RF_TLM_Data.Evs.Queue.Count + RF_TLM_Data.Evs.Queue.DroppedCount;
+    for (uint16 i = 0; i < RF_TLM_Data.SourceCount; i++)
+    {
+        mark = mark * 31u + RF_TLM_Data.Sources[i].Queue.Count + RF_TLM_Data.Sources[i].Queue.DroppedCount;
+    }
+    mark = mark * 31u + RF_TLM_Data.Uplink.LastSeq;
+    mark = mark * 31u + RF_TLM_Data.ProfileId;
+    mark = mark * 31u + RF_TLM_Data.Ccsds.Mode + ((uint32)RF_TLM_Data.Ccsds.MasterCount << 8);
+    mark = mark * 31u + RF_TLM_Data.Lz.Mode + ((uint32)RF_TLM_Data.Lz.Block << 8);
+    mark = mark * 31u + RF_TLM_Data.Contact.Count + RF_TLM_Data.Contact.Table.Windows[0].StartSec;
+
+    return mark;
+}
+
+/*
+** Add the Newest-th newest frame of a queue to the backlog, returns false
+** when the queue has no such frame or the backlog is full
+*/
+static bool RF_TLM_Cds_Take(RF_TLM_CdsImage_t *Image, const RF_TLM_FrameQueue_t *Queue, uint8 QueueId,
+                            uint16 Newest)
+{
+    RF_TLM_CdsFrame_t *Entry;
+
+    if (Newest >= Queue->Count || Image->BacklogCount >= RF_TLM_CDS_BACKLOG_FRAMES)
+    {
+        return false;
+    }
+
+    Entry        = &Image->Backlog[Image->BacklogCount++];
+    Entry->Queue = QueueId;
+    Entry->Frame = Queue->Frames[(Queue->Head + Queue->Count - 1u - Newest) % Queue->Depth];
+
+    return true;
+}
+
+/*
+** Copy the link state into the image. Every queue is taken newest first.
+*/
+static void RF_TLM_Cds_Build(RF_TLM_CdsImage_t *Image)
+{
+    bool taken;
+
+    Image->Magic          = RF_TLM_CDS_MAGIC;
+    Image->Version        = RF_TLM_CDS_VERSION;
+    Image->Size           = (uint16)sizeof(*Image);
+    Image->Generation     = RF_TLM_Data.Cds.Checkpoints + 1;
+    Image->Dest           = RF_TLM_Data.Dest;
+    Image->PcktCounter    = (uint32)RF_TLM_Data.PcktCounter;
+    Image->PcktErrCounter = (uint32)RF_TLM_Data.PcktErrCounter;
+    Image->ProfileId      = RF_TLM_Data.ProfileId;
+    Image->UplinkHaveSeq  = RF_TLM_Data.Uplink.HaveSeq;
+    Image->UplinkLastSeq  = RF_TLM_Data.Uplink.LastSeq;
+    Image->FragMsgNum     = RF_TLM_Data.FragMsgNum;
+    Image->FramingMode    = RF_TLM_Data.Ccsds.Mode;
+    Image->FramingVcid    = RF_TLM_Data.Ccsds.Vcid;
+    Image->FramingScid    = RF_TLM_Data.Ccsds.Scid;
+    Image->MasterCount    = RF_TLM_Data.Ccsds.MasterCount;
+    memcpy(Image->VcCount, RF_TLM_Data.Ccsds.VcCount, sizeof(Image->VcCount));
+    memcpy(Image->PacketCount, RF_TLM_Data.Ccsds.PacketCount, sizeof(Image->PacketCount));
+    Image->CompressMode  = RF_TLM_Data.Lz.Mode;
+    Image->CompressBlock = RF_TLM_Data.Lz.Block;
+    Image->Contacts      = RF_TLM_Data.Contact.Table;
+    Image->SourceCount   = RF_TLM_Data.SourceCount;
+
+    Image->BacklogCount = 0;
+    for (uint16 k = 0; RF_TLM_Cds_Take(Image, &RF_TLM_Data.Evs.Queue, RF_TLM_CDS_QUEUE_EVENT, k); k++)
+    {
+    }
+    for (uint16 k = 0; RF_TLM_Cds_Take(Image, &RF_TLM_Data.FrameQueue, RF_TLM_CDS_QUEUE_SHARED, k); k++)
+    {
+    }
+    taken = true;
+    for (uint16 k = 0; taken && Image->BacklogCount < RF_TLM_CDS_BACKLOG_FRAMES; k++)
+    {
+        taken = false;
+        for (uint16 i = 0; i < RF_TLM_Data.SourceCount; i++)
+        {
+            taken |= RF_TLM_Cds_Take(Image, &RF_TLM_Data.Sources[i].Queue, (uint8)i, k);
+        }
+    }
+}
+
+/*
+** Put the link state of a checkpoint back, returns false when the image
+** does not belong to this build
+*/
+static bool RF_TLM_Cds_Apply(const RF_TLM_CdsImage_t *Image)
+{
+    const RF_TLM_CdsFrame_t *Entry;
+    RF_TLM_FrameQueue_t     *Queue;
+    uint16                   Addr;
+
+    if (Image->Magic != RF_TLM_CDS_MAGIC || Image->Version != RF_TLM_CDS_VERSION ||
+        Image->Size != sizeof(*Image) || Image->SourceCount != RF_TLM_Data.SourceCount ||
+        Image->BacklogCount > RF_TLM_CDS_BACKLOG_FRAMES || Image->ProfileId >= RF_TLM_ProfileCount ||
+        Image->FramingMode > RF_TLM_FRAMING_CCSDS || Image->FramingScid > RF_TLM_TM_SCID_MAX ||
+        Image->FramingVcid > RF_TLM_TM_VCID_MAX || Image->CompressMode > RF_TLM_COMPRESS_LZSS)
+    {
+        return false;
+    }
+
+    if (Image->ProfileId != RF_TLM_Data.ProfileId)
+    {
+        RF_TLM_Profile_Apply(Image->ProfileId);
+    }
+    RF_TLM_Ccsds_Configure(Image->FramingMode, Image->FramingScid, Image->FramingVcid);
+    RF_TLM_Data.Ccsds.MasterCount = Image->MasterCount;
+    memcpy(RF_TLM_Data.Ccsds.VcCount, Image->VcCount, sizeof(Image->VcCount));
+    memcpy(RF_TLM_Data.Ccsds.PacketCount, Image->PacketCount, sizeof(Image->PacketCount));
+    RF_TLM_Lz_Configure(Image->CompressMode);
+    RF_TLM_Data.Lz.Block = Image->CompressBlock;
+    RF_TLM_Contact_Load(&Image->Contacts);
+
+    /* Frames sent after the checkpoint are unknown, skip their sequence numbers */
+    Addr                          = RF_TLM_Data.Dest.Addr;
+    RF_TLM_Data.Dest              = Image->Dest;
+    RF_TLM_Data.Dest.Addr         = Addr;
+    RF_TLM_Data.Dest.Seq          = (uint16)(Image->Dest.Seq + RF_TLM_CDS_SEQ_GUARD);
+    RF_TLM_Data.Uplink.HaveSeq    = (Image->UplinkHaveSeq != 0);
+    RF_TLM_Data.Uplink.LastSeq    = Image->UplinkLastSeq;
+    RF_TLM_Data.FragMsgNum        = Image->FragMsgNum;
+    RF_TLM_Data.PcktCounter       = (int)Image->PcktCounter;
+    RF_TLM_Data.PcktErrCounter    = (int)Image->PcktErrCounter;
+
+    /* Oldest first, as they were queued */
+    RF_TLM_Data.Cds.Restored = 0;
+    for (uint16 n = Image->BacklogCount; n > 0; n--)
+    {
+        Entry = &Image->Backlog[n - 1];
+        if (Entry->Queue == RF_TLM_CDS_QUEUE_EVENT)
+        {
+            Queue = &RF_TLM_Data.Evs.Queue;
+        }
+        else if (Entry->Queue == RF_TLM_CDS_QUEUE_SHARED)
+        {
+            Queue = &RF_TLM_Data.FrameQueue;
+        }
+        else if (Entry->Queue < RF_TLM_Data.SourceCount)
+        {
+            Queue = &RF_TLM_Data.Sources[Entry->Queue].Queue;
+        }
+        else
+        {
+            continue;
+        }
+
+        if (Entry->Frame.Length != 0 && Entry->Frame.Length <= RF_TLM_MAX_FRAME_BYTES)
+        {
+            RF_TLM_Queue_Push(Queue, &Entry->Frame);
+            ++RF_TLM_Data.Cds.Restored;
+        }
+    }
+
+    return true;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_Cds_Init() -- Register the CDS block and resume from the */
+/*                      last checkpoint if one survived            */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void RF_TLM_Cds_Init(void)
+{
+    RF_TLM_Cds_t *Cds = &RF_TLM_Data.Cds;
+    int32         status;
+
+    memset(Cds, 0, sizeof(*Cds));
+
+    status = CFE_ES_RegisterCDS(&Cds->Handle, sizeof(RF_TLM_CdsImage), RF_TLM_CDS_NAME);
+    if (status != CFE_SUCCESS && status != CFE_ES_CDS_ALREADY_EXISTS)
+    {
+        Cds->State = RF_TLM_CDS_NONE;
+        CFE_EVS_SendEvent(RF_TLM_CDS_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "RF TLM: no Critical Data Store, link state is not kept, RC = 0x%08lX",
+                          (unsigned long)status);
+        return;
+    }
+
+    Cds->State = RF_TLM_CDS_COLD;
+
+    if (status == CFE_ES_CDS_ALREADY_EXISTS)
+    {
+        status = CFE_ES_RestoreFromCDS(&RF_TLM_CdsImage, Cds->Handle);
+        if (status == CFE_SUCCESS && RF_TLM_Cds_Apply(&RF_TLM_CdsImage))
+        {
+            Cds->State       = RF_TLM_CDS_RESTORED;
+            Cds->Checkpoints = RF_TLM_CdsImage.Generation;
+            CFE_EVS_SendEvent(RF_TLM_CDS_INF_EID, CFE_EVS_EventType_INFORMATION,
+                              "RF TLM: link state restored from checkpoint %lu, seq %u, %u frames requeued",
+                              (unsigned long)RF_TLM_CdsImage.Generation, (unsigned int)RF_TLM_Data.Dest.Seq,
+                              (unsigned int)Cds->Restored);
+        }
+        else
+        {
+            CFE_EVS_SendEvent(RF_TLM_CDS_ERR_EID, CFE_EVS_EventType_ERROR,
+                              "RF TLM: checkpoint not usable, starting cold, RC = 0x%08lX", (unsigned long)status);
+        }
+    }
+
+    /* The restored state is written back as the first checkpoint */
+    Cds->Mark     = ~RF_TLM_Cds_Mark();
+    Cds->NextMsec = RF_TLM_GetMsec();
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_Cds_Step() -- Write a checkpoint if one is due           */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void RF_TLM_Cds_Step(void)
+{
+    RF_TLM_Cds_t *Cds = &RF_TLM_Data.Cds;
+    uint64        start;
+    uint32        now;
+    uint32        mark;
+    uint32        usec;
+
+    if (Cds->State == RF_TLM_CDS_NONE)
+    {
+        return;
+    }
+
+    now = RF_TLM_GetMsec();
+    if ((int32)(now - Cds->NextMsec) < 0)
+    {
+        return;
+    }
+
+    mark = RF_TLM_Cds_Mark();
+    if (mark == Cds->Mark)
+    {
+        return;
+    }
+
+    start = uC_monotonic_ns();
+
+    RF_TLM_Cds_Build(&RF_TLM_CdsImage);
+    if (CFE_ES_CopyToCDS(Cds->Handle, &RF_TLM_CdsImage) == CFE_SUCCESS)
+    {
+        ++Cds->Checkpoints;
+        Cds->Mark    = mark;
+        Cds->Backlog = (uint8)RF_TLM_CdsImage.BacklogCount;
+    }
+    else
+    {
+        ++Cds->Errors;
+    }
+
+    usec = (uint32)((uC_monotonic_ns() - start) / 1000u);
+    Cds->LastUsec = (usec > UINT16_MAX) ? UINT16_MAX : (uint16)usec;
+    if (Cds->LastUsec > Cds->MaxUsec)
+    {
+        Cds->MaxUsec = Cds->LastUsec;
+    }
+    Cds->NextMsec = now + RF_TLM_CDS_PERIOD_MSEC;
+}
@@ -0,0 +1,77 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ * Critical Data Store checkpoint of the link state of the RF Telemetry
+ * Output App
+ */
+
+#ifndef RF_TLM_CDS_H
+#define RF_TLM_CDS_H
+
+#include "cfe.h"
+
+#include "rf_tlm_queue.h"
+
+/*
+** Name of the app's block in the Critical Data Store
+*/
+#define RF_TLM_CDS_NAME "RF_TLM_LINK"
+
+/*
+** Unsent frames kept across a restart: events, then acknowledgements,
+** then the newest frames of each source in turn
+*/
+#define RF_TLM_CDS_BACKLOG_FRAMES 16
+
+/*
+** A checkpoint is written at most this often, and only when the link
+** state moved. Frames sent after the last checkpoint are not in it, so a
+** restored link skips RF_TLM_CDS_SEQ_GUARD sequence numbers, more than the
+** fastest profile sends in one period, rather than reuse any.
+*/
+#define RF_TLM_CDS_PERIOD_MSEC 250
+#define RF_TLM_CDS_SEQ_GUARD   32
+
+/*
+** Checkpoint states, reported in housekeeping
+*/
+#define RF_TLM_CDS_NONE     0 /* No Critical Data Store, nothing is kept */
+#define RF_TLM_CDS_COLD     1 /* Started with a new or unusable block */
+#define RF_TLM_CDS_RESTORED 2 /* Started from the checkpoint of the last run */
+
+typedef struct
+{
+    CFE_ES_CDSHandle_t Handle;
+    uint8              State;         /**< \brief One of RF_TLM_CDS_* */
+    uint8              Backlog;       /**< \brief Frames in the last checkpoint */
+    uint16             Restored;      /**< \brief Frames requeued from the checkpoint at startup */
+    uint32             NextMsec;      /**< \brief Earliest time of the next checkpoint */
+    uint32             Mark;          /**< \brief Link state at the last checkpoint */
+    uint32             Checkpoints;   /**< \brief Checkpoints written */
+    uint32             Errors;        /**< \brief Checkpoints the CDS refused */
+    uint16             LastUsec;      /**< \brief Time to build and write the last checkpoint */
+    uint16             MaxUsec;       /**< \brief Longest checkpoint */
+} RF_TLM_Cds_t;
+
+void RF_TLM_Cds_Init(void);
+void RF_TLM_Cds_Step(void);
+
+#endif /* RF_TLM_CDS_H */
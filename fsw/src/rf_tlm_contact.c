@@ -0,0 +1,438 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * \file
+ *   Ground contact schedule of the RF Telemetry Output App.
+ *
+ *   The contact table lists the windows, in CFE time, in which a ground
+ *   station is expected to hear the downlink. Between windows nothing is
+ *   sent: frames stay in their queues, which keep the newest ones when they
+ *   fill, and with a summary window set every source with a schema that is
+ *   forwarded raw is summarized instead, so a long wait is carried by a few
+ *   summary frames. Sources the ground put on summaries itself are left as
+ *   they are.
+ *
+ *   When a window opens the summaries in progress are closed and queued,
+ *   the sources go back to raw forwarding, and the newest frame of every
+ *   source goes out first, so the ground sees the present state at once.
+ *   The backlog follows, oldest first, at the table's send interval.
+ *
+ *   A window's utilization is the frames sent in it over the frames the
+ *   time spent in it could carry at that interval, and the frames still
+ *   queued when it closes are carried over to the next one.
+ *
+ *   Windows follow CFE time, the run loop wakes on their starts and ends
+ *   through RF_TLM_Contact_WaitMsec(). An empty table, the startup one,
+ *   sends whenever the link is up.
+ */
+
+#include <string.h>
+
+#include "rf_tlm_events.h"
+#include "rf_tlm.h"
+
+/*
+** Table loaded at startup: no windows, the downlink is always on
+*/
+static const RF_TLM_ContactTable_t RF_TLM_ContactDefaults = {
+    .IntervalMsec = 0,
+};
+
+/*
+** CFE time in milliseconds, the clock the windows are set in
+*/
+static uint64 RF_TLM_Contact_NowMsec(void)
+{
+    CFE_TIME_SysTime_t now = CFE_TIME_GetTime();
+
+    return (uint64)now.Seconds * 1000u + CFE_TIME_Sub2MicroSecs(now.Subseconds) / 1000u;
+}
+
+/*
+** Place a time in the table. Returns true inside a window, with Until its
+** end; outside, Until is the next window start, or 0 with none ahead.
+*/
+static bool RF_TLM_Contact_Locate(uint64 NowMsec, uint64 *Until)
+{
+    const RF_TLM_ContactTable_t *Table = &RF_TLM_Data.Contact.Table;
+    uint64                       start;
+    uint64                       end;
+
+    for (uint8 w = 0; w < RF_TLM_Data.Contact.Count; w++)
+    {
+        start = (uint64)Table->Windows[w].StartSec * 1000u;
+        end   = start + (uint64)Table->Windows[w].LengthSec * 1000u;
+        if (NowMsec < start)
+        {
+            *Until = start;
+            return false;
+        }
+        if (NowMsec < end)
+        {
+            *Until = end;
+            return true;
+        }
+    }
+
+    *Until = 0;
+
+    return false;
+}
+
+/*
+** Frames waiting in all queues, and their bytes
+*/
+static uint16 RF_TLM_Contact_Queued(uint32 *Bytes)
+{
+    const RF_TLM_FrameQueue_t *Queues[RF_TLM_MAX_SOURCES + 3];
+    const RF_TLM_FrameQueue_t *Queue;
+    uint16                     n     = 0;
+    uint32                     count = 0;
+
+    Queues[n++] = &RF_TLM_Data.Evs.Queue;
+    Queues[n++] = &RF_TLM_Data.Snap.Queue;
+    Queues[n++] = &RF_TLM_Data.FrameQueue;
+    for (uint16 i = 0; i < RF_TLM_Data.SourceCount; i++)
+    {
+        Queues[n++] = &RF_TLM_Data.Sources[i].Queue;
+    }
+
+    *Bytes = 0;
+    for (uint16 q = 0; q < n; q++)
+    {
+        Queue = Queues[q];
+        count += Queue->Count;
+        for (uint16 k = 0; k < Queue->Count; k++)
+        {
+            *Bytes += Queue->Frames[(Queue->Head + k) % Queue->Depth].Length;
+        }
+    }
+
+    return (count > 0xFFFF) ? 0xFFFF : (uint16)count;
+}
+
+/*
+** Put the raw sources on summaries for the wait between windows, or take
+** back the ones that were
+*/
+static void RF_TLM_Contact_Summarize(bool Wait)
+{
+    RF_TLM_Contact_t *Contact = &RF_TLM_Data.Contact;
+    RF_TLM_Source_t  *Source;
+    uint8             bit;
+    uint8             used;
+
+    for (uint16 i = 0; i < RF_TLM_Data.SourceCount; i++)
+    {
+        Source = &RF_TLM_Data.Sources[i];
+        bit    = (uint8)(1u << i);
+
+        if (Wait)
+        {
+            /* Sources on pull send nothing between requests, there is nothing to summarize */
+            if (Contact->Table.SummaryMsec == 0 || Source->Schema == NULL || Source->Summary.WindowMsec != 0 ||
+                (RF_TLM_Data.Snap.PullMask & bit) != 0)
+            {
+                continue;
+            }
+
+            used = 0;
+            for (uint8 f = 0; f < RF_TLM_RAW_FIELD_COUNT; f++)
+            {
+                if (Source->Schema->Fields[f].Kind != RF_TLM_FIELD_UNUSED)
+                {
+                    used |= (uint8)(1u << f);
+                }
+            }
+            if (used != 0)
+            {
+                RF_TLM_Summary_Configure(&Source->Summary, Contact->Table.SummaryMsec, used);
+                Contact->AutoSummary |= bit;
+            }
+        }
+        else if (Contact->AutoSummary & bit)
+        {
+            if (Source->Summary.Count != 0)
+            {
+                RF_TLM_summary_close(Source);
+            }
+            RF_TLM_Summary_Configure(&Source->Summary, 0, 0);
+            Contact->AutoSummary &= (uint8)~bit;
+        }
+    }
+}
+
+/*
+** Enter a window: the newest frame of every source goes first
+*/
+static void RF_TLM_Contact_Enter(uint64 NowMsec)
+{
+    RF_TLM_Contact_t *Contact = &RF_TLM_Data.Contact;
+    uint32            bytes;
+
+    ++Contact->Windows;
+    Contact->OpenMsec     = NowMsec;
+    Contact->WindowFrames = 0;
+    Contact->Backlog      = RF_TLM_Contact_Queued(&bytes);
+
+    Contact->FreshMask = 0;
+    for (uint16 i = 0; i < RF_TLM_Data.SourceCount; i++)
+    {
+        if (RF_TLM_Data.Sources[i].Queue.Count != 0)
+        {
+            Contact->FreshMask |= (uint8)(1u << i);
+        }
+    }
+
+    /* The first cycle does not wait out an interval started before the window */
+    RF_TLM_Data.NextSendMsec = RF_TLM_GetMsec();
+
+    CFE_EVS_SendEvent(RF_TLM_CONTACT_INF_EID, CFE_EVS_EventType_INFORMATION,
+                      "RF TLM: Contact window open, %u frames (%lu bytes) queued", (unsigned int)Contact->Backlog,
+                      (unsigned long)bytes);
+}
+
+/*
+** Leave a window and account for it
+*/
+static void RF_TLM_Contact_Leave(uint64 NowMsec)
+{
+    RF_TLM_Contact_t *Contact  = &RF_TLM_Data.Contact;
+    uint32            interval = RF_TLM_Contact_IntervalMsec();
+    uint64            capacity;
+    uint64            util;
+
+    capacity = (interval == 0) ? 0 : (NowMsec - Contact->OpenMsec) / interval * RF_TLM_Data.FramesPerCycle;
+    util     = (capacity == 0) ? 1000 : (uint64)Contact->WindowFrames * 1000u / capacity;
+    Contact->UtilPermille = (util > 1000) ? 1000 : (uint16)util;
+    Contact->Carried      = RF_TLM_Contact_Queued(&Contact->CarriedBytes);
+    Contact->FreshMask    = 0;
+
+    CFE_EVS_SendEvent(RF_TLM_CONTACT_INF_EID, CFE_EVS_EventType_INFORMATION,
+                      "RF TLM: Contact window closed, %lu frames sent, utilization %u/1000, %u frames carried over",
+                      (unsigned long)Contact->WindowFrames, (unsigned int)Contact->UtilPermille,
+                      (unsigned int)Contact->Carried);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_Contact_Init() -- Load the startup contact table         */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void RF_TLM_Contact_Init(void)
+{
+    memset(&RF_TLM_Data.Contact, 0, sizeof(RF_TLM_Data.Contact));
+
+    RF_TLM_Contact_Load(&RF_TLM_ContactDefaults);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_Contact_Load() -- Check and activate a contact table,    */
+/*                          false leaves the active one in place   */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+bool RF_TLM_Contact_Load(const RF_TLM_ContactTable_t *Table)
+{
+    RF_TLM_Contact_t *Contact = &RF_TLM_Data.Contact;
+    uint64            end     = 0;
+    uint8             n;
+
+    for (n = 0; n < RF_TLM_MAX_CONTACTS && Table->Windows[n].LengthSec != 0; n++)
+    {
+        /* Windows are in order and do not overlap */
+        if (Table->Windows[n].StartSec < end)
+        {
+            return false;
+        }
+        end = (uint64)Table->Windows[n].StartSec + Table->Windows[n].LengthSec;
+    }
+
+    if (Table->SummaryMsec > RF_TLM_SUMMARY_MAX_WINDOW_MSEC)
+    {
+        return false;
+    }
+
+    /* Summaries are set up again for the new table on the next step */
+    if (Contact->State == RF_TLM_CONTACT_WAIT)
+    {
+        RF_TLM_Contact_Summarize(false);
+        Contact->State = RF_TLM_CONTACT_FREE;
+    }
+
+    Contact->Table = *Table;
+    Contact->Count = n;
+
+    return true;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_Contact_Step() -- Follow the table, entering and leaving */
+/*                          windows                                */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void RF_TLM_Contact_Step(void)
+{
+    RF_TLM_Contact_t *Contact = &RF_TLM_Data.Contact;
+    uint64            now     = RF_TLM_Contact_NowMsec();
+    uint64            until;
+    uint8             state;
+
+    if (Contact->Count == 0)
+    {
+        state = RF_TLM_CONTACT_FREE;
+    }
+    else
+    {
+        state = RF_TLM_Contact_Locate(now, &until) ? RF_TLM_CONTACT_OPEN : RF_TLM_CONTACT_WAIT;
+    }
+
+    if (state == Contact->State)
+    {
+        return;
+    }
+
+    if (Contact->State == RF_TLM_CONTACT_OPEN)
+    {
+        RF_TLM_Contact_Leave(now);
+    }
+    RF_TLM_Contact_Summarize(state == RF_TLM_CONTACT_WAIT);
+    Contact->State = state;
+    if (state == RF_TLM_CONTACT_OPEN)
+    {
+        RF_TLM_Contact_Enter(now);
+    }
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_Contact_Open() -- Whether frames may be sent now         */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+bool RF_TLM_Contact_Open(void)
+{
+    return RF_TLM_Data.Contact.State != RF_TLM_CONTACT_WAIT;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_Contact_Sent() -- Charge a sent frame to the open window */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void RF_TLM_Contact_Sent(void)
+{
+    if (RF_TLM_Data.Contact.State == RF_TLM_CONTACT_OPEN)
+    {
+        ++RF_TLM_Data.Contact.WindowFrames;
+        ++RF_TLM_Data.Contact.Frames;
+    }
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_Contact_FreshSource() -- Source whose newest frame goes  */
+/*                                 next, or -1 once all have gone  */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+int16 RF_TLM_Contact_FreshSource(void)
+{
+    RF_TLM_Contact_t *Contact = &RF_TLM_Data.Contact;
+
+    for (uint16 i = 0; Contact->FreshMask != 0 && i < RF_TLM_Data.SourceCount; i++)
+    {
+        if ((Contact->FreshMask & (1u << i)) == 0)
+        {
+            continue;
+        }
+        if (RF_TLM_Data.Sources[i].Queue.Count != 0)
+        {
+            return (int16)i;
+        }
+        Contact->FreshMask &= (uint8)~(1u << i);
+    }
+
+    return -1;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_Contact_IntervalMsec() -- Send interval in force         */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+uint32 RF_TLM_Contact_IntervalMsec(void)
+{
+    if (RF_TLM_Data.Contact.State == RF_TLM_CONTACT_OPEN && RF_TLM_Data.Contact.Table.IntervalMsec != 0)
+    {
+        return RF_TLM_Data.Contact.Table.IntervalMsec;
+    }
+
+    return RF_TLM_Data.SendIntervalMsec;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_Contact_WaitMsec() -- How long the run loop may pend     */
+/*                              before the next window boundary    */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+uint32 RF_TLM_Contact_WaitMsec(uint32 MaxMsec)
+{
+    uint64 now;
+    uint64 until;
+
+    if (RF_TLM_Data.Contact.Count == 0)
+    {
+        return MaxMsec;
+    }
+
+    now = RF_TLM_Contact_NowMsec();
+    RF_TLM_Contact_Locate(now, &until);
+    if (until != 0 && until - now < MaxMsec)
+    {
+        MaxMsec = (uint32)(until - now);
+    }
+
+    return MaxMsec;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_Contact_NextSec() -- Seconds to the next window start,   */
+/*                             0 inside one or with none ahead     */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+uint32 RF_TLM_Contact_NextSec(void)
+{
+    uint64 now;
+    uint64 until;
+
+    if (RF_TLM_Data.Contact.Count == 0)
+    {
+        return 0;
+    }
+
+    now = RF_TLM_Contact_NowMsec();
+    if (RF_TLM_Contact_Locate(now, &until) || until == 0)
+    {
+        return 0;
+    }
+
+    return (uint32)((until - now + 999u) / 1000u);
+}
@@ -0,0 +1,66 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ * Ground contact schedule of the RF Telemetry Output App
+ */
+
+#ifndef RF_TLM_CONTACT_H
+#define RF_TLM_CONTACT_H
+
+#include "cfe.h"
+
+#include "rf_tlm_msg.h"
+
+/*
+** Contact states
+*/
+#define RF_TLM_CONTACT_FREE 0 /* No table, frames are sent whenever the link is up */
+#define RF_TLM_CONTACT_WAIT 1 /* Between windows, frames are held */
+#define RF_TLM_CONTACT_OPEN 2 /* Inside a window */
+
+typedef struct
+{
+    RF_TLM_ContactTable_t Table;        /**< \brief Active contact table */
+    uint8                 Count;        /**< \brief Windows in use in Table */
+    uint8                 State;        /**< \brief RF_TLM_CONTACT_* at the last step */
+    uint8                 AutoSummary;  /**< \brief Bit i set when source i was summarized for the wait */
+    uint8                 FreshMask;    /**< \brief Bit i set while source i's newest frame is still to go */
+    uint64                OpenMsec;     /**< \brief CFE time the open window was entered */
+    uint32                WindowFrames; /**< \brief Frames sent in the open window */
+    uint32                Windows;      /**< \brief Windows entered */
+    uint32                Frames;       /**< \brief Frames sent inside windows */
+    uint16                UtilPermille; /**< \brief Frames sent over capacity, last closed window */
+    uint16                Backlog;      /**< \brief Frames queued when the last window opened */
+    uint16                Carried;      /**< \brief Frames queued when the last window closed */
+    uint32                CarriedBytes; /**< \brief Bytes of those frames */
+} RF_TLM_Contact_t;
+
+void   RF_TLM_Contact_Init(void);
+bool   RF_TLM_Contact_Load(const RF_TLM_ContactTable_t *Table);
+void   RF_TLM_Contact_Step(void);
+bool   RF_TLM_Contact_Open(void);
+void   RF_TLM_Contact_Sent(void);
+int16  RF_TLM_Contact_FreshSource(void);
+uint32 RF_TLM_Contact_IntervalMsec(void);
+uint32 RF_TLM_Contact_WaitMsec(uint32 MaxMsec);
+uint32 RF_TLM_Contact_NextSec(void);
+
+#endif /* RF_TLM_CONTACT_H */
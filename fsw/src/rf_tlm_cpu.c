@@ -0,0 +1,157 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * \file
+ *   Run loop time accounting for the RF Telemetry Output App.
+ *
+ *   The run loop is cut into stages and every nanosecond of the monotonic
+ *   clock is charged to exactly one of them: the loop switches stage with
+ *   RF_TLM_Cpu_Enter() and restores the previous one when a nested stage
+ *   ends. Time spent pending on the command pipe is idle; the rest is the
+ *   app's active share of the core, including any time it was preempted
+ *   while active, so the figures are an upper bound on its CPU use.
+ *
+ *   Shares are latched every RF_TLM_CPU_WINDOW_MSEC and reported in
+ *   housekeeping. A window whose active share is over the budget raises an
+ *   event; so does the first window back within it.
+ */
+
+#include <string.h>
+
+#include "rf_tlm_events.h"
+#include "rf_tlm.h"
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_Cpu_Init() -- Start accounting, charging the idle stage  */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void RF_TLM_Cpu_Init(uint16 BudgetPermille)
+{
+    RF_TLM_Cpu_t *Cpu = &RF_TLM_Data.Cpu;
+    uint64        now = uC_monotonic_ns();
+
+    memset(Cpu, 0, sizeof(*Cpu));
+
+    Cpu->Stage          = RF_TLM_STAGE_IDLE;
+    Cpu->StageStartNs   = now;
+    Cpu->WindowStartNs  = now;
+    Cpu->LoopStartNs    = now;
+    Cpu->BudgetPermille = BudgetPermille;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_Cpu_Enter() -- Charge the time so far to the current     */
+/*                       stage and switch, returns the old stage   */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+uint8 RF_TLM_Cpu_Enter(uint8 Stage)
+{
+    RF_TLM_Cpu_t *Cpu      = &RF_TLM_Data.Cpu;
+    uint8         Previous = Cpu->Stage;
+    uint64        now      = uC_monotonic_ns();
+
+    Cpu->StageNs[Previous] += now - Cpu->StageStartNs;
+    Cpu->StageStartNs = now;
+    Cpu->Stage        = Stage;
+
+    return Previous;
+}
+
+/*
+** Latch the shares of the window that just ended and check the budget
+*/
+static void RF_TLM_Cpu_Latch(uint64 Now)
+{
+    RF_TLM_Cpu_t *Cpu       = &RF_TLM_Data.Cpu;
+    uint64        window_ns = Now - Cpu->WindowStartNs;
+    uint64        active_ns = 0;
+
+    for (uint8 i = 0; i < RF_TLM_STAGE_COUNT; i++)
+    {
+        Cpu->StagePermille[i] = (uint16)((Cpu->StageNs[i] * 1000u + window_ns / 2) / window_ns);
+        if (i != RF_TLM_STAGE_IDLE)
+        {
+            active_ns += Cpu->StageNs[i];
+        }
+        Cpu->StageNs[i] = 0;
+    }
+
+    Cpu->ActivePermille      = (uint16)((active_ns * 1000u + window_ns / 2) / window_ns);
+    Cpu->ReportedLoopMaxUsec = Cpu->LoopMaxUsec;
+    Cpu->LoopMaxUsec         = 0;
+    Cpu->WindowStartNs       = Now;
+
+    if (Cpu->BudgetPermille != 0 && Cpu->ActivePermille > Cpu->BudgetPermille)
+    {
+        ++Cpu->OverBudgetCount;
+        if (!Cpu->OverBudget)
+        {
+            CFE_EVS_SendEvent(RF_TLM_CPU_ERR_EID, CFE_EVS_EventType_ERROR,
+                              "RF TLM: CPU %u.%u%% over budget %u.%u%%, send %u.%u%%, forward %u.%u%%",
+                              Cpu->ActivePermille / 10, Cpu->ActivePermille % 10, Cpu->BudgetPermille / 10,
+                              Cpu->BudgetPermille % 10, Cpu->StagePermille[RF_TLM_STAGE_SEND] / 10,
+                              Cpu->StagePermille[RF_TLM_STAGE_SEND] % 10,
+                              (Cpu->StagePermille[RF_TLM_STAGE_RECEIVE] + Cpu->StagePermille[RF_TLM_STAGE_ENCODE]) / 10,
+                              (Cpu->StagePermille[RF_TLM_STAGE_RECEIVE] + Cpu->StagePermille[RF_TLM_STAGE_ENCODE]) % 10);
+        }
+        Cpu->OverBudget = true;
+    }
+    else if (Cpu->OverBudget)
+    {
+        CFE_EVS_SendEvent(RF_TLM_CPU_INF_EID, CFE_EVS_EventType_INFORMATION,
+                          "RF TLM: CPU %u.%u%% back within budget %u.%u%%", Cpu->ActivePermille / 10,
+                          Cpu->ActivePermille % 10, Cpu->BudgetPermille / 10, Cpu->BudgetPermille % 10);
+        Cpu->OverBudget = false;
+    }
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_Cpu_Step() -- Close one run loop iteration, called at    */
+/*                      the top of the loop                        */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void RF_TLM_Cpu_Step(void)
+{
+    RF_TLM_Cpu_t *Cpu = &RF_TLM_Data.Cpu;
+    uint64        now;
+    uint64        idle_ns;
+    uint64        active_ns;
+
+    RF_TLM_Cpu_Enter(Cpu->Stage);
+    now = Cpu->StageStartNs;
+
+    /* Idle time is counted since the window start, so take the difference within it */
+    idle_ns   = Cpu->StageNs[RF_TLM_STAGE_IDLE];
+    active_ns = (now - Cpu->LoopStartNs) - (idle_ns - Cpu->LoopIdleNs);
+    if (active_ns / 1000u > Cpu->LoopMaxUsec)
+    {
+        Cpu->LoopMaxUsec = (uint32)(active_ns / 1000u);
+    }
+
+    if (now - Cpu->WindowStartNs >= (uint64)RF_TLM_CPU_WINDOW_MSEC * 1000000u)
+    {
+        RF_TLM_Cpu_Latch(now);
+    }
+
+    Cpu->LoopStartNs = now;
+    Cpu->LoopIdleNs  = Cpu->StageNs[RF_TLM_STAGE_IDLE];
+}
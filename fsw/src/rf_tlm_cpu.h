@@ -0,0 +1,58 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ * Run loop time accounting for the RF Telemetry Output App
+ */
+
+#ifndef RF_TLM_CPU_H
+#define RF_TLM_CPU_H
+
+#include "cfe.h"
+
+#include "rf_tlm_msg.h"
+
+/*
+** Utilization is reported for the last complete window
+*/
+#define RF_TLM_CPU_WINDOW_MSEC 10000
+
+typedef struct
+{
+    uint8  Stage;                                /**< \brief Stage being charged, RF_TLM_STAGE_* */
+    uint64 StageStartNs;                         /**< \brief When the current stage was entered */
+    uint64 WindowStartNs;                        /**< \brief Start of the window being accumulated */
+    uint64 StageNs[RF_TLM_STAGE_COUNT];          /**< \brief Time per stage in this window */
+    uint64 LoopStartNs;                          /**< \brief Start of the current run loop iteration */
+    uint64 LoopIdleNs;                           /**< \brief Idle time at LoopStartNs */
+    uint32 LoopMaxUsec;                          /**< \brief Longest active loop iteration in this window */
+    uint16 StagePermille[RF_TLM_STAGE_COUNT];    /**< \brief Share of the last window per stage */
+    uint16 ActivePermille;                       /**< \brief Share of the last window not idle */
+    uint32 ReportedLoopMaxUsec;                  /**< \brief LoopMaxUsec of the last window */
+    uint16 BudgetPermille;                       /**< \brief Active share allowed before raising an event */
+    bool   OverBudget;                           /**< \brief Last window was over budget */
+    uint32 OverBudgetCount;                      /**< \brief Windows over budget */
+} RF_TLM_Cpu_t;
+
+void  RF_TLM_Cpu_Init(uint16 BudgetPermille);
+uint8 RF_TLM_Cpu_Enter(uint8 Stage);
+void  RF_TLM_Cpu_Step(void);
+
+#endif /* RF_TLM_CPU_H */
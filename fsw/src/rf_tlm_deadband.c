@@ -0,0 +1,241 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * \file
+ *   Per-field deadband filtering for the RF Telemetry Output App.
+ *
+ *   A sample is forwarded when any field with a rule moved past its
+ *   absolute or relative threshold, when a field without a rule or an
+ *   upstream counter changed at all, or when the heartbeat interval has run
+ *   out. Fields the schema marks unused are ignored. Changes are measured
+ *   against the last forwarded sample, not the last received one, so a slow
+ *   drift is still sent once it adds up. RF_TLM_Deadband_Check() leaves
+ *   the reference alone; RF_TLM_Deadband_Sent() moves it once the sample
+ *   has also passed rate shaping.
+ *
+ *   Field values are read with the source's pack schema; a source without
+ *   a schema has no rules and is never filtered.
+ */
+
+#include <math.h>
+#include <string.h>
+
+#include "rf_tlm_deadband.h"
+
+#include "altitude_app_msgids.h"
+#include "temp_app_msgids.h"
+
+/*
+** Thresholds sit just above the sensor noise; quiet sources still show up
+** every 10 s
+*/
+static const RF_TLM_DeadbandDefault_t RF_TLM_DeadbandDefaults[] = {
+    {
+        /* Altitude 0.5 m, pressure 5 Pa, temperature 0.1 degC */
+        .MsgId         = ALTITUDE_APP_RF_DATA_MID,
+        .HeartbeatMsec = 10000,
+        .Fields        = {{0.5f, 0.0f}, {5.0f, 0.0f}, {0.1f, 0.0f}},
+    },
+    {
+        /* Temperature 0.1 degC, ADC 4 counts */
+        .MsgId         = TEMP_APP_RF_DATA_MID,
+        .HeartbeatMsec = 10000,
+        .Fields        = {{0.1f, 0.0f}, {4.0f, 0.0f}},
+    },
+};
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_Deadband_Init() -- Load the default rules of a source    */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void RF_TLM_Deadband_Init(RF_TLM_Deadband_t *Deadband, uint16 MsgId)
+{
+    const RF_TLM_DeadbandDefault_t *Default;
+
+    memset(Deadband, 0, sizeof(*Deadband));
+
+    for (uint16 i = 0; i < sizeof(RF_TLM_DeadbandDefaults) / sizeof(RF_TLM_DeadbandDefaults[0]); i++)
+    {
+        Default = &RF_TLM_DeadbandDefaults[i];
+        if (Default->MsgId != MsgId)
+        {
+            continue;
+        }
+
+        for (uint8 f = 0; f < RF_TLM_RAW_FIELD_COUNT; f++)
+        {
+            RF_TLM_Deadband_SetField(Deadband, f, Default->Fields[f].AbsThreshold, Default->Fields[f].RelThreshold);
+        }
+        RF_TLM_Deadband_SetHeartbeat(Deadband, Default->HeartbeatMsec);
+        break;
+    }
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_Deadband_SetField() -- Set the thresholds of one field   */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void RF_TLM_Deadband_SetField(RF_TLM_Deadband_t *Deadband, uint8 Field, float AbsThreshold, float RelThreshold)
+{
+    Deadband->Fields[Field].AbsThreshold = AbsThreshold;
+    Deadband->Fields[Field].RelThreshold = RelThreshold;
+
+    Deadband->Enabled = false;
+    for (uint8 f = 0; f < RF_TLM_RAW_FIELD_COUNT; f++)
+    {
+        if (Deadband->Fields[f].AbsThreshold > 0.0f || Deadband->Fields[f].RelThreshold > 0.0f)
+        {
+            Deadband->Enabled = true;
+        }
+    }
+
+    /* The next sample is the new reference */
+    Deadband->HasSent = false;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_Deadband_SetHeartbeat() -- Set the minimum send rate     */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void RF_TLM_Deadband_SetHeartbeat(RF_TLM_Deadband_t *Deadband, uint32 HeartbeatMsec)
+{
+    Deadband->HeartbeatMsec = HeartbeatMsec;
+}
+
+/*
+** Field moved past its thresholds since the last forwarded sample
+*/
+static bool RF_TLM_Deadband_Moved(const RF_TLM_FieldDeadband_t *Rule, double Last, double Value)
+{
+    double change;
+
+    if (isnan(Last) || isnan(Value))
+    {
+        return isnan(Last) != isnan(Value);
+    }
+
+    change = fabs(Value - Last);
+
+    if (Rule->AbsThreshold > 0.0f && change > Rule->AbsThreshold)
+    {
+        return true;
+    }
+    if (Rule->RelThreshold > 0.0f && change > Rule->RelThreshold * fabs(Last))
+    {
+        return true;
+    }
+
+    return false;
+}
+
+/*
+** Field words and values of a sample, read with the schema
+*/
+static void RF_TLM_Deadband_Read(const RF_TLM_Schema_t *Schema, const uint8 *const Groups[RF_TLM_RAW_FIELD_COUNT],
+                                 uint32 *Word, double *Value)
+{
+    for (uint8 f = 0; f < RF_TLM_RAW_FIELD_COUNT; f++)
+    {
+        Word[f]  = RF_TLM_Pack_Word(Schema, Groups[f]);
+        Value[f] = RF_TLM_Pack_FieldValue(&Schema->Fields[f], Word[f]);
+    }
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_Deadband_Check() -- Decide whether a sample carries news */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+bool RF_TLM_Deadband_Check(RF_TLM_Deadband_t *Deadband, const RF_TLM_Schema_t *Schema, const uint8 *Counters,
+                           const uint8 *const Groups[RF_TLM_RAW_FIELD_COUNT], uint32 NowMsec)
+{
+    const RF_TLM_FieldDeadband_t *Rule;
+    uint32                        word[RF_TLM_RAW_FIELD_COUNT];
+    double                        value[RF_TLM_RAW_FIELD_COUNT];
+    bool                          admit;
+
+    if (!Deadband->Enabled || Schema == NULL)
+    {
+        return true;
+    }
+
+    RF_TLM_Deadband_Read(Schema, Groups, word, value);
+
+    admit = !Deadband->HasSent;
+
+    if (!admit && Deadband->HeartbeatMsec != 0 && (NowMsec - Deadband->LastSentMsec) >= Deadband->HeartbeatMsec)
+    {
+        admit = true;
+    }
+
+    if (!admit && (Counters[0] != Deadband->LastCounters[0] || Counters[1] != Deadband->LastCounters[1]))
+    {
+        admit = true;
+    }
+
+    for (uint8 f = 0; !admit && f < RF_TLM_RAW_FIELD_COUNT; f++)
+    {
+        Rule = &Deadband->Fields[f];
+
+        if (Schema->Fields[f].Kind == RF_TLM_FIELD_UNUSED)
+        {
+            continue;
+        }
+
+        if (Rule->AbsThreshold > 0.0f || Rule->RelThreshold > 0.0f)
+        {
+            admit = RF_TLM_Deadband_Moved(Rule, Deadband->LastValue[f], value[f]);
+        }
+        else
+        {
+            admit = (word[f] != Deadband->LastWord[f]);
+        }
+    }
+
+    if (!admit)
+    {
+        ++Deadband->SuppressedCount;
+    }
+
+    return admit;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_Deadband_Sent() -- Make a forwarded sample the reference */
+/*                           of the next checks                    */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void RF_TLM_Deadband_Sent(RF_TLM_Deadband_t *Deadband, const RF_TLM_Schema_t *Schema, const uint8 *Counters,
+                          const uint8 *const Groups[RF_TLM_RAW_FIELD_COUNT], uint32 NowMsec)
+{
+    if (!Deadband->Enabled || Schema == NULL)
+    {
+        return;
+    }
+
+    RF_TLM_Deadband_Read(Schema, Groups, Deadband->LastWord, Deadband->LastValue);
+    Deadband->HasSent         = true;
+    Deadband->LastSentMsec    = NowMsec;
+    Deadband->LastCounters[0] = Counters[0];
+    Deadband->LastCounters[1] = Counters[1];
+}
@@ -0,0 +1,77 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ * Per-field deadband filtering for the RF Telemetry Output App
+ */
+
+#ifndef RF_TLM_DEADBAND_H
+#define RF_TLM_DEADBAND_H
+
+#include "cfe.h"
+
+#include "rf_tlm_frame.h"
+#include "rf_tlm_pack.h"
+
+/*
+** Deadband of one field. A field with both thresholds at zero has no rule
+** and any change of it is sent.
+*/
+typedef struct
+{
+    float AbsThreshold; /**< \brief Change larger than this is sent, 0 disables */
+    float RelThreshold; /**< \brief Change larger than this fraction of the last sent value is sent, 0 disables */
+} RF_TLM_FieldDeadband_t;
+
+/*
+** Deadband state kept for every forwarded source
+*/
+typedef struct
+{
+    RF_TLM_FieldDeadband_t Fields[RF_TLM_RAW_FIELD_COUNT];
+    uint32                 HeartbeatMsec;   /**< \brief Send at least this often, 0 disables */
+    bool                   Enabled;         /**< \brief At least one field has a rule */
+    bool                   HasSent;         /**< \brief Last* are valid */
+    uint32                 LastSentMsec;    /**< \brief Time the last sample was passed */
+    uint8                  LastCounters[2]; /**< \brief Upstream error and command counters last passed */
+    uint32                 LastWord[RF_TLM_RAW_FIELD_COUNT];  /**< \brief Raw fields last passed */
+    double                 LastValue[RF_TLM_RAW_FIELD_COUNT]; /**< \brief Field values last passed */
+    uint32                 SuppressedCount; /**< \brief Samples dropped as unchanged */
+} RF_TLM_Deadband_t;
+
+/*
+** Default rules, applied at init
+*/
+typedef struct
+{
+    uint16                 MsgId;
+    uint32                 HeartbeatMsec;
+    RF_TLM_FieldDeadband_t Fields[RF_TLM_RAW_FIELD_COUNT];
+} RF_TLM_DeadbandDefault_t;
+
+void RF_TLM_Deadband_Init(RF_TLM_Deadband_t *Deadband, uint16 MsgId);
+void RF_TLM_Deadband_SetField(RF_TLM_Deadband_t *Deadband, uint8 Field, float AbsThreshold, float RelThreshold);
+void RF_TLM_Deadband_SetHeartbeat(RF_TLM_Deadband_t *Deadband, uint32 HeartbeatMsec);
+bool RF_TLM_Deadband_Check(RF_TLM_Deadband_t *Deadband, const RF_TLM_Schema_t *Schema, const uint8 *Counters,
+                           const uint8 *const Groups[RF_TLM_RAW_FIELD_COUNT], uint32 NowMsec);
+void RF_TLM_Deadband_Sent(RF_TLM_Deadband_t *Deadband, const RF_TLM_Schema_t *Schema, const uint8 *Counters,
+                          const uint8 *const Groups[RF_TLM_RAW_FIELD_COUNT], uint32 NowMsec);
+
+#endif /* RF_TLM_DEADBAND_H */
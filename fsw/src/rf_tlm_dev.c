@@ -0,0 +1,221 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * \file
+ *   Deferred registration and probing of the RF microcontroller.
+ *
+ *   The app enters its run loop without touching the bus. Every cycle
+ *   RF_TLM_Dev_Step() makes at most one registration or probe attempt, and
+ *   failed attempts back off exponentially so an absent uC costs little.
+ *   Frames are queued by the forwarding path until the device is ready.
+ */
+
+#include "rf_tlm_events.h"
+#include "rf_tlm.h"
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_Dev_Init() -- Start from an unregistered device          */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void RF_TLM_Dev_Init(uint32 StartMsec)
+{
+    memset(&RF_TLM_Data.Dev, 0, sizeof(RF_TLM_Data.Dev));
+
+    RF_TLM_Data.Dev.State           = RF_TLM_DEV_UNREGISTERED;
+    RF_TLM_Data.Dev.RetryMsec       = RF_TLM_DEV_RETRY_MIN_MSEC;
+    RF_TLM_Data.Dev.StartMsec       = StartMsec;
+    RF_TLM_Data.Dev.NextAttemptMsec = StartMsec;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_Dev_Failed() -- Schedule the next attempt with backoff   */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static void RF_TLM_Dev_Failed(uint32 NowMsec, const char *Step)
+{
+    RF_TLM_Dev_t *Dev = &RF_TLM_Data.Dev;
+
+    ++Dev->ProbeFailures;
+
+    /* Only the first failure of a streak is reported, HK carries the rest */
+    if (Dev->RetryMsec == RF_TLM_DEV_RETRY_MIN_MSEC)
+    {
+        CFE_EVS_SendEvent(RF_TLM_GENUC_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "RF TLM: genuC %s failed at %s (%s transport), retrying", Step, UC_DEV_PATH,
+                          uC_get_transport()->name);
+    }
+
+    Dev->NextAttemptMsec = NowMsec + Dev->RetryMsec;
+
+    Dev->RetryMsec *= 2;
+    if (Dev->RetryMsec > RF_TLM_DEV_RETRY_MAX_MSEC)
+    {
+        Dev->RetryMsec = RF_TLM_DEV_RETRY_MAX_MSEC;
+    }
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_Dev_CheckBus() -- Report transfers abandoned at their    */
+/*                          deadline and the bus recoveries        */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void RF_TLM_Dev_CheckBus(void)
+{
+    RF_TLM_Dev_t *Dev = &RF_TLM_Data.Dev;
+    uC_stats      bus;
+
+    uC_get_stats(&bus);
+
+    if (bus.timeouts != Dev->SeenTimeouts)
+    {
+        CFE_EVS_SendEvent(RF_TLM_BUSHANG_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "RF TLM: %lu I2C transfer(s) abandoned after %lu ms",
+                          (unsigned long)(bus.timeouts - Dev->SeenTimeouts), (unsigned long)uC_get_deadline_ms());
+
+        Dev->SeenTimeouts = bus.timeouts;
+    }
+
+    /* The driver recovers the bus as it abandons a transfer, and again when it replaces a stuck worker */
+    if (bus.recoveries != Dev->SeenRecoveries)
+    {
+        CFE_EVS_SendEvent(RF_TLM_BUSHANG_ERR_EID, CFE_EVS_EventType_ERROR, "RF TLM: I2C bus recovery %s",
+                          (bus.recovery_failures != Dev->SeenRecoveryFailures) ? "failed" : "done");
+
+        Dev->SeenRecoveries       = bus.recoveries;
+        Dev->SeenRecoveryFailures = bus.recovery_failures;
+    }
+
+    if (bus.worker_restarts != Dev->SeenWorkerRestarts)
+    {
+        CFE_EVS_SendEvent(RF_TLM_BUSHANG_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "RF TLM: I2C worker replaced after %lu ms stuck in a transfer",
+                          (unsigned long)(uC_get_deadline_ms() * UC_WORKER_RESTART_DEADLINES));
+
+        Dev->SeenWorkerRestarts = bus.worker_restarts;
+    }
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_Dev_Step() -- One registration or probe attempt, if due  */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void RF_TLM_Dev_Step(void)
+{
+    RF_TLM_Dev_t *Dev = &RF_TLM_Data.Dev;
+    uint32        now;
+
+    RF_TLM_Dev_CheckBus();
+
+    if (Dev->State == RF_TLM_DEV_READY)
+    {
+        return;
+    }
+
+    now = RF_TLM_GetMsec();
+    if ((int32)(now - Dev->NextAttemptMsec) < 0)
+    {
+        return;
+    }
+
+    ++Dev->ProbeAttempts;
+
+    if (Dev->State == RF_TLM_DEV_UNREGISTERED)
+    {
+        if (uC_attach(UC_BUS_PATH, UC_DEV_PATH) < 0)
+        {
+            RF_TLM_Dev_Failed(now, "registration");
+            return;
+        }
+
+        CFE_EVS_SendEvent(RF_TLM_DEV_INF_EID, CFE_EVS_EventType_INFORMATION, "RF: Device registered correctly at %s",
+                          UC_DEV_PATH);
+        Dev->State = RF_TLM_DEV_PROBING;
+    }
+
+    if (uC_probe() < 0)
+    {
+        RF_TLM_Dev_Failed(now, "probe");
+        return;
+    }
+
+    Dev->State     = RF_TLM_DEV_READY;
+    Dev->RetryMsec = RF_TLM_DEV_RETRY_MIN_MSEC;
+    if (!Dev->WasReady)
+    {
+        Dev->ReadyMsec = now - Dev->StartMsec;
+        Dev->WasReady  = true;
+    }
+
+    CFE_EVS_SendEvent(RF_TLM_DEV_INF_EID, CFE_EVS_EventType_INFORMATION,
+                      "RF: Device ready at %s after %lu ms, %lu attempts", UC_DEV_PATH,
+                      (unsigned long)(now - Dev->StartMsec), (unsigned long)Dev->ProbeAttempts);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_Dev_Lost() -- A transfer failed, probe again             */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void RF_TLM_Dev_Lost(void)
+{
+    RF_TLM_Dev_t *Dev = &RF_TLM_Data.Dev;
+
+    if (Dev->State != RF_TLM_DEV_READY)
+    {
+        return;
+    }
+
+    Dev->State           = RF_TLM_DEV_PROBING;
+    Dev->NextAttemptMsec = RF_TLM_GetMsec() + Dev->RetryMsec;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_Dev_FrameSent() -- Record the time to first frame        */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void RF_TLM_Dev_FrameSent(void)
+{
+    RF_TLM_Dev_t *Dev = &RF_TLM_Data.Dev;
+
+    if (Dev->FrameSent)
+    {
+        return;
+    }
+
+    Dev->FirstFrameMsec = RF_TLM_GetMsec() - Dev->StartMsec;
+    Dev->FrameSent      = true;
+
+    CFE_EVS_SendEvent(RF_TLM_DEV_INF_EID, CFE_EVS_EventType_INFORMATION, "RF: First frame sent %lu ms after start",
+                      (unsigned long)Dev->FirstFrameMsec);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_Dev_IsReady() -- Device may accept frames                */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+bool RF_TLM_Dev_IsReady(void)
+{
+    return RF_TLM_Data.Dev.State == RF_TLM_DEV_READY;
+}
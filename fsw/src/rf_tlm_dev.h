@@ -0,0 +1,68 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ * Deferred registration and probing of the RF microcontroller
+ */
+
+#ifndef RF_TLM_DEV_H
+#define RF_TLM_DEV_H
+
+#include "cfe.h"
+
+/*
+** Device states, reported in housekeeping
+*/
+#define RF_TLM_DEV_UNREGISTERED 0 /* Not yet registered with the I2C framework */
+#define RF_TLM_DEV_PROBING      1 /* Registered, waiting for a successful probe */
+#define RF_TLM_DEV_READY        2 /* Probed, frames may be sent */
+
+/*
+** Probe retry backoff limits
+*/
+#define RF_TLM_DEV_RETRY_MIN_MSEC 250
+#define RF_TLM_DEV_RETRY_MAX_MSEC 8000
+
+typedef struct
+{
+    uint8  State;           /**< \brief One of RF_TLM_DEV_* */
+    uint32 RetryMsec;       /**< \brief Current retry backoff */
+    uint32 NextAttemptMsec; /**< \brief Time of the next registration or probe attempt */
+    uint32 ProbeAttempts;   /**< \brief Registration and probe attempts */
+    uint32 ProbeFailures;   /**< \brief Failed attempts */
+    uint32 StartMsec;       /**< \brief App start time, reference for the timings below */
+    uint32 ReadyMsec;       /**< \brief Time from start until the device was first ready */
+    uint32 FirstFrameMsec;  /**< \brief Time from start until the first frame was sent */
+    bool   WasReady;        /**< \brief ReadyMsec is valid */
+    bool   FrameSent;       /**< \brief FirstFrameMsec is valid */
+    uint32 SeenTimeouts;    /**< \brief Bus timeouts already reported */
+    uint32 SeenRecoveries;  /**< \brief Bus recoveries already reported */
+    uint32 SeenRecoveryFailures; /**< \brief Failed recoveries already reported */
+    uint32 SeenWorkerRestarts;   /**< \brief Worker restarts already reported */
+} RF_TLM_Dev_t;
+
+void RF_TLM_Dev_Init(uint32 StartMsec);
+void RF_TLM_Dev_Step(void);
+void RF_TLM_Dev_CheckBus(void);
+void RF_TLM_Dev_Lost(void);
+void RF_TLM_Dev_FrameSent(void);
+bool RF_TLM_Dev_IsReady(void);
+
+#endif /* RF_TLM_DEV_H */
@@ -39,7 +39,32 @@
 #define RF_TLM_TLMOUTENA_INF_EID     11
 #define RF_TLM_DEV_INF_EID           12
 #define RF_TLM_COMMANDDEBUG_INF_EID  13
+#define RF_TLM_SETRATE_INF_EID       14
+#define RF_TLM_SETENC_INF_EID        15
+#define RF_TLM_UPLINK_INF_EID        16
+#define RF_TLM_UPLINK_ERR_EID        17
+#define RF_TLM_BUSHANG_ERR_EID       18
+#define RF_TLM_SETDEADBAND_INF_EID   19
+#define RF_TLM_SETPROFILE_INF_EID    20
+#define RF_TLM_CPU_ERR_EID           21
+#define RF_TLM_CPU_INF_EID           22
+#define RF_TLM_SETSLOTS_INF_EID      23
+#define RF_TLM_LINKTEST_INF_EID      24
+#define RF_TLM_LINKTEST_ERR_EID      25
+#define RF_TLM_SETFRAMING_INF_EID    26
+#define RF_TLM_SETSUMMARY_INF_EID    27
+#define RF_TLM_SETEVTFILTER_INF_EID  28
+#define RF_TLM_CDS_INF_EID           29
+#define RF_TLM_CDS_ERR_EID           30
+#define RF_TLM_SETCOMPRESS_INF_EID   31
+#define RF_TLM_SETCONTACTS_INF_EID   32
+#define RF_TLM_CONTACT_INF_EID       33
+#define RF_TLM_SNAPSHOT_INF_EID      34
 
-#define RF_TLM_EVENT_COUNTS          12
+/*
+ * Every EID above is registered for filtering in RF_TLM_Init(), a new one
+ * goes there too. EVS keeps at most CFE_PLATFORM_EVS_MAX_EVENT_FILTERS.
+ */
+#define RF_TLM_EVENT_COUNTS          34
 
 #endif /* RF_TLM_EVENTS_H */
@@ -0,0 +1,256 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * \file
+ *   Event fast lane of the RF Telemetry Output App.
+ *
+ *   Event messages of the apps in RF_TLM_EVENT_APP_LIST, and of the others
+ *   through RF_TLM_EVENT_OTHER_MIN_TYPE, are kept when their type is at
+ *   least the app's minimum. Each one becomes a short event frame: the app
+ *   code, the event type and ID, and up to RF_TLM_EVENT_MAX_ARGS numbers
+ *   taken from the text, which is dropped. The frames have their own
+ *   queue, which RF_TLM_next_queue() serves before any other, and
+ *   RF_TLM_send_queued() does not hold them for the send interval.
+ *
+ *   The latency reported is from the event time to the uC accepting the
+ *   frame, so it includes the time the message spent on the software bus.
+ */
+
+#include <ctype.h>
+#include <string.h>
+
+#include "cfe_evs_msg.h"
+
+#include "rf_tlm_events.h"
+#include "rf_tlm.h"
+
+/*
+** Startup filter of each listed app
+*/
+#define RF_TLM_EVENT_APP_NAME(Name, MinType) Name,
+#define RF_TLM_EVENT_APP_MIN(Name, MinType)  MinType,
+static const char *const RF_TLM_EventAppNames[]    = {RF_TLM_EVENT_APP_LIST(RF_TLM_EVENT_APP_NAME)};
+static const uint8       RF_TLM_EventAppMinTypes[] = {RF_TLM_EVENT_APP_LIST(RF_TLM_EVENT_APP_MIN)};
+#undef RF_TLM_EVENT_APP_NAME
+#undef RF_TLM_EVENT_APP_MIN
+
+/*
+** Code of an app, RF_TLM_EVENT_APP_OTHER when it is not listed
+*/
+static uint8 RF_TLM_Evs_AppCode(const char *AppName)
+{
+    for (uint8 i = 0; i < RF_TLM_EVENT_APP_COUNT; i++)
+    {
+        if (strncmp(RF_TLM_EventAppNames[i], AppName, CFE_MISSION_MAX_API_LEN) == 0)
+        {
+            return i;
+        }
+    }
+
+    return RF_TLM_EVENT_APP_OTHER;
+}
+
+/*
+** First numbers of an event text, decimal or 0x hex, as 32-bit words. A
+** number must start a word, so "I2C" or "EID27" carry none.
+*/
+static uint8 RF_TLM_Evs_ParseArgs(const char *Text, size_t Size, uint32 *Args)
+{
+    uint8  count = 0;
+    size_t i     = 0;
+    bool   negative;
+    uint32 value;
+    int    c;
+
+    while (i < Size && Text[i] != '\0' && count < RF_TLM_EVENT_MAX_ARGS)
+    {
+        if (!isdigit((unsigned char)Text[i]) ||
+            (i > 0 && (isalnum((unsigned char)Text[i - 1]) || Text[i - 1] == '_')))
+        {
+            ++i;
+            continue;
+        }
+
+        negative = (i > 0 && Text[i - 1] == '-');
+        value    = 0;
+
+        if (Text[i] == '0' && i + 2 < Size && (Text[i + 1] == 'x' || Text[i + 1] == 'X') &&
+            isxdigit((unsigned char)Text[i + 2]))
+        {
+            for (i += 2; i < Size && isxdigit((unsigned char)Text[i]); i++)
+            {
+                c     = tolower((unsigned char)Text[i]);
+                value = (value << 4) | (uint32)(isdigit(c) ? c - '0' : c - 'a' + 10);
+            }
+        }
+        else
+        {
+            for (; i < Size && isdigit((unsigned char)Text[i]); i++)
+            {
+                value = value * 10u + (uint32)(Text[i] - '0');
+            }
+        }
+
+        Args[count++] = negative ? (uint32)(-(int32)value) : value;
+
+        /* Skip the rest of a word such as "12ms" or "1.5" */
+        while (i < Size && (isalnum((unsigned char)Text[i]) || Text[i] == '.'))
+        {
+            ++i;
+        }
+    }
+
+    return count;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_Evs_Init() -- Empty the lane and load the startup filter */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void RF_TLM_Evs_Init(void)
+{
+    RF_TLM_Evs_t *Evs = &RF_TLM_Data.Evs;
+
+    memset(Evs, 0, sizeof(*Evs));
+    RF_TLM_Queue_Init(&Evs->Queue, Evs->Store, RF_TLM_EVENT_QUEUE_DEPTH);
+
+    memcpy(Evs->MinType, RF_TLM_EventAppMinTypes, RF_TLM_EVENT_APP_COUNT);
+    Evs->MinType[RF_TLM_EVENT_APP_COUNT] = RF_TLM_EVENT_OTHER_MIN_TYPE;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_Evs_SetFilter() -- Set the lowest event type sent for an */
+/*                           app, or for the unlisted apps when    */
+/*                           AppName is empty; returns the app     */
+/*                           code or -1 when the app is not listed */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+int32 RF_TLM_Evs_SetFilter(const char *AppName, uint8 MinType)
+{
+    uint8 code;
+
+    if (AppName[0] == '\0')
+    {
+        RF_TLM_Data.Evs.MinType[RF_TLM_EVENT_APP_COUNT] = MinType;
+        return RF_TLM_EVENT_APP_OTHER;
+    }
+
+    code = RF_TLM_Evs_AppCode(AppName);
+    if (code == RF_TLM_EVENT_APP_OTHER)
+    {
+        return -1;
+    }
+
+    RF_TLM_Data.Evs.MinType[code] = MinType;
+
+    return code;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_Evs_Forward() -- Filter an event message and queue its   */
+/*                         event frame                             */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void RF_TLM_Evs_Forward(const CFE_SB_Buffer_t *EventMsg)
+{
+    const CFE_EVS_LongEventTlm_t *Event = (const CFE_EVS_LongEventTlm_t *)EventMsg;
+    RF_TLM_Evs_t                 *Evs   = &RF_TLM_Data.Evs;
+    RF_TLM_Frame_t                Frame;
+    CFE_MSG_Size_t                MsgSize;
+    uint32                        Args[RF_TLM_EVENT_MAX_ARGS];
+    uint8                         argc = 0;
+    uint8                         code;
+    uint16                        type;
+
+    /* Short and long event messages share the packet ID */
+    CFE_MSG_GetSize(&EventMsg->Msg, &MsgSize);
+    if (MsgSize < sizeof(CFE_EVS_ShortEventTlm_t))
+    {
+        return;
+    }
+    ++Evs->Seen;
+
+    code = RF_TLM_Evs_AppCode(Event->Payload.PacketID.AppName);
+    type = Event->Payload.PacketID.EventType;
+    if (type < Evs->MinType[(code == RF_TLM_EVENT_APP_OTHER) ? RF_TLM_EVENT_APP_COUNT : code])
+    {
+        ++Evs->Filtered;
+        return;
+    }
+
+    CFE_MSG_GetMsgId(&EventMsg->Msg, &Frame.MsgId);
+    CFE_MSG_GetMsgTime(&EventMsg->Msg, &Frame.SampleTime);
+    if (Frame.SampleTime.Seconds == 0 && Frame.SampleTime.Subseconds == 0)
+    {
+        Frame.SampleTime = CFE_TIME_GetTime();
+    }
+
+    if (MsgSize >= sizeof(CFE_EVS_LongEventTlm_t))
+    {
+        argc = RF_TLM_Evs_ParseArgs(Event->Payload.Message, sizeof(Event->Payload.Message), Args);
+    }
+
+    /* Sequence and time delta are stamped when the frame is sent */
+    memset(Frame.Data, 0, RF_TLM_EVENT_HDR_BYTES);
+    Frame.Data[0]                           = RF_TLM_FRAME_EVENT;
+    Frame.Data[RF_TLM_EVENT_APP_OFFSET]     = code;
+    Frame.Data[RF_TLM_EVENT_TYPE_OFFSET]    = (uint8)type;
+    RF_TLM_Frame_PutU16(&Frame.Data[RF_TLM_EVENT_EID_OFFSET], Event->Payload.PacketID.EventID);
+    Frame.Data[RF_TLM_EVENT_DROPPED_OFFSET] = (uint8)Evs->Queue.DroppedCount;
+    Frame.Data[RF_TLM_EVENT_ARGC_OFFSET]    = argc;
+    for (uint8 i = 0; i < argc; i++)
+    {
+        RF_TLM_Frame_PutU32(&Frame.Data[RF_TLM_EVENT_HDR_BYTES + 4 * i], Args[i]);
+    }
+    Frame.Length = (uint16)(RF_TLM_EVENT_HDR_BYTES + 4 * argc);
+
+    RF_TLM_Queue_Push(&Evs->Queue, &Frame);
+    ++Evs->Queued;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_Evs_Sent() -- Account an event frame the uC accepted     */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void RF_TLM_Evs_Sent(CFE_TIME_SysTime_t SampleTime)
+{
+    RF_TLM_Evs_t      *Evs = &RF_TLM_Data.Evs;
+    CFE_TIME_SysTime_t now = CFE_TIME_GetTime();
+    CFE_TIME_SysTime_t age;
+    uint32             msec = 0;
+
+    /* An event time ahead of now, after a time jump, counts as no delay */
+    if (CFE_TIME_Compare(now, SampleTime) != CFE_TIME_A_LT_B)
+    {
+        age  = CFE_TIME_Subtract(now, SampleTime);
+        msec = (age.Seconds >= 0xFFFF / 1000u) ? 0xFFFF
+                                               : age.Seconds * 1000u + CFE_TIME_Sub2MicroSecs(age.Subseconds) / 1000u;
+    }
+
+    ++Evs->Sent;
+    Evs->LatencyMsec = (uint16)((msec > 0xFFFF) ? 0xFFFF : msec);
+    if (Evs->LatencyMsec > Evs->LatencyMaxMsec)
+    {
+        Evs->LatencyMaxMsec = Evs->LatencyMsec;
+    }
+}
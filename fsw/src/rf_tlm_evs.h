@@ -0,0 +1,62 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ * Event fast lane of the RF Telemetry Output App
+ */
+
+#ifndef RF_TLM_EVS_H
+#define RF_TLM_EVS_H
+
+#include "cfe.h"
+#include "cfe_msgids.h"
+
+#include "rf_tlm_platform_cfg.h"
+#include "rf_tlm_frame.h"
+#include "rf_tlm_queue.h"
+
+#define RF_TLM_EVENT_PIPE_DEPTH  16 /* Event messages held between two run loop steps */
+#define RF_TLM_EVENT_QUEUE_DEPTH 8  /* Event frames waiting for the bus */
+
+/*
+** Number of apps in RF_TLM_EVENT_APP_LIST
+*/
+#define RF_TLM_EVENT_APP_ONE(Name, MinType) +1
+#define RF_TLM_EVENT_APP_COUNT              (0 RF_TLM_EVENT_APP_LIST(RF_TLM_EVENT_APP_ONE))
+
+typedef struct
+{
+    uint8               MinType[RF_TLM_EVENT_APP_COUNT + 1]; /**< \brief Per listed app, then the others */
+    RF_TLM_FrameQueue_t Queue;                               /**< \brief Served before every other queue */
+    RF_TLM_Frame_t      Store[RF_TLM_EVENT_QUEUE_DEPTH];
+    uint32              Seen;            /**< \brief Event messages received */
+    uint32              Filtered;        /**< \brief Events below their app's type */
+    uint32              Queued;          /**< \brief Event frames queued */
+    uint32              Sent;            /**< \brief Event frames accepted by the uC */
+    uint16              LatencyMsec;     /**< \brief Event time to uC acceptance, last event */
+    uint16              LatencyMaxMsec;  /**< \brief Event time to uC acceptance, worst event */
+} RF_TLM_Evs_t;
+
+void  RF_TLM_Evs_Init(void);
+int32 RF_TLM_Evs_SetFilter(const char *AppName, uint8 MinType);
+void  RF_TLM_Evs_Forward(const CFE_SB_Buffer_t *EventMsg);
+void  RF_TLM_Evs_Sent(CFE_TIME_SysTime_t SampleTime);
+
+#endif /* RF_TLM_EVS_H */
@@ -0,0 +1,462 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * \file
+ *   RF frame field access shared by the flight app and the ground tools.
+ */
+
+#include <string.h>
+
+#include "rf_tlm_frame.h"
+
+/*
+** Match search of the compressor: hash chains over the 3-byte prefixes of
+** the block, followed at most RF_TLM_LZ_CHAIN_DEPTH links deep
+*/
+#define RF_TLM_LZ_HASH_SIZE   256
+#define RF_TLM_LZ_CHAIN_DEPTH 8
+#define RF_TLM_LZ_HASH(p)     ((uint16_t)(((p)[0] << 5) ^ ((p)[1] << 2) ^ (p)[2]) & (RF_TLM_LZ_HASH_SIZE - 1))
+
+/*
+** CRC-16/CCITT, polynomial 0x1021, one entry per leading byte
+*/
+static const uint16_t RF_TLM_Frame_CrcTable[256] = {
+    0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+    0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF,
+    0x1231, 0x0210, 0x3273, 0x2252, 0x52B5, 0x4294, 0x72F7, 0x62D6,
+    0x9339, 0x8318, 0xB37B, 0xA35A, 0xD3BD, 0xC39C, 0xF3FF, 0xE3DE,
+    0x2462, 0x3443, 0x0420, 0x1401, 0x64E6, 0x74C7, 0x44A4, 0x5485,
+    0xA56A, 0xB54B, 0x8528, 0x9509, 0xE5EE, 0xF5CF, 0xC5AC, 0xD58D,
+    0x3653, 0x2672, 0x1611, 0x0630, 0x76D7, 0x66F6, 0x5695, 0x46B4,
+    0xB75B, 0xA77A, 0x9719, 0x8738, 0xF7DF, 0xE7FE, 0xD79D, 0xC7BC,
+    0x48C4, 0x58E5, 0x6886, 0x78A7, 0x0840, 0x1861, 0x2802, 0x3823,
+    0xC9CC, 0xD9ED, 0xE98E, 0xF9AF, 0x8948, 0x9969, 0xA90A, 0xB92B,
+    0x5AF5, 0x4AD4, 0x7AB7, 0x6A96, 0x1A71, 0x0A50, 0x3A33, 0x2A12,
+    0xDBFD, 0xCBDC, 0xFBBF, 0xEB9E, 0x9B79, 0x8B58, 0xBB3B, 0xAB1A,
+    0x6CA6, 0x7C87, 0x4CE4, 0x5CC5, 0x2C22, 0x3C03, 0x0C60, 0x1C41,
+    0xEDAE, 0xFD8F, 0xCDEC, 0xDDCD, 0xAD2A, 0xBD0B, 0x8D68, 0x9D49,
+    0x7E97, 0x6EB6, 0x5ED5, 0x4EF4, 0x3E13, 0x2E32, 0x1E51, 0x0E70,
+    0xFF9F, 0xEFBE, 0xDFDD, 0xCFFC, 0xBF1B, 0xAF3A, 0x9F59, 0x8F78,
+    0x9188, 0x81A9, 0xB1CA, 0xA1EB, 0xD10C, 0xC12D, 0xF14E, 0xE16F,
+    0x1080, 0x00A1, 0x30C2, 0x20E3, 0x5004, 0x4025, 0x7046, 0x6067,
+    0x83B9, 0x9398, 0xA3FB, 0xB3DA, 0xC33D, 0xD31C, 0xE37F, 0xF35E,
+    0x02B1, 0x1290, 0x22F3, 0x32D2, 0x4235, 0x5214, 0x6277, 0x7256,
+    0xB5EA, 0xA5CB, 0x95A8, 0x8589, 0xF56E, 0xE54F, 0xD52C, 0xC50D,
+    0x34E2, 0x24C3, 0x14A0, 0x0481, 0x7466, 0x6447, 0x5424, 0x4405,
+    0xA7DB, 0xB7FA, 0x8799, 0x97B8, 0xE75F, 0xF77E, 0xC71D, 0xD73C,
+    0x26D3, 0x36F2, 0x0691, 0x16B0, 0x6657, 0x7676, 0x4615, 0x5634,
+    0xD94C, 0xC96D, 0xF90E, 0xE92F, 0x99C8, 0x89E9, 0xB98A, 0xA9AB,
+    0x5844, 0x4865, 0x7806, 0x6827, 0x18C0, 0x08E1, 0x3882, 0x28A3,
+    0xCB7D, 0xDB5C, 0xEB3F, 0xFB1E, 0x8BF9, 0x9BD8, 0xABBB, 0xBB9A,
+    0x4A75, 0x5A54, 0x6A37, 0x7A16, 0x0AF1, 0x1AD0, 0x2AB3, 0x3A92,
+    0xFD2E, 0xED0F, 0xDD6C, 0xCD4D, 0xBDAA, 0xAD8B, 0x9DE8, 0x8DC9,
+    0x7C26, 0x6C07, 0x5C64, 0x4C45, 0x3CA2, 0x2C83, 0x1CE0, 0x0CC1,
+    0xEF1F, 0xFF3E, 0xCF5D, 0xDF7C, 0xAF9B, 0xBFBA, 0x8FD9, 0x9FF8,
+    0x6E17, 0x7E36, 0x4E55, 0x5E74, 0x2E93, 0x3EB2, 0x0ED1, 0x1EF0,
+};
+
+void RF_TLM_Frame_PutU16(uint8_t *Dst, uint16_t Value)
+{
+    Dst[0] = (uint8_t)(Value >> 8);
+    Dst[1] = (uint8_t)Value;
+}
+
+void RF_TLM_Frame_PutU32(uint8_t *Dst, uint32_t Value)
+{
+    Dst[0] = (uint8_t)(Value >> 24);
+    Dst[1] = (uint8_t)(Value >> 16);
+    Dst[2] = (uint8_t)(Value >> 8);
+    Dst[3] = (uint8_t)Value;
+}
+
+uint16_t RF_TLM_Frame_GetU16(const uint8_t *Src)
+{
+    return (uint16_t)(((uint16_t)Src[0] << 8) | Src[1]);
+}
+
+uint32_t RF_TLM_Frame_GetU32(const uint8_t *Src)
+{
+    return ((uint32_t)Src[0] << 24) | ((uint32_t)Src[1] << 16) | ((uint32_t)Src[2] << 8) | Src[3];
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_Frame_SeqOffset() -- Where the sequence number sits, or  */
+/*                             -1 for unknown or short frames      */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+int RF_TLM_Frame_SeqOffset(const uint8_t *Frame, uint16_t Len)
+{
+    int offset;
+
+    if (Len == 0)
+    {
+        return -1;
+    }
+
+    switch (Frame[0])
+    {
+        case RF_TLM_FRAME_TIMEREF:
+            offset = RF_TLM_TIMEREF_SEQ_OFFSET;
+            break;
+
+        case RF_TLM_FRAME_PACKED:
+            offset = RF_TLM_PACKED_SEQ_OFFSET;
+            break;
+
+        case RF_TLM_FRAME_ACK:
+            offset = RF_TLM_ACK_SEQ_OFFSET;
+            break;
+
+        case RF_TLM_FRAME_FRAGMENT:
+            offset = RF_TLM_FRAG_SEQ_OFFSET;
+            break;
+
+        case RF_TLM_FRAME_SUMMARY:
+            offset = RF_TLM_SUMMARY_SEQ_OFFSET;
+            break;
+
+        case RF_TLM_FRAME_EVENT:
+            offset = RF_TLM_EVENT_SEQ_OFFSET;
+            break;
+
+        default:
+            offset = (Frame[0] < RF_TLM_FRAME_TYPE_MIN) ? RF_TLM_RAW_SEQ_OFFSET : -1;
+            break;
+    }
+
+    return (offset >= 0 && offset + 2 <= Len) ? offset : -1;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_Frame_DtOffset() -- Where the time delta sits, or -1 if  */
+/*                            the frame has none                   */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+int RF_TLM_Frame_DtOffset(const uint8_t *Frame, uint16_t Len)
+{
+    int offset;
+
+    if (Len == 0)
+    {
+        return -1;
+    }
+
+    switch (Frame[0])
+    {
+        case RF_TLM_FRAME_PACKED:
+            offset = RF_TLM_PACKED_DT_OFFSET;
+            break;
+
+        case RF_TLM_FRAME_ACK:
+            offset = RF_TLM_ACK_DT_OFFSET;
+            break;
+
+        case RF_TLM_FRAME_FRAGMENT:
+            offset = RF_TLM_FRAG_DT_OFFSET;
+            break;
+
+        case RF_TLM_FRAME_SUMMARY:
+            offset = RF_TLM_SUMMARY_DT_OFFSET;
+            break;
+
+        case RF_TLM_FRAME_EVENT:
+            offset = RF_TLM_EVENT_DT_OFFSET;
+            break;
+
+        default:
+            offset = (Frame[0] < RF_TLM_FRAME_TYPE_MIN) ? RF_TLM_RAW_DT_OFFSET : -1;
+            break;
+    }
+
+    return (offset >= 0 && offset + 2 <= Len) ? offset : -1;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_Frame_FragCount() -- Fragments needed for a message, 0   */
+/*                             if it is empty or too large         */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+uint16_t RF_TLM_Frame_FragCount(uint16_t MsgLen)
+{
+    if (MsgLen == 0 || MsgLen > RF_TLM_FRAG_MAX_MSG_BYTES)
+    {
+        return 0;
+    }
+
+    return (uint16_t)((MsgLen + RF_TLM_FRAG_DATA_BYTES - 1) / RF_TLM_FRAG_DATA_BYTES);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_Frame_BuildFragment() -- Write fragment Index of a       */
+/*                                 message, returns the frame      */
+/*                                 length. Sequence and time delta */
+/*                                 are left zero.                  */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+uint16_t RF_TLM_Frame_BuildFragment(uint8_t *Out, const uint8_t *Msg, uint16_t MsgLen, uint8_t MsgNum, uint8_t Index)
+{
+    uint16_t count = RF_TLM_Frame_FragCount(MsgLen);
+    uint16_t start;
+    uint16_t len;
+
+    if (Index >= count)
+    {
+        return 0;
+    }
+
+    start = (uint16_t)(Index * RF_TLM_FRAG_DATA_BYTES);
+    len   = (uint16_t)(MsgLen - start);
+    if (len > RF_TLM_FRAG_DATA_BYTES)
+    {
+        len = RF_TLM_FRAG_DATA_BYTES;
+    }
+
+    Out[0] = RF_TLM_FRAME_FRAGMENT;
+    RF_TLM_Frame_PutU16(&Out[RF_TLM_FRAG_SEQ_OFFSET], 0);
+    RF_TLM_Frame_PutU16(&Out[RF_TLM_FRAG_DT_OFFSET], 0);
+    Out[RF_TLM_FRAG_MSGNUM_OFFSET] = MsgNum;
+    Out[RF_TLM_FRAG_INDEX_OFFSET]  = Index;
+    Out[RF_TLM_FRAG_COUNT_OFFSET]  = (uint8_t)count;
+    memcpy(&Out[RF_TLM_FRAG_HDR_BYTES], &Msg[start], len);
+
+    return (uint16_t)(RF_TLM_FRAG_HDR_BYTES + len);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_Frame_BuildTest() -- Write a link test frame of Len      */
+/*                             bytes, at least the header          */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void RF_TLM_Frame_BuildTest(uint8_t *Out, uint16_t Len, uint8_t Run, uint32_t Seq)
+{
+    Out[0]                      = RF_TLM_FRAME_TEST;
+    Out[RF_TLM_TEST_RUN_OFFSET] = Run;
+    RF_TLM_Frame_PutU32(&Out[RF_TLM_TEST_SEQ_OFFSET], Seq);
+
+    for (uint16_t i = RF_TLM_TEST_HDR_BYTES; i < Len; i++)
+    {
+        Out[i] = (uint8_t)(Seq + i);
+    }
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_Frame_CheckTest() -- Filler bytes of a link test frame   */
+/*                             that do not match its sequence      */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+int RF_TLM_Frame_CheckTest(const uint8_t *Frame, uint16_t Len)
+{
+    uint32_t seq = RF_TLM_Frame_GetU32(&Frame[RF_TLM_TEST_SEQ_OFFSET]);
+    int      bad = 0;
+
+    for (uint16_t i = RF_TLM_TEST_HDR_BYTES; i < Len; i++)
+    {
+        if (Frame[i] != (uint8_t)(seq + i))
+        {
+            ++bad;
+        }
+    }
+
+    return bad;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_Frame_Crc16() -- CRC-16/CCITT of Len bytes, initial      */
+/*                         value 0xFFFF, as the TM frame error     */
+/*                         control field                           */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+uint16_t RF_TLM_Frame_Crc16(const uint8_t *Data, uint16_t Len)
+{
+    uint16_t crc = 0xFFFF;
+
+    for (uint16_t i = 0; i < Len; i++)
+    {
+        crc = (uint16_t)((crc << 8) ^ RF_TLM_Frame_CrcTable[(uint8_t)((crc >> 8) ^ Data[i])]);
+    }
+
+    return crc;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_Frame_Compress() -- LZSS-compress a block of at most     */
+/*                            RF_TLM_LZ_BLOCK_BYTES into Out,      */
+/*                            returns 0 when it would not shrink   */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+uint16_t RF_TLM_Frame_Compress(uint8_t *Out, const uint8_t *In, uint16_t InLen)
+{
+    int16_t  head[RF_TLM_LZ_HASH_SIZE];
+    int16_t  prev[RF_TLM_LZ_BLOCK_BYTES];
+    uint16_t pos   = 0;
+    uint16_t out   = 0;
+    uint16_t flags = 0;
+    uint8_t  bit   = 8;
+    uint16_t limit;
+    uint16_t best;
+    uint16_t dist = 0;
+    uint16_t n;
+    uint16_t h;
+    int16_t  cand;
+
+    if (InLen > RF_TLM_LZ_BLOCK_BYTES)
+    {
+        return 0;
+    }
+
+    memset(head, 0xFF, sizeof(head));
+
+    while (pos < InLen)
+    {
+        if (bit == 8)
+        {
+            if (out >= InLen)
+            {
+                return 0;
+            }
+            flags      = out;
+            Out[out++] = 0;
+            bit        = 0;
+        }
+
+        best = 0;
+        if (InLen - pos >= RF_TLM_LZ_MIN_MATCH)
+        {
+            limit = InLen - pos;
+            if (limit > RF_TLM_LZ_MAX_MATCH)
+            {
+                limit = RF_TLM_LZ_MAX_MATCH;
+            }
+
+            cand = head[RF_TLM_LZ_HASH(&In[pos])];
+            for (uint8_t depth = 0; cand >= 0 && depth < RF_TLM_LZ_CHAIN_DEPTH && best < limit; depth++)
+            {
+                for (n = 0; n < limit && In[cand + n] == In[pos + n]; n++)
+                {
+                }
+                if (n > best)
+                {
+                    best = n;
+                    dist = (uint16_t)(pos - cand);
+                }
+                cand = prev[cand];
+            }
+        }
+
+        if (best >= RF_TLM_LZ_MIN_MATCH)
+        {
+            if (out + 2 > InLen)
+            {
+                return 0;
+            }
+            Out[flags] |= (uint8_t)(1u << bit);
+            Out[out++] = (uint8_t)(dist - 1);
+            Out[out++] = (uint8_t)(best - RF_TLM_LZ_MIN_MATCH);
+        }
+        else
+        {
+            if (out >= InLen)
+            {
+                return 0;
+            }
+            Out[out++] = In[pos];
+            best       = 1;
+        }
+        ++bit;
+
+        for (; best > 0; best--, pos++)
+        {
+            if (InLen - pos >= RF_TLM_LZ_MIN_MATCH)
+            {
+                h         = RF_TLM_LZ_HASH(&In[pos]);
+                prev[pos] = head[h];
+                head[h]   = (int16_t)pos;
+            }
+        }
+    }
+
+    return (out < InLen) ? out : 0;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_Frame_Expand() -- Undo RF_TLM_Frame_Compress(), returns  */
+/*                          the block length or 0 when the stream  */
+/*                          is malformed                           */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+uint16_t RF_TLM_Frame_Expand(uint8_t *Out, uint16_t OutMax, const uint8_t *In, uint16_t InLen)
+{
+    uint16_t in    = 0;
+    uint16_t out   = 0;
+    uint8_t  flags = 0;
+    uint8_t  bit   = 8;
+    uint16_t dist;
+    uint16_t n;
+
+    while (in < InLen)
+    {
+        if (bit == 8)
+        {
+            flags = In[in++];
+            bit   = 0;
+            continue;
+        }
+
+        if (flags & (1u << bit))
+        {
+            if (InLen - in < 2)
+            {
+                return 0;
+            }
+            dist = (uint16_t)(In[in] + 1);
+            n    = (uint16_t)(In[in + 1] + RF_TLM_LZ_MIN_MATCH);
+            in += 2;
+            if (dist > out || n > OutMax - out)
+            {
+                return 0;
+            }
+
+            /* Byte by byte, a match may overlap the bytes it produces */
+            for (; n > 0; n--, out++)
+            {
+                Out[out] = Out[out - dist];
+            }
+        }
+        else
+        {
+            if (out >= OutMax)
+            {
+                return 0;
+            }
+            Out[out++] = In[in++];
+        }
+        ++bit;
+    }
+
+    return out;
+}
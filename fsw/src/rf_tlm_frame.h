@@ -0,0 +1,342 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ * RF frame layout shared by the flight app and the ground tools
+ *
+ * \note This header must not depend on cFE, the ground tools build it on
+ *       the host.
+ */
+
+#ifndef RF_TLM_FRAME_H
+#define RF_TLM_FRAME_H
+
+#include <stdint.h>
+
+/*
+** Every frame carries a 16-bit rolling sequence number, incremented for each
+** frame the uC accepts, so the ground can tell loss from reordering. Sample
+** times travel as a 16-bit millisecond delta from the last time reference
+** frame, which carries a full CFE time.
+**
+** Multi-byte fields are big-endian.
+*/
+
+/*
+** Raw frame: the subscribed packet copied field by field
+**
+**   [0..1]   AppID_H, AppID_L
+**   [2]      upstream CommandErrorCounter
+**   [3]      upstream CommandCounter
+**   [4..5]   sequence number
+**   [6..29]  byte_group_1 .. byte_group_6, 4 bytes each
+**   [30..31] sample time, ms after the time reference
+*/
+#define RF_TLM_RAW_APPID_OFFSET  0
+#define RF_TLM_RAW_ERRCNT_OFFSET 2
+#define RF_TLM_RAW_CMDCNT_OFFSET 3
+#define RF_TLM_RAW_SEQ_OFFSET    4
+#define RF_TLM_RAW_FIELD_OFFSET  6
+#define RF_TLM_RAW_FIELD_BYTES   4
+#define RF_TLM_RAW_FIELD_COUNT   6
+#define RF_TLM_RAW_DT_OFFSET     30
+#define RF_TLM_RAW_FRAME_BYTES   32
+
+/*
+** Frames other than raw ones start with a type byte at or above
+** RF_TLM_FRAME_TYPE_MIN. V1 message IDs keep AppID_H below it, so the
+** first byte alone tells the frame kinds apart.
+*/
+#define RF_TLM_FRAME_TYPE_MIN 0xF0
+#define RF_TLM_FRAME_TIMEREF  0xF1 /* Full CFE time reference */
+#define RF_TLM_FRAME_PACKED   0xF2 /* Bit-packed fields, see rf_tlm_pack.h */
+#define RF_TLM_FRAME_ACK      0xF3 /* Uplink command acknowledgement */
+#define RF_TLM_FRAME_FRAGMENT 0xF4 /* Piece of a whole software bus message */
+#define RF_TLM_FRAME_TEST     0xF5 /* Link test filler */
+#define RF_TLM_FRAME_SUMMARY  0xF6 /* Statistics of one field over a window */
+#define RF_TLM_FRAME_EVENT    0xF7 /* Flight software event, see RF_TLM_EVENT_APP_LIST */
+#define RF_TLM_FRAME_LZ       0xF8 /* Piece of a compressed block of frames */
+
+/*
+** Time reference frame
+**
+**   [0]      RF_TLM_FRAME_TIMEREF
+**   [1..2]   sequence number
+**   [3..6]   CFE time seconds
+**   [7..10]  CFE time subseconds
+*/
+#define RF_TLM_TIMEREF_SEQ_OFFSET     1
+#define RF_TLM_TIMEREF_SECONDS_OFFSET 3
+#define RF_TLM_TIMEREF_SUBSECS_OFFSET 7
+#define RF_TLM_TIMEREF_FRAME_BYTES    11
+
+/*
+** Packed frame
+**
+**   [0]      RF_TLM_FRAME_PACKED
+**   [1]      schema ID, index into RF_TLM_Schemas
+**   [2..3]   sequence number
+**   [4..5]   sample time, ms after the time reference
+**   [6..]    bit-packed counters and fields, MSB first, zero padded
+*/
+#define RF_TLM_PACKED_SCHEMA_OFFSET 1
+#define RF_TLM_PACKED_SEQ_OFFSET    2
+#define RF_TLM_PACKED_DT_OFFSET     4
+#define RF_TLM_PACKED_BITS_OFFSET   6
+
+/*
+** Uplink command acknowledgement
+**
+**   [0]      RF_TLM_FRAME_ACK
+**   [1..2]   sequence number
+**   [3..4]   time the command was handled, ms after the time reference
+**   [5]      uplink sequence number of the command
+**   [6]      RF_TLM_ACK_* status
+**   [7..8]   ms from radio receipt on the uC to publication on the bus
+*/
+#define RF_TLM_ACK_SEQ_OFFSET        1
+#define RF_TLM_ACK_DT_OFFSET         3
+#define RF_TLM_ACK_UPLINK_SEQ_OFFSET 5
+#define RF_TLM_ACK_STATUS_OFFSET     6
+#define RF_TLM_ACK_LATENCY_OFFSET    7
+#define RF_TLM_ACK_FRAME_BYTES       9
+
+#define RF_TLM_ACK_ACCEPTED     0 /* Published on the software bus */
+#define RF_TLM_ACK_BAD_LENGTH   1 /* Length outside a command packet or not matching its header */
+#define RF_TLM_ACK_NOT_COMMAND  2 /* Packet is not a command */
+#define RF_TLM_ACK_BAD_CHECKSUM 3 /* Secondary header checksum mismatch */
+#define RF_TLM_ACK_BUS_ERROR    4 /* Software bus refused the packet */
+
+/*
+** Fragment of a software bus message too large for one frame. The message
+** is cut into RF_TLM_FRAG_DATA_BYTES pieces, all but the last one full;
+** the ground puts them back together by message number and index.
+**
+**   [0]      RF_TLM_FRAME_FRAGMENT
+**   [1..2]   sequence number
+**   [3..4]   sample time, ms after the time reference
+**   [5]      message number, rolling, shared by all fragments of a message
+**   [6]      fragment index, 0 first
+**   [7]      fragment count
+**   [8..]    message bytes
+*/
+#define RF_TLM_FRAG_SEQ_OFFSET    1
+#define RF_TLM_FRAG_DT_OFFSET     3
+#define RF_TLM_FRAG_MSGNUM_OFFSET 5
+#define RF_TLM_FRAG_INDEX_OFFSET  6
+#define RF_TLM_FRAG_COUNT_OFFSET  7
+#define RF_TLM_FRAG_HDR_BYTES     8
+#define RF_TLM_FRAG_FRAME_BYTES   32
+#define RF_TLM_FRAG_DATA_BYTES    (RF_TLM_FRAG_FRAME_BYTES - RF_TLM_FRAG_HDR_BYTES)
+#define RF_TLM_FRAG_MAX_COUNT     255
+#define RF_TLM_FRAG_MAX_MSG_BYTES (RF_TLM_FRAG_MAX_COUNT * RF_TLM_FRAG_DATA_BYTES)
+
+/*
+** Link test frame, sent back to back or at a set rate by a link test run.
+** Test frames do not take part in the link sequence; they carry their own,
+** and a filler the ground can check for corruption.
+**
+**   [0]      RF_TLM_FRAME_TEST
+**   [1]      run number
+**   [2..5]   test sequence number, 0 first
+**   [6..]    filler, byte i of the frame is (sequence + i) & 0xFF
+*/
+#define RF_TLM_TEST_RUN_OFFSET 1
+#define RF_TLM_TEST_SEQ_OFFSET 2
+#define RF_TLM_TEST_HDR_BYTES  6
+#define RF_TLM_TEST_MAX_BYTES  32
+
+/*
+** Summary of one field of a summarized source over a window, sent in place
+** of the raw samples. A window with several summarized fields yields one
+** frame per field, all with the same window number. Statistics are
+** engineering values as IEEE float32; NaN samples only count towards Last,
+** and min, max and mean are NaN when every sample was.
+**
+**   [0]      RF_TLM_FRAME_SUMMARY
+**   [1]      schema ID, index into RF_TLM_Schemas
+**   [2..3]   sequence number
+**   [4..5]   time of the last sample, ms after the time reference
+**   [6]      field index, 0..5
+**   [7]      window number, rolling
+**   [8..9]   samples in the window
+**   [10..11] ms from the first to the last sample
+**   [12..15] minimum
+**   [16..19] maximum
+**   [20..23] mean
+**   [24..27] last value
+*/
+#define RF_TLM_SUMMARY_SCHEMA_OFFSET 1
+#define RF_TLM_SUMMARY_SEQ_OFFSET    2
+#define RF_TLM_SUMMARY_DT_OFFSET     4
+#define RF_TLM_SUMMARY_FIELD_OFFSET  6
+#define RF_TLM_SUMMARY_WINDOW_OFFSET 7
+#define RF_TLM_SUMMARY_COUNT_OFFSET  8
+#define RF_TLM_SUMMARY_SPAN_OFFSET   10
+#define RF_TLM_SUMMARY_MIN_OFFSET    12
+#define RF_TLM_SUMMARY_MAX_OFFSET    16
+#define RF_TLM_SUMMARY_MEAN_OFFSET   20
+#define RF_TLM_SUMMARY_LAST_OFFSET   24
+#define RF_TLM_SUMMARY_FRAME_BYTES   28
+
+/*
+** Flight software event, sent ahead of every queued frame. The text is
+** not sent: the app is a code, its index in RF_TLM_EVENT_APP_LIST, and
+** the first numbers in the text travel as arguments.
+**
+**   [0]      RF_TLM_FRAME_EVENT
+**   [1..2]   sequence number
+**   [3..4]   event time, ms after the time reference
+**   [5]      app code, RF_TLM_EVENT_APP_OTHER for apps not in the list
+**   [6]      event type, 1 debug .. 4 critical
+**   [7..8]   event ID
+**   [9]      events the lane has dropped so far, rolling
+**   [10]     argument count
+**   [11..]   arguments, 4 bytes each, signed or unsigned as in the text
+*/
+#define RF_TLM_EVENT_SEQ_OFFSET     1
+#define RF_TLM_EVENT_DT_OFFSET      3
+#define RF_TLM_EVENT_APP_OFFSET     5
+#define RF_TLM_EVENT_TYPE_OFFSET    6
+#define RF_TLM_EVENT_EID_OFFSET     7
+#define RF_TLM_EVENT_DROPPED_OFFSET 9
+#define RF_TLM_EVENT_ARGC_OFFSET    10
+#define RF_TLM_EVENT_HDR_BYTES      11
+#define RF_TLM_EVENT_MAX_ARGS       3
+#define RF_TLM_EVENT_APP_OTHER      0xFF
+
+/*
+** Compressed block. With compression on, the frames of a send cycle are
+** laid in a block as records, a length byte and the frame as it would
+** have been sent, and the block is compressed on its own and cut into
+** pieces. A block that does not shrink is sent stored. Every block starts
+** a new dictionary, so a lost piece loses its block and nothing after it.
+**
+**   [0]      RF_TLM_FRAME_LZ
+**   [1]      block number, rolling
+**   [2]      bits 0..5 piece index, bit 6 block stored, bit 7 last piece
+**   [3..]    block bytes
+**
+** The compressed stream is LZSS: a flag byte before every eight items, bit
+** i set when item i is a match. A literal is one byte; a match is two, the
+** distance back - 1 and the length - RF_TLM_LZ_MIN_MATCH.
+*/
+#define RF_TLM_LZ_BLOCK_NUM_OFFSET 1
+#define RF_TLM_LZ_INFO_OFFSET      2
+#define RF_TLM_LZ_HDR_BYTES        3
+#define RF_TLM_LZ_INDEX_MASK       0x3F
+#define RF_TLM_LZ_STORED           0x40
+#define RF_TLM_LZ_LAST             0x80
+#define RF_TLM_LZ_FRAME_BYTES      32
+#define RF_TLM_LZ_PIECE_BYTES      (RF_TLM_LZ_FRAME_BYTES - RF_TLM_LZ_HDR_BYTES)
+#define RF_TLM_LZ_BLOCK_BYTES      256 /* Uncompressed, so a match distance fits a byte */
+#define RF_TLM_LZ_MIN_MATCH        3
+#define RF_TLM_LZ_MAX_MATCH        (RF_TLM_LZ_MIN_MATCH + 255)
+
+/*
+** Uplink frame, read from the uC mailbox in two transfers: the header,
+** then the command packet, whose read frees the mailbox slot.
+**
+**   [0]      length of the command packet, 0 when nothing is pending
+**   [1]      uplink sequence number, set by the uC
+**   [2..3]   ms since the uC received the frame from the radio
+**   [4..]    CCSDS command packet
+*/
+#define RF_TLM_UPLINK_LEN_OFFSET  0
+#define RF_TLM_UPLINK_SEQ_OFFSET  1
+#define RF_TLM_UPLINK_AGE_OFFSET  2
+#define RF_TLM_UPLINK_HDR_BYTES   4
+#define RF_TLM_UPLINK_FRAME_BYTES 32
+#define RF_TLM_UPLINK_MAX_CMD_BYTES (RF_TLM_UPLINK_FRAME_BYTES - RF_TLM_UPLINK_HDR_BYTES)
+
+/*
+** CCSDS framing. Each frame above travels as the user data of one space
+** packet (CCSDS 133.0-B), with the APID of its source, or
+** RF_TLM_CCSDS_LINK_APID for time references and acknowledgements.
+** Packets are laid end to end in fixed-length TM transfer frames
+** (CCSDS 132.0-B), one I2C write each, and may run on into the next frame.
+** A frame left partly filled when the queues run dry is completed with an
+** idle packet.
+**
+** Space packet
+**
+**   [0..1]   version 0, type 0, no secondary header, APID
+**   [2..3]   sequence flags 3 (unsegmented), sequence count of the APID
+**   [4..5]   user data bytes - 1
+**   [6..]    the frame
+**
+** TM transfer frame
+**
+**   [0..1]   version 0, spacecraft ID, virtual channel ID, no OCF
+**   [2]      master channel frame count
+**   [3]      virtual channel frame count
+**   [4..5]   data field status: synchronous packets, segment length ID 3,
+**            offset of the first packet header in the data field
+**   [6..29]  packet bytes
+**   [30..31] frame error control, RF_TLM_Frame_Crc16() of bytes 0..29
+*/
+#define RF_TLM_SP_HDR_BYTES       6
+#define RF_TLM_SP_SEQ_OFFSET      2
+#define RF_TLM_SP_LEN_OFFSET      4
+#define RF_TLM_SP_APID_MASK       0x07FF
+#define RF_TLM_SP_SEQ_MASK        0x3FFF
+#define RF_TLM_SP_SEQ_UNSEGMENTED 0xC000
+#define RF_TLM_SP_IDLE_APID       0x07FF
+#define RF_TLM_SP_IDLE_FILL       0x55
+#define RF_TLM_SP_MIN_BYTES       (RF_TLM_SP_HDR_BYTES + 1)
+
+#define RF_TLM_TM_MCCOUNT_OFFSET 2
+#define RF_TLM_TM_VCCOUNT_OFFSET 3
+#define RF_TLM_TM_DFS_OFFSET     4
+#define RF_TLM_TM_HDR_BYTES      6
+#define RF_TLM_TM_FECF_BYTES     2
+#define RF_TLM_TM_FRAME_BYTES    32
+#define RF_TLM_TM_DATA_BYTES     (RF_TLM_TM_FRAME_BYTES - RF_TLM_TM_HDR_BYTES - RF_TLM_TM_FECF_BYTES)
+#define RF_TLM_TM_SCID_MAX       0x03FF
+#define RF_TLM_TM_VCID_MAX       7
+#define RF_TLM_TM_DFS_STATIC     0x1800 /* Segment length ID 3, the rest 0 */
+#define RF_TLM_TM_FHP_MASK       0x07FF
+#define RF_TLM_TM_FHP_NONE       0x07FF /* No packet starts in the frame */
+
+/*
+** Frame identification word of a virtual channel, bytes 0..1 of its frames
+*/
+#define RF_TLM_TM_FRAME_ID(Scid, Vcid) ((uint16_t)(((Scid) << 4) | ((Vcid) << 1)))
+
+/*
+** Largest time delta a frame can carry
+*/
+#define RF_TLM_DT_MAX_MSEC 0xFFFF
+
+void     RF_TLM_Frame_PutU16(uint8_t *Dst, uint16_t Value);
+void     RF_TLM_Frame_PutU32(uint8_t *Dst, uint32_t Value);
+uint16_t RF_TLM_Frame_GetU16(const uint8_t *Src);
+uint32_t RF_TLM_Frame_GetU32(const uint8_t *Src);
+int      RF_TLM_Frame_SeqOffset(const uint8_t *Frame, uint16_t Len);
+int      RF_TLM_Frame_DtOffset(const uint8_t *Frame, uint16_t Len);
+uint16_t RF_TLM_Frame_FragCount(uint16_t MsgLen);
+uint16_t RF_TLM_Frame_BuildFragment(uint8_t *Out, const uint8_t *Msg, uint16_t MsgLen, uint8_t MsgNum, uint8_t Index);
+void     RF_TLM_Frame_BuildTest(uint8_t *Out, uint16_t Len, uint8_t Run, uint32_t Seq);
+int      RF_TLM_Frame_CheckTest(const uint8_t *Frame, uint16_t Len);
+uint16_t RF_TLM_Frame_Crc16(const uint8_t *Data, uint16_t Len);
+uint16_t RF_TLM_Frame_Compress(uint8_t *Out, const uint8_t *In, uint16_t InLen);
+uint16_t RF_TLM_Frame_Expand(uint8_t *Out, uint16_t OutMax, const uint8_t *In, uint16_t InLen);
+
+#endif /* RF_TLM_FRAME_H */
@@ -0,0 +1,316 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * \file
+ *   Link throughput test for the RF Telemetry Output App.
+ *
+ *   A run sends RF_TLM_FRAME_TEST frames to the uC for a set duration,
+ *   either at a set rate or back to back, and times every transfer. The
+ *   results go out in a link test packet when the run ends: frames and
+ *   bytes per second achieved, transfer latency range, mean and
+ *   distribution, and errors. The ground checks the sequence and filler of
+ *   the frames it receives, which gives the loss and corruption of the path
+ *   past the uC.
+ *
+ *   Telemetry stays queued while a run is in progress. Uplink polls and
+ *   commands are still serviced, so a run can be stopped from the ground.
+ *
+ *   Test frames take the link as telemetry does: they are held while the
+ *   downlink is off or suppressed, outside a contact window and outside a
+ *   send slot or within its guard time. Frames that fall due while held
+ *   are skipped rather than sent back to back later, and the held time
+ *   counts in the run duration.
+ */
+
+#include <string.h>
+
+#include "rf_tlm_events.h"
+#include "rf_tlm.h"
+
+/*
+** Upper bound of the first latency bin, each further bin doubles it
+*/
+#define RF_TLM_LINKTEST_HIST_BASE_USEC 250
+
+/*
+** Account for one transfer
+*/
+static void RF_TLM_LinkTest_Record(uint64 LatencyNs)
+{
+    RF_TLM_LinkTestTlm_Payload_t *Result = &RF_TLM_Data.LinkTest.Tlm.Payload;
+    uint32                        usec   = (uint32)(LatencyNs / 1000u);
+    uint32                        bound  = RF_TLM_LINKTEST_HIST_BASE_USEC;
+    uint8                         bin    = 0;
+
+    while (bin < RF_TLM_LINKTEST_HIST_BINS - 1 && usec >= bound)
+    {
+        bound *= 2;
+        ++bin;
+    }
+    ++Result->LatencyHist[bin];
+
+    if (usec < Result->LatencyMinUsec)
+    {
+        Result->LatencyMinUsec = usec;
+    }
+    if (usec > Result->LatencyMaxUsec)
+    {
+        Result->LatencyMaxUsec = usec;
+    }
+    RF_TLM_Data.LinkTest.LatencySumNs += LatencyNs;
+}
+
+/*
+** Whether the downlink is closed to all frames, slots aside
+*/
+static bool RF_TLM_LinkTest_Held(void)
+{
+    return RF_TLM_Data.suppress_sendto || !RF_TLM_Data.downlink_on || !RF_TLM_Contact_Open();
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_LinkTest_Init() -- Clear the results packet              */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void RF_TLM_LinkTest_Init(void)
+{
+    memset(&RF_TLM_Data.LinkTest, 0, sizeof(RF_TLM_Data.LinkTest));
+
+    CFE_MSG_Init(CFE_MSG_PTR(RF_TLM_Data.LinkTest.Tlm.TelemetryHeader), CFE_SB_ValueToMsgId(RF_TLM_LINKTEST_TLM_MID),
+                 sizeof(RF_TLM_Data.LinkTest.Tlm));
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_LinkTest_Start() -- Check a request and start a run,     */
+/*                            false if it was refused              */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+bool RF_TLM_LinkTest_Start(const RF_TLM_LinkTest_Payload_t *Request)
+{
+    RF_TLM_LinkTest_t            *Test   = &RF_TLM_Data.LinkTest;
+    RF_TLM_LinkTestTlm_Payload_t *Result = &Test->Tlm.Payload;
+
+    if (Test->Active)
+    {
+        CFE_EVS_SendEvent(RF_TLM_LINKTEST_ERR_EID, CFE_EVS_EventType_ERROR, "RF TLM: Link test %u already running",
+                          (unsigned int)Test->Run);
+        return false;
+    }
+
+    if (Request->DurationMsec > RF_TLM_LINKTEST_MAX_MSEC || Request->RateHz > RF_TLM_LINKTEST_MAX_HZ ||
+        Request->FrameBytes < RF_TLM_TEST_HDR_BYTES || Request->FrameBytes > RF_TLM_TEST_MAX_BYTES)
+    {
+        CFE_EVS_SendEvent(RF_TLM_LINKTEST_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "RF TLM: Invalid link test, %u ms at %u Hz, %u byte frames",
+                          (unsigned int)Request->DurationMsec, (unsigned int)Request->RateHz,
+                          (unsigned int)Request->FrameBytes);
+        return false;
+    }
+
+    if (!RF_TLM_Dev_IsReady())
+    {
+        CFE_EVS_SendEvent(RF_TLM_LINKTEST_ERR_EID, CFE_EVS_EventType_ERROR, "RF TLM: Link test needs the uC ready");
+        return false;
+    }
+
+    ++Test->Run;
+    Test->Active       = true;
+    Test->Errors       = 0;
+    Test->Seq          = 0;
+    Test->LatencySumNs = 0;
+    Test->StartNs      = uC_monotonic_ns();
+    Test->EndNs        = Test->StartNs + (uint64)Request->DurationMsec * 1000000u;
+    Test->NextNs       = Test->StartNs;
+    Test->IntervalNs   = (Request->RateHz == 0) ? 0 : 1000000000u / Request->RateHz;
+
+    memset(Result, 0, sizeof(*Result));
+    Result->Run            = Test->Run;
+    Result->State          = RF_TLM_LINKTEST_RUNNING;
+    Result->FrameBytes     = Request->FrameBytes;
+    Result->RateHz         = Request->RateHz;
+    Result->DurationMsec   = Request->DurationMsec;
+    Result->LatencyMinUsec = UINT32_MAX;
+
+    CFE_EVS_SendEvent(RF_TLM_LINKTEST_INF_EID, CFE_EVS_EventType_INFORMATION,
+                      "RF TLM: Link test %u started, %u ms at %u Hz, %u byte frames", (unsigned int)Test->Run,
+                      (unsigned int)Request->DurationMsec, (unsigned int)Request->RateHz,
+                      (unsigned int)Request->FrameBytes);
+
+    return true;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_LinkTest_Stop() -- End the run and send its results      */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void RF_TLM_LinkTest_Stop(uint8 State)
+{
+    RF_TLM_LinkTest_t            *Test   = &RF_TLM_Data.LinkTest;
+    RF_TLM_LinkTestTlm_Payload_t *Result = &Test->Tlm.Payload;
+    uint32                        transfers;
+
+    if (!Test->Active)
+    {
+        return;
+    }
+
+    Test->Active        = false;
+    Result->State       = State;
+    Result->ElapsedMsec = (uint32)((uC_monotonic_ns() - Test->StartNs) / 1000000u);
+
+    if (Result->ElapsedMsec > 0)
+    {
+        Result->FramesPerSec = (uint32)((uint64)Result->FramesSent * 1000u / Result->ElapsedMsec);
+        Result->BytesPerSec  = (uint32)((uint64)Result->BytesSent * 1000u / Result->ElapsedMsec);
+    }
+
+    transfers = Result->FramesSent + Result->FramesFailed;
+    if (transfers > 0)
+    {
+        Result->LatencyMeanUsec = (uint32)(Test->LatencySumNs / transfers / 1000u);
+    }
+    else
+    {
+        Result->LatencyMinUsec = 0;
+    }
+
+    CFE_SB_TimeStampMsg(CFE_MSG_PTR(Test->Tlm.TelemetryHeader));
+    CFE_SB_TransmitMsg(CFE_MSG_PTR(Test->Tlm.TelemetryHeader), true);
+
+    CFE_EVS_SendEvent((State == RF_TLM_LINKTEST_FAILED) ? RF_TLM_LINKTEST_ERR_EID : RF_TLM_LINKTEST_INF_EID,
+                      (State == RF_TLM_LINKTEST_FAILED) ? CFE_EVS_EventType_ERROR : CFE_EVS_EventType_INFORMATION,
+                      "RF TLM: Link test %u %s after %u ms, %u frames/s, %u B/s, %u errors, latency %u/%u/%u us",
+                      (unsigned int)Result->Run,
+                      (State == RF_TLM_LINKTEST_DONE) ? "done" : (State == RF_TLM_LINKTEST_STOPPED) ? "stopped" : "failed",
+                      (unsigned int)Result->ElapsedMsec, (unsigned int)Result->FramesPerSec,
+                      (unsigned int)Result->BytesPerSec, (unsigned int)Result->FramesFailed,
+                      (unsigned int)Result->LatencyMinUsec, (unsigned int)Result->LatencyMeanUsec,
+                      (unsigned int)Result->LatencyMaxUsec);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_LinkTest_Step() -- Send the frames due, in place of the  */
+/*                           telemetry, while a run is active      */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void RF_TLM_LinkTest_Step(void)
+{
+    RF_TLM_LinkTest_t            *Test   = &RF_TLM_Data.LinkTest;
+    RF_TLM_LinkTestTlm_Payload_t *Result = &Test->Tlm.Payload;
+    uint8                         frame[RF_TLM_TEST_MAX_BYTES];
+    uint8                        *val = frame;
+    uint64                        now;
+    uint64                        burst_end;
+    uint64                        start;
+    int                           rv;
+
+    if (!Test->Active)
+    {
+        return;
+    }
+
+    if (!RF_TLM_Dev_IsReady())
+    {
+        RF_TLM_LinkTest_Stop(RF_TLM_LINKTEST_FAILED);
+        return;
+    }
+
+    now       = uC_monotonic_ns();
+    burst_end = now + (uint64)RF_TLM_LINKTEST_BURST_MSEC * 1000000u;
+
+    while (now < Test->EndNs && now < burst_end && now >= Test->NextNs)
+    {
+        /* Held frames are skipped: the next one is due when the link opens again */
+        if (RF_TLM_LinkTest_Held())
+        {
+            Test->NextNs = now;
+            break;
+        }
+        if (!RF_TLM_Slot_Open())
+        {
+            Test->NextNs = now + (uint64)RF_TLM_Slot_WaitMsec((uint32)((Test->EndNs - now) / 1000000u)) * 1000000u;
+            break;
+        }
+
+        RF_TLM_Frame_BuildTest(frame, Result->FrameBytes, Test->Run, Test->Seq);
+
+        start = now;
+        rv    = uC_set_bytes(UC_ADDRESS, &val, Result->FrameBytes);
+        now   = uC_monotonic_ns();
+        RF_TLM_LinkTest_Record(now - start);
+        RF_TLM_Slot_Released(now - start);
+
+        /* Frames are sent at their due time; a rate the bus cannot keep up with runs back to back */
+        Test->NextNs += Test->IntervalNs;
+
+        if (rv < 0)
+        {
+            ++Result->FramesFailed;
+            if (++Test->Errors >= RF_TLM_LINKTEST_MAX_ERRORS)
+            {
+                RF_TLM_LinkTest_Stop(RF_TLM_LINKTEST_FAILED);
+                RF_TLM_Dev_Lost();
+                return;
+            }
+            continue;
+        }
+
+        Test->Errors = 0;
+        ++Test->Seq;
+        ++Result->FramesSent;
+        Result->BytesSent += Result->FrameBytes;
+    }
+
+    if (now >= Test->EndNs)
+    {
+        RF_TLM_LinkTest_Stop(RF_TLM_LINKTEST_DONE);
+    }
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_LinkTest_WaitMsec() -- How long the run loop may pend    */
+/*                               before the next test frame is due */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+uint32 RF_TLM_LinkTest_WaitMsec(uint32 MaxMsec)
+{
+    RF_TLM_LinkTest_t *Test = &RF_TLM_Data.LinkTest;
+    uint64             now;
+    uint64             due;
+
+    if (!Test->Active)
+    {
+        return MaxMsec;
+    }
+
+    /* While held, the contact window or a command reopens the link; only the end of the run is due */
+    now = uC_monotonic_ns();
+    due = (Test->NextNs < Test->EndNs && !RF_TLM_LinkTest_Held()) ? Test->NextNs : Test->EndNs;
+    if (due <= now)
+    {
+        return 0;
+    }
+
+    return ((due - now) / 1000000u < MaxMsec) ? (uint32)((due - now) / 1000000u) : MaxMsec;
+}
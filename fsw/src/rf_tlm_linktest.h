@@ -0,0 +1,63 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ * Link throughput test for the RF Telemetry Output App
+ */
+
+#ifndef RF_TLM_LINKTEST_H
+#define RF_TLM_LINKTEST_H
+
+#include "cfe.h"
+
+#include "rf_tlm_msg.h"
+
+/*
+** A back to back run hands the loop back after this long, so commands and
+** uplink polls are still serviced
+*/
+#define RF_TLM_LINKTEST_BURST_MSEC 50
+
+/*
+** Consecutive transfer errors that end a run and mark the uC lost
+*/
+#define RF_TLM_LINKTEST_MAX_ERRORS 8
+
+typedef struct
+{
+    bool                 Active;       /**< \brief A run is in progress */
+    uint8                Run;          /**< \brief Number of the last run started */
+    uint8                Errors;       /**< \brief Consecutive transfer errors */
+    uint32               Seq;          /**< \brief Sequence number of the next test frame */
+    uint64               StartNs;      /**< \brief Run start, monotonic */
+    uint64               EndNs;        /**< \brief Run end, monotonic */
+    uint64               NextNs;       /**< \brief Time the next frame is due at a set rate */
+    uint64               IntervalNs;   /**< \brief Time between frames at a set rate, 0 back to back */
+    uint64               LatencySumNs; /**< \brief Sum of the transfer times */
+    RF_TLM_LinkTestTlm_t Tlm;          /**< \brief Results of the run in progress or the last one */
+} RF_TLM_LinkTest_t;
+
+void   RF_TLM_LinkTest_Init(void);
+bool   RF_TLM_LinkTest_Start(const RF_TLM_LinkTest_Payload_t *Request);
+void   RF_TLM_LinkTest_Stop(uint8 State);
+void   RF_TLM_LinkTest_Step(void);
+uint32 RF_TLM_LinkTest_WaitMsec(uint32 MaxMsec);
+
+#endif /* RF_TLM_LINKTEST_H */
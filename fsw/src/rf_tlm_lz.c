@@ -0,0 +1,244 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * \file
+ *   Downlink compression of the RF Telemetry Output App.
+ *
+ *   With compression on, RF_TLM_transmit() lays each frame in a block as a
+ *   record instead of writing it. RF_TLM_send_queued() flushes the block
+ *   at the end of each send cycle, and a block that fills up is flushed
+ *   early: it is compressed with RF_TLM_Frame_Compress() and cut into
+ *   RF_TLM_FRAME_LZ pieces, which go to the uC as frames of their own,
+ *   unframed or as link stream packets. Layout in rf_tlm_frame.h.
+ *
+ *   Each piece is written only in an open slot. The pieces the slot does
+ *   not leave room for, or that the uC refused, wait for the next slot
+ *   and go before any new frame. The frames of a block are accounted as
+ *   sent once its last piece is written (RF_TLM_frames_written()).
+ *
+ *   Blocks are compressed independently, so the ground can decode any
+ *   block whose pieces all arrived. The work buffers are static; the match
+ *   search uses about 1 KiB of stack.
+ */
+
+#include <string.h>
+
+#include "rf_tlm_events.h"
+#include "rf_tlm.h"
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_Lz_Write() -- Hand one piece to the framing in use,      */
+/*                      Token is accounted once it is written      */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static int32 RF_TLM_Lz_Write(RF_TLM_Frame_t *Piece, uint32 Token)
+{
+    int32 status;
+
+    if (RF_TLM_Data.Ccsds.Mode == RF_TLM_FRAMING_CCSDS)
+    {
+        return RF_TLM_Ccsds_Put(Piece, RF_TLM_CCSDS_LINK_STREAM, Token);
+    }
+
+    status = RF_TLM_write_frame(Piece);
+    if (status >= 0 && Token != 0)
+    {
+        RF_TLM_frames_written(Token);
+    }
+
+    return status;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_Lz_Init() -- Startup compression mode                    */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void RF_TLM_Lz_Init(void)
+{
+    memset(&RF_TLM_Data.Lz, 0, sizeof(RF_TLM_Data.Lz));
+    RF_TLM_Data.Lz.Mode = RF_TLM_COMPRESS_DEFAULT;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_Lz_Configure() -- Set the compression mode, returns the  */
+/*                          frames of pending blocks that could    */
+/*                          not be sent                            */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+uint16 RF_TLM_Lz_Configure(uint8 Mode)
+{
+    RF_TLM_Lz_t *Lz      = &RF_TLM_Data.Lz;
+    uint16       dropped = 0;
+
+    if ((Lz->Fill != 0 || Lz->SendPos < Lz->SendLen) && RF_TLM_Dev_IsReady() && RF_TLM_Slot_Open())
+    {
+        RF_TLM_Lz_Flush();
+    }
+    if (Lz->Fill != 0 || Lz->SendPos < Lz->SendLen)
+    {
+        dropped = (uint16)(Lz->Records + ((Lz->SendPos < Lz->SendLen) ? Lz->SendRecords : 0));
+        RF_TLM_frames_lost((Lz->Token != 0) ? Lz->Token : Lz->SendToken);
+        Lz->Fill    = 0;
+        Lz->Records = 0;
+        Lz->Token   = 0;
+        Lz->SendLen = 0;
+        Lz->SendPos = 0;
+    }
+
+    Lz->Mode = Mode;
+
+    return dropped;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_Lz_Put() -- Add a frame to the block, flushing the block */
+/*                    first when the frame does not fit            */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+int32 RF_TLM_Lz_Put(const RF_TLM_Frame_t *Frame, uint32 Token)
+{
+    RF_TLM_Lz_t *Lz = &RF_TLM_Data.Lz;
+
+    /* The flush frees the block even when its pieces have to wait, unless an older block is still being sent */
+    if (Lz->Fill + 1u + Frame->Length > RF_TLM_LZ_BLOCK_BYTES)
+    {
+        RF_TLM_Lz_Flush();
+        if (Lz->Fill != 0)
+        {
+            return RF_TLM_LZ_HELD;
+        }
+    }
+
+    Lz->Raw[Lz->Fill++] = (uint8)Frame->Length;
+    memcpy(&Lz->Raw[Lz->Fill], Frame->Data, Frame->Length);
+    Lz->Fill += Frame->Length;
+    ++Lz->Records;
+    Lz->Token = Token;
+
+    return 0;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_Lz_Flush() -- Compress the block and write its pieces    */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+int32 RF_TLM_Lz_Flush(void)
+{
+    RF_TLM_Lz_t *Lz = &RF_TLM_Data.Lz;
+    uint64       start;
+    uint16       len;
+
+    /* One block is sent at a time */
+    if (!RF_TLM_Lz_Drain())
+    {
+        return RF_TLM_LZ_HELD;
+    }
+
+    if (Lz->Fill == 0)
+    {
+        return 0;
+    }
+
+    start         = uC_monotonic_ns();
+    len           = RF_TLM_Frame_Compress(Lz->Packed, Lz->Raw, Lz->Fill);
+    Lz->FrameNsec = (uint32)((uC_monotonic_ns() - start) / Lz->Records);
+    if (Lz->FrameNsec > Lz->FrameNsecMax)
+    {
+        Lz->FrameNsecMax = Lz->FrameNsec;
+    }
+
+    /* Sent as it is when it does not shrink, the ground only strips the records */
+    Lz->SendInfo = 0;
+    if (len == 0)
+    {
+        memcpy(Lz->Packed, Lz->Raw, Lz->Fill);
+        len          = Lz->Fill;
+        Lz->SendInfo = RF_TLM_LZ_STORED;
+        ++Lz->Stored;
+    }
+
+    Lz->SendLen     = len;
+    Lz->SendPos     = 0;
+    Lz->SendRecords = Lz->Records;
+    Lz->SendBlock   = Lz->Block;
+    Lz->SendToken   = Lz->Token;
+
+    ++Lz->Blocks;
+    Lz->InBytes += (uint32)(Lz->Fill - Lz->Records);
+    ++Lz->Block;
+    Lz->Fill    = 0;
+    Lz->Records = 0;
+    Lz->Token   = 0;
+
+    return RF_TLM_Lz_Drain() ? 0 : RF_TLM_LZ_HELD;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_Lz_Drain() -- Write the pieces of the block being sent,  */
+/*                      true once none is left                     */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+bool RF_TLM_Lz_Drain(void)
+{
+    RF_TLM_Lz_t   *Lz = &RF_TLM_Data.Lz;
+    RF_TLM_Frame_t piece;
+    uint16         n;
+    bool           last;
+
+    memset(&piece, 0, sizeof(piece));
+    piece.Data[0]                          = RF_TLM_FRAME_LZ;
+    piece.Data[RF_TLM_LZ_BLOCK_NUM_OFFSET] = Lz->SendBlock;
+
+    /* Each piece gets its own slot check, a piece is never started in the guard time */
+    while (Lz->SendPos < Lz->SendLen)
+    {
+        if (!RF_TLM_Dev_IsReady() || !RF_TLM_Slot_Open())
+        {
+            return false;
+        }
+
+        n = (uint16)(Lz->SendLen - Lz->SendPos);
+        if (n > RF_TLM_LZ_PIECE_BYTES)
+        {
+            n = RF_TLM_LZ_PIECE_BYTES;
+        }
+        last = (Lz->SendPos + n == Lz->SendLen);
+
+        piece.Data[RF_TLM_LZ_INFO_OFFSET] = (uint8)(Lz->SendInfo | (last ? RF_TLM_LZ_LAST : 0));
+        memcpy(&piece.Data[RF_TLM_LZ_HDR_BYTES], &Lz->Packed[Lz->SendPos], n);
+        piece.Length = (uint16)(RF_TLM_LZ_HDR_BYTES + n);
+
+        if (RF_TLM_Lz_Write(&piece, last ? Lz->SendToken : 0) < 0)
+        {
+            return false;
+        }
+
+        Lz->OutBytes += piece.Length;
+        Lz->SendPos += n;
+        ++Lz->SendInfo;
+    }
+
+    return true;
+}
@@ -0,0 +1,67 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ * Downlink compression of the RF Telemetry Output App
+ */
+
+#ifndef RF_TLM_LZ_H
+#define RF_TLM_LZ_H
+
+#include "cfe.h"
+
+#include "rf_tlm_frame.h"
+#include "rf_tlm_queue.h"
+
+/*
+** Put and flush status while pieces of the last block hold back the output
+*/
+#define RF_TLM_LZ_HELD (-1)
+
+typedef struct
+{
+    uint8  Mode;                           /**< \brief RF_TLM_COMPRESS_* */
+    uint8  Block;                          /**< \brief Number of the block being filled */
+    uint16 Fill;                           /**< \brief Bytes in Raw */
+    uint16 Records;                        /**< \brief Frames in Raw */
+    uint32 Token;                          /**< \brief Newest frame taken into Raw, 0 if none */
+    uint8  Raw[RF_TLM_LZ_BLOCK_BYTES];     /**< \brief Block being filled, length byte and frame per record */
+    uint8  Packed[RF_TLM_LZ_BLOCK_BYTES];  /**< \brief Block being sent, compressed or stored */
+    uint16 SendLen;                        /**< \brief Bytes of Packed to send */
+    uint16 SendPos;                        /**< \brief Bytes of Packed sent, the rest waits for a slot */
+    uint16 SendRecords;                    /**< \brief Frames in the block being sent */
+    uint8  SendBlock;                      /**< \brief Number of the block being sent */
+    uint8  SendInfo;                       /**< \brief Info byte of its next piece */
+    uint32 SendToken;                      /**< \brief Newest frame in the block being sent */
+    uint32 Blocks;                         /**< \brief Blocks sent */
+    uint32 Stored;                         /**< \brief Blocks sent stored */
+    uint32 InBytes;                        /**< \brief Frame bytes taken into blocks */
+    uint32 OutBytes;                       /**< \brief Piece frame bytes written */
+    uint32 FrameNsec;                      /**< \brief Compression time per frame, last block */
+    uint32 FrameNsecMax;                   /**< \brief Compression time per frame, worst block */
+} RF_TLM_Lz_t;
+
+void   RF_TLM_Lz_Init(void);
+uint16 RF_TLM_Lz_Configure(uint8 Mode);
+int32  RF_TLM_Lz_Put(const RF_TLM_Frame_t *Frame, uint32 Token);
+int32  RF_TLM_Lz_Flush(void);
+bool   RF_TLM_Lz_Drain(void);
+
+#endif /* RF_TLM_LZ_H */
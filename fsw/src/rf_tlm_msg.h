@@ -34,6 +34,107 @@
 #define RF_TLM_OUTPUT_DISABLE_CC 3
 #define RF_TLM_DEBUG_ENABLE_CC   4
 #define RF_TLM_DEBUG_DISABLE_CC  5
+#define RF_TLM_SET_RATE_CC       6
+#define RF_TLM_SET_ENCODING_CC   7
+#define RF_TLM_SET_DEADBAND_CC   8
+#define RF_TLM_SET_PROFILE_CC    9
+#define RF_TLM_SET_CPU_BUDGET_CC 10
+#define RF_TLM_SET_SLOTS_CC      11
+#define RF_TLM_LINK_TEST_CC      12
+#define RF_TLM_SET_FRAMING_CC    13
+#define RF_TLM_SET_SUMMARY_CC    14
+#define RF_TLM_SET_EVT_FILTER_CC 15
+#define RF_TLM_SET_COMPRESS_CC   16
+#define RF_TLM_SET_CONTACTS_CC   17
+#define RF_TLM_SNAPSHOT_CC       18
+
+/*
+** Frame encodings
+*/
+#define RF_TLM_ENC_RAW      0 /* Fields at full byte width */
+#define RF_TLM_ENC_PACKED   1 /* Fields bit-packed to their schema widths */
+#define RF_TLM_ENC_FRAGMENT 2 /* Whole message split across fragment frames */
+
+/*
+** Downlink framing modes
+*/
+#define RF_TLM_FRAMING_NATIVE 0 /* Frames written to the uC as they are */
+#define RF_TLM_FRAMING_CCSDS  1 /* Frames wrapped in space packets and TM transfer frames */
+
+/*
+** Downlink compression modes
+*/
+#define RF_TLM_COMPRESS_OFF  0 /* Frames sent as they are */
+#define RF_TLM_COMPRESS_LZSS 1 /* Frames of a send cycle sent as one compressed block */
+
+/*
+** Continuous forwarding of the sources named in a snapshot request
+*/
+#define RF_TLM_SNAP_FWD_KEEP 0 /* Left as it is */
+#define RF_TLM_SNAP_FWD_PULL 1 /* Sent on request only */
+#define RF_TLM_SNAP_FWD_PUSH 2 /* Forwarded again as received */
+
+/*
+** Run loop stages, index of the per-stage utilization in housekeeping
+*/
+#define RF_TLM_STAGE_IDLE    0 /* Pending on the command pipe */
+#define RF_TLM_STAGE_DEV     1 /* uC registration, probing and bus checks */
+#define RF_TLM_STAGE_RECEIVE 2 /* Reading the telemetry pipe */
+#define RF_TLM_STAGE_ENCODE  3 /* Filtering, copying and encoding samples */
+#define RF_TLM_STAGE_UPLINK  4 /* Polling the uC for commands */
+#define RF_TLM_STAGE_SEND    5 /* Scheduling and writing frames to the uC */
+#define RF_TLM_STAGE_EVENT   6 /* Debug events */
+#define RF_TLM_STAGE_COMMAND 7 /* Ground commands and housekeeping */
+#define RF_TLM_STAGE_COUNT   8
+
+/*
+** Maximum number of telemetry sources forwarded over RF
+*/
+#define RF_TLM_MAX_SOURCES 8
+
+/*
+** Length of a link profile name field, including the terminator
+*/
+#define RF_TLM_PROFILE_NAME_LEN 16
+
+/*
+** Transmit windows per slot period, and the longest period
+*/
+#define RF_TLM_MAX_SLOTS            4
+#define RF_TLM_SLOT_MAX_PERIOD_MSEC 60000
+
+/*
+** Ground contact windows per contact table
+*/
+#define RF_TLM_MAX_CONTACTS 8
+
+/*
+** Sources named per snapshot request
+*/
+#define RF_TLM_SNAP_MAX_MIDS 8
+
+/*
+** Event filter type that sends no events of an app
+*/
+#define RF_TLM_EVENT_MUTED 0xFF
+
+/*
+** Longest summary window
+*/
+#define RF_TLM_SUMMARY_MAX_WINDOW_MSEC 600000
+
+/*
+** Link test limits and results
+*/
+#define RF_TLM_LINKTEST_MAX_MSEC  60000 /* Longest run */
+#define RF_TLM_LINKTEST_MAX_HZ    1000  /* Highest set rate, 0 runs as fast as the bus allows */
+#define RF_TLM_LINKTEST_HIST_BINS 8     /* Transfer latency bins, see RF_TLM_LinkTestTlm_Payload_t */
+
+#define RF_TLM_LINKTEST_IDLE    0 /* No run since startup */
+#define RF_TLM_LINKTEST_RUNNING 1
+#define RF_TLM_LINKTEST_DONE    2 /* Ran for the requested duration */
+#define RF_TLM_LINKTEST_STOPPED 3 /* Stopped by command */
+#define RF_TLM_LINKTEST_FAILED  4 /* Stopped after repeated transfer errors */
 
 /*************************************************************************/
 /*
@@ -58,6 +159,238 @@ typedef RF_TLM_NoArgsCmd_t RF_TLM_DisableOutputCmd_t;
 typedef RF_TLM_NoArgsCmd_t RF_TLM_EnableDebugCmd_t;
 typedef RF_TLM_NoArgsCmd_t RF_TLM_DisableDebugCmd_t;
 
+/*
+** Set the decimation and minimum interval of a forwarded source
+*/
+typedef struct
+{
+    CFE_SB_MsgId_Atom_t MsgId;           /**< \brief Source message ID */
+    uint16              Decimation;      /**< \brief Forward every Nth sample, 0 or 1 forwards all */
+    uint16              Spare;
+    uint32              MinIntervalMsec; /**< \brief Minimum time between forwarded samples, 0 disables */
+} RF_TLM_SetRate_Payload_t;
+
+typedef struct
+{
+    CFE_MSG_CommandHeader_t  CmdHeader; /**< \brief Command header */
+    RF_TLM_SetRate_Payload_t Payload;   /**< \brief Command payload */
+} RF_TLM_SetRateCmd_t;
+
+/*
+** Select the frame encoding of a forwarded source
+*/
+typedef struct
+{
+    CFE_SB_MsgId_Atom_t MsgId;    /**< \brief Source message ID */
+    uint8               Encoding; /**< \brief One of RF_TLM_ENC_* */
+    uint8               Spare[3];
+} RF_TLM_SetEncoding_Payload_t;
+
+typedef struct
+{
+    CFE_MSG_CommandHeader_t      CmdHeader; /**< \brief Command header */
+    RF_TLM_SetEncoding_Payload_t Payload;   /**< \brief Command payload */
+} RF_TLM_SetEncodingCmd_t;
+
+/*
+** Set the deadband of one field of a forwarded source. Both thresholds at
+** zero remove the field's rule; HeartbeatMsec applies to the whole source.
+*/
+typedef struct
+{
+    CFE_SB_MsgId_Atom_t MsgId;         /**< \brief Source message ID */
+    uint8               Field;         /**< \brief Byte group index, 0..5 */
+    uint8               Spare[3];
+    float               AbsThreshold;  /**< \brief Absolute change sent, 0 disables */
+    float               RelThreshold;  /**< \brief Change relative to the last sent value, 0 disables */
+    uint32              HeartbeatMsec; /**< \brief Send at least this often, 0 disables */
+} RF_TLM_SetDeadband_Payload_t;
+
+typedef struct
+{
+    CFE_MSG_CommandHeader_t      CmdHeader; /**< \brief Command header */
+    RF_TLM_SetDeadband_Payload_t Payload;   /**< \brief Command payload */
+} RF_TLM_SetDeadbandCmd_t;
+
+/*
+** Switch to a named link profile, see rf_tlm_profile.c
+*/
+typedef struct
+{
+    char Name[RF_TLM_PROFILE_NAME_LEN]; /**< \brief Profile name, zero padded */
+} RF_TLM_SetProfile_Payload_t;
+
+typedef struct
+{
+    CFE_MSG_CommandHeader_t     CmdHeader; /**< \brief Command header */
+    RF_TLM_SetProfile_Payload_t Payload;   /**< \brief Command payload */
+} RF_TLM_SetProfileCmd_t;
+
+/*
+** Set the share of the core the app may use before raising an event
+*/
+typedef struct
+{
+    uint16 BudgetPermille; /**< \brief Active share allowed, 0 disables the check */
+    uint16 Spare;
+} RF_TLM_SetCpuBudget_Payload_t;
+
+typedef struct
+{
+    CFE_MSG_CommandHeader_t       CmdHeader; /**< \brief Command header */
+    RF_TLM_SetCpuBudget_Payload_t Payload;   /**< \brief Command payload */
+} RF_TLM_SetCpuBudgetCmd_t;
+
+/*
+** Slot table: frames are only released inside the windows, which repeat
+** every PeriodMsec of CFE time
+*/
+typedef struct
+{
+    uint16 OffsetMsec; /**< \brief Window start from the period boundary */
+    uint16 LengthMsec; /**< \brief Window length, 0 ends the list */
+} RF_TLM_SlotWindow_t;
+
+typedef struct
+{
+    uint32              PeriodMsec;                /**< \brief Slot period, 0 leaves the output free running */
+    uint16              GuardMsec;                 /**< \brief No frame is started this close to a window end */
+    uint16              Spare;
+    RF_TLM_SlotWindow_t Windows[RF_TLM_MAX_SLOTS]; /**< \brief In time order, not overlapping */
+} RF_TLM_SlotTable_t;
+
+typedef struct
+{
+    CFE_MSG_CommandHeader_t CmdHeader; /**< \brief Command header */
+    RF_TLM_SlotTable_t      Payload;   /**< \brief Command payload */
+} RF_TLM_SetSlotsCmd_t;
+
+/*
+** Contact table: the times a ground station is expected to hear the
+** downlink, in CFE time. Frames are held outside the windows and sent
+** inside them. An empty table sends whenever the link is up.
+*/
+typedef struct
+{
+    uint32 StartSec;  /**< \brief Window start, CFE time seconds */
+    uint32 LengthSec; /**< \brief Window length, 0 ends the list */
+} RF_TLM_ContactWindow_t;
+
+typedef struct
+{
+    uint16                 IntervalMsec; /**< \brief Send interval inside the windows, 0 keeps the profile's */
+    uint16                 Spare;
+    uint32                 SummaryMsec;  /**< \brief Summary window outside the windows, 0 holds samples raw */
+    RF_TLM_ContactWindow_t Windows[RF_TLM_MAX_CONTACTS]; /**< \brief In time order, not overlapping */
+} RF_TLM_ContactTable_t;
+
+typedef struct
+{
+    CFE_MSG_CommandHeader_t CmdHeader; /**< \brief Command header */
+    RF_TLM_ContactTable_t   Payload;   /**< \brief Command payload */
+} RF_TLM_SetContactsCmd_t;
+
+/*
+** Send the latest sample of each named source ahead of the queued
+** telemetry, and optionally change how the sources are forwarded
+*/
+typedef struct
+{
+    CFE_SB_MsgId_Atom_t MsgId[RF_TLM_SNAP_MAX_MIDS]; /**< \brief Source message IDs, 0 ends the list */
+    uint8               Forward;                     /**< \brief One of RF_TLM_SNAP_FWD_* */
+    uint8               Spare[3];
+} RF_TLM_Snapshot_Payload_t;
+
+typedef struct
+{
+    CFE_MSG_CommandHeader_t   CmdHeader; /**< \brief Command header */
+    RF_TLM_Snapshot_Payload_t Payload;   /**< \brief Command payload */
+} RF_TLM_SnapshotCmd_t;
+
+/*
+** Start a link test run, or stop the one in progress with a zero duration
+*/
+typedef struct
+{
+    uint32 DurationMsec; /**< \brief Run length, 0 stops a run in progress */
+    uint16 RateHz;       /**< \brief Frames per second, 0 sends back to back */
+    uint8  FrameBytes;   /**< \brief Test frame length, header included */
+    uint8  Spare;
+} RF_TLM_LinkTest_Payload_t;
+
+typedef struct
+{
+    CFE_MSG_CommandHeader_t   CmdHeader; /**< \brief Command header */
+    RF_TLM_LinkTest_Payload_t Payload;   /**< \brief Command payload */
+} RF_TLM_LinkTestCmd_t;
+
+/*
+** Select the downlink framing and the channel of the transfer frames
+*/
+typedef struct
+{
+    uint8  Mode; /**< \brief RF_TLM_FRAMING_* */
+    uint8  Vcid; /**< \brief Virtual channel of the transfer frames */
+    uint16 Scid; /**< \brief Spacecraft ID of the transfer frames */
+} RF_TLM_SetFraming_Payload_t;
+
+typedef struct
+{
+    CFE_MSG_CommandHeader_t     CmdHeader; /**< \brief Command header */
+    RF_TLM_SetFraming_Payload_t Payload;   /**< \brief Command payload */
+} RF_TLM_SetFramingCmd_t;
+
+/*
+** Summarize a forwarded source over a window, or forward it raw again with
+** a window of 0. FieldMask selects the byte groups summarized, bit 0 the
+** first; only fields its schema uses may be set.
+*/
+typedef struct
+{
+    CFE_SB_MsgId_Atom_t MsgId;      /**< \brief Source message ID */
+    uint8               FieldMask;  /**< \brief Bit i summarizes byte group i */
+    uint8               Spare[3];
+    uint32              WindowMsec; /**< \brief Window length, 0 for raw forwarding */
+} RF_TLM_SetSummary_Payload_t;
+
+typedef struct
+{
+    CFE_MSG_CommandHeader_t     CmdHeader; /**< \brief Command header */
+    RF_TLM_SetSummary_Payload_t Payload;   /**< \brief Command payload */
+} RF_TLM_SetSummaryCmd_t;
+
+/*
+** Set the lowest type of the events of an app sent over RF, or of the apps
+** not in RF_TLM_EVENT_APP_LIST when AppName is empty
+*/
+typedef struct
+{
+    char  AppName[CFE_MISSION_MAX_API_LEN]; /**< \brief App in RF_TLM_EVENT_APP_LIST, or empty */
+    uint8 MinType;                          /**< \brief CFE_EVS_EventType_*, or RF_TLM_EVENT_MUTED */
+    uint8 Spare[3];
+} RF_TLM_SetEventFilter_Payload_t;
+
+typedef struct
+{
+    CFE_MSG_CommandHeader_t         CmdHeader; /**< \brief Command header */
+    RF_TLM_SetEventFilter_Payload_t Payload;   /**< \brief Command payload */
+} RF_TLM_SetEventFilterCmd_t;
+
+/*
+** Compress the downlink, between the frame encoding and the transport
+*/
+typedef struct
+{
+    uint8 Mode; /**< \brief RF_TLM_COMPRESS_* */
+    uint8 Spare[3];
+} RF_TLM_SetCompress_Payload_t;
+
+typedef struct
+{
+    CFE_MSG_CommandHeader_t      CmdHeader; /**< \brief Command header */
+    RF_TLM_SetCompress_Payload_t Payload;   /**< \brief Command payload */
+} RF_TLM_SetCompressCmd_t;
+
 /*************************************************************************/
 /*
 ** Type definition (RF Tlm App housekeeping)
@@ -85,6 +418,121 @@ typedef struct
     uint8 spare[2];
     int PcktCounter;
     int PcktErrCounter;
+    uint32 RateSuppressedCount;                       /**< \brief Samples dropped by rate shaping, all sources */
+    uint32 SourceSuppressedCount[RF_TLM_MAX_SOURCES]; /**< \brief Samples dropped by rate shaping, per source */
+    uint32 DevProbeAttempts;  /**< \brief uC registration and probe attempts */
+    uint32 DevProbeFailures;  /**< \brief Failed registration and probe attempts */
+    uint32 DevReadyMsec;      /**< \brief Time from app start until the uC was ready */
+    uint32 FirstFrameMsec;    /**< \brief Time from app start until the first frame was sent */
+    uint32 FrameQueueDropped; /**< \brief Frames dropped because a queue was full */
+    uint16 FrameQueueCount;   /**< \brief Frames waiting to be sent, all queues */
+    uint8  DevState;          /**< \brief uC state: 0 unregistered, 1 probing, 2 ready */
+    uint8  DevTimingValid;    /**< \brief Bit 0: DevReadyMsec valid, bit 1: FirstFrameMsec valid */
+    uint32 PackedFrameCount;  /**< \brief Frames sent bit-packed */
+    uint32 PackedBytesSaved;  /**< \brief Bytes saved by packing against raw frames */
+    uint32 TimeRefCount;      /**< \brief Time reference frames accepted by the uC */
+    uint16 FrameSeq;          /**< \brief Sequence number of the next frame */
+    uint16 FramesSinceRef;    /**< \brief Frames sent since the last time reference */
+    uint32 UplinkPolls;           /**< \brief uC mailbox polls */
+    uint32 UplinkEmptyPolls;      /**< \brief Polls that found no command */
+    uint32 UplinkAccepted;        /**< \brief Uplinked commands published on the software bus */
+    uint32 UplinkRejected;        /**< \brief Uplinked commands rejected */
+    uint32 UplinkDuplicates;      /**< \brief Uplink frames seen twice */
+    uint32 UplinkPollBusyUsec;    /**< \brief Bus time spent polling, wraps */
+    uint16 UplinkLastLatencyMsec; /**< \brief Radio receipt to publication, last command */
+    uint16 UplinkMaxLatencyMsec;  /**< \brief Radio receipt to publication, worst command */
+    uint16 UplinkPollMsec;        /**< \brief Current poll interval */
+    uint16 UplinkSpare;
+    uint32 BusTimeouts;           /**< \brief I2C transfers abandoned at the deadline */
+    uint32 BusRecoveries;         /**< \brief Bus recoveries run */
+    uint32 BusRecoveryFailures;   /**< \brief Recoveries that failed or had no means to run */
+    uint32 BusBusyRejects;        /**< \brief Transfers refused while a hung one was outstanding */
+    uint32 BusWorkerRestarts;     /**< \brief I2C workers replaced after staying stuck in a transfer */
+    uint32 DeadbandSuppressedCount;                       /**< \brief Unchanged samples dropped, all sources */
+    uint32 SourceDeadbandSuppressed[RF_TLM_MAX_SOURCES]; /**< \brief Unchanged samples dropped, per source */
+    char   ProfileName[RF_TLM_PROFILE_NAME_LEN]; /**< \brief Active link profile */
+    uint32 ProfileSwitches;       /**< \brief Profile switches since startup */
+    uint32 ProfileDroppedCount;   /**< \brief Samples of sources the active profile does not forward */
+    uint32 SendIntervalMsec;      /**< \brief Time between send slots */
+    uint16 FramesPerCycle;        /**< \brief Frames sent in each slot */
+    uint8  ProfileId;             /**< \brief Index of the active profile */
+    uint8  ProfileSpare;
+    uint32 FragMessages;          /**< \brief Messages sent as fragments */
+    uint32 FragFrames;            /**< \brief Fragment frames queued */
+    uint32 FragBytes;             /**< \brief Message bytes carried in fragments */
+    uint32 FragOversize;          /**< \brief Messages too large to fragment into the source queue */
+    uint32 FragQueueFull;         /**< \brief Messages dropped, the source queue had no room for all fragments */
+    uint32 ShortMsgCount;         /**< \brief Messages too short for raw or packed encoding */
+    uint16 CpuStagePermille[RF_TLM_STAGE_COUNT]; /**< \brief Share of the last window per RF_TLM_STAGE_* */
+    uint16 CpuActivePermille;     /**< \brief Share of the last window not idle */
+    uint16 CpuBudgetPermille;     /**< \brief Active share allowed */
+    uint32 CpuLoopMaxUsec;        /**< \brief Longest active run loop iteration in the last window */
+    uint32 CpuOverBudgetCount;    /**< \brief Windows over budget */
+    uint32 SlotPeriodMsec;        /**< \brief Slot period, 0 when free running */
+    uint32 SlotCount;             /**< \brief Transmit slots seen open */
+    uint32 SlotUsedCount;         /**< \brief Slots in which frames were released */
+    uint32 SlotMissedCount;       /**< \brief Slots that went by between two checks */
+    uint32 SlotFrameCount;        /**< \brief Frames released in slots */
+    uint16 SlotUtilPermille;      /**< \brief Bus time share of the last closed slot */
+    uint16 SlotLateMsec;          /**< \brief Slot start to release, last slot */
+    uint16 SlotLateMaxMsec;       /**< \brief Slot start to release, worst slot */
+    uint16 SlotSpare;
+    uint8  LinkTestRun;           /**< \brief Number of the last link test run */
+    uint8  LinkTestState;         /**< \brief RF_TLM_LINKTEST_* of that run */
+    uint16 LinkTestSpare;
+    uint8  FramingMode;           /**< \brief RF_TLM_FRAMING_* in use */
+    uint8  FramingVcid;           /**< \brief Virtual channel of the transfer frames */
+    uint16 FramingScid;           /**< \brief Spacecraft ID of the transfer frames */
+    uint32 CcsdsFrames;           /**< \brief Transfer frames written */
+    uint32 CcsdsPackets;          /**< \brief Space packets framed, idle ones aside */
+    uint32 CcsdsIdleBytes;        /**< \brief Idle packet bytes written to fill frames */
+    uint32 SummarySamples;        /**< \brief Samples taken into summaries, all sources */
+    uint32 SummaryWindows;        /**< \brief Summary windows closed, all sources */
+    uint32 SummaryFrames;         /**< \brief Summary frames queued */
+    uint8  SummaryMask;           /**< \brief Bit i set when source i is summarized */
+    uint8  SummarySpare[3];
+    uint32 EventsSeen;            /**< \brief Event messages received */
+    uint32 EventsFiltered;        /**< \brief Events below their app's filter */
+    uint32 EventsQueued;          /**< \brief Event frames queued on the fast lane */
+    uint32 EventsSent;            /**< \brief Event frames accepted by the uC */
+    uint32 EventsDropped;         /**< \brief Event frames dropped from a full lane */
+    uint16 EventLatencyMsec;      /**< \brief Event time to uC acceptance, last event */
+    uint16 EventLatencyMaxMsec;   /**< \brief Event time to uC acceptance, worst event */
+    uint32 BusWaitMaxUsec;        /**< \brief Longest wait for another caller's transfer to finish */
+    uint32 BusBusyUsec;           /**< \brief Time spent in bus transfers, wraps */
+    uint8  CdsState;              /**< \brief RF_TLM_CDS_* of this run */
+    uint8  CdsBacklog;            /**< \brief Frames in the last checkpoint */
+    uint16 CdsRestored;           /**< \brief Frames requeued from the checkpoint at startup */
+    uint32 CdsCheckpoints;        /**< \brief Checkpoints written, carried across restarts */
+    uint32 CdsErrors;             /**< \brief Checkpoints the CDS refused */
+    uint16 CdsLastUsec;           /**< \brief Time to build and write the last checkpoint */
+    uint16 CdsMaxUsec;            /**< \brief Longest checkpoint */
+    uint8  CompressMode;          /**< \brief RF_TLM_COMPRESS_* in use */
+    uint8  CompressSpare;
+    uint16 CompressRatioPermille; /**< \brief Bytes sent per 1000 frame bytes compressed, all blocks */
+    uint32 CompressBlocks;        /**< \brief Blocks sent */
+    uint32 CompressStored;        /**< \brief Blocks sent stored, as they did not shrink */
+    uint32 CompressInBytes;       /**< \brief Frame bytes taken into blocks, wraps */
+    uint32 CompressOutBytes;      /**< \brief Piece frame bytes sent, wraps */
+    uint32 CompressFrameNsec;     /**< \brief Compression time per frame, last block */
+    uint32 CompressFrameNsecMax;  /**< \brief Compression time per frame, worst block */
+    uint8  ContactState;          /**< \brief RF_TLM_CONTACT_* */
+    uint8  ContactSpare;
+    uint16 ContactUtilPermille;   /**< \brief Frames sent over the frames the last window could carry */
+    uint32 ContactWindows;        /**< \brief Contact windows entered */
+    uint32 ContactFrames;         /**< \brief Frames sent inside contact windows */
+    uint32 ContactNextSec;        /**< \brief Seconds to the next window start, 0 inside one or with none ahead */
+    uint16 ContactBacklog;        /**< \brief Frames queued when the last window opened */
+    uint16 ContactCarried;        /**< \brief Frames still queued when the last window closed */
+    uint32 ContactCarriedBytes;   /**< \brief Bytes of those frames */
+    uint8  SnapPullMask;          /**< \brief Bit i set while source i is sent on request only */
+    uint8  SnapSpare;
+    uint16 SnapLatencyMsec;       /**< \brief Last request to uC acceptance of a frame it queued */
+    uint32 SnapRequests;          /**< \brief Snapshot requests accepted */
+    uint32 SnapFrames;            /**< \brief Snapshot frames queued */
+    uint32 SnapSent;              /**< \brief Snapshot frames accepted by the uC */
+    uint32 SnapMissing;           /**< \brief Sources requested with no sample to send */
+    uint32 SnapHeld;              /**< \brief Samples of pull sources kept without being forwarded */
 } RF_TLM_UDP_HkTlm_Payload_t;   // Telemetry sent over UDP (to_lab)
 
 typedef struct
@@ -93,4 +541,35 @@ typedef struct
     RF_TLM_UDP_HkTlm_Payload_t Payload;         /**< \brief Telemetry payload */
 } RF_TLM_HkTlm_t;
 
+/*************************************************************************/
+/*
+** Type definition (link test results, sent when a run ends)
+*/
+typedef struct
+{
+    uint8  Run;             /**< \brief Run number, also carried by the test frames */
+    uint8  State;           /**< \brief RF_TLM_LINKTEST_* */
+    uint8  FrameBytes;      /**< \brief Test frame length */
+    uint8  Spare;
+    uint16 RateHz;          /**< \brief Requested rate, 0 for back to back */
+    uint16 Spare2;
+    uint32 DurationMsec;    /**< \brief Requested run length */
+    uint32 ElapsedMsec;     /**< \brief Actual run length */
+    uint32 FramesSent;      /**< \brief Frames the uC accepted */
+    uint32 FramesFailed;    /**< \brief Transfers that failed */
+    uint32 BytesSent;       /**< \brief Bytes the uC accepted */
+    uint32 FramesPerSec;    /**< \brief Achieved frame rate */
+    uint32 BytesPerSec;     /**< \brief Achieved byte rate */
+    uint32 LatencyMinUsec;  /**< \brief Shortest transfer */
+    uint32 LatencyMeanUsec; /**< \brief Mean transfer */
+    uint32 LatencyMaxUsec;  /**< \brief Longest transfer */
+    uint32 LatencyHist[RF_TLM_LINKTEST_HIST_BINS]; /**< \brief Transfers below 250 us, 500 us, 1, 2, 4, 8, 16 ms, and above */
+} RF_TLM_LinkTestTlm_Payload_t;
+
+typedef struct
+{
+    CFE_MSG_TelemetryHeader_t    TelemetryHeader; /**< \brief Telemetry header */
+    RF_TLM_LinkTestTlm_Payload_t Payload;         /**< \brief Telemetry payload */
+} RF_TLM_LinkTestTlm_t;
+
 #endif /* RF_TLM_MSG_H */
@@ -0,0 +1,348 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * \file
+ *   Schema-aware bit packing of RF frames.
+ *
+ *   The encoder reads the raw frame layout (rf_tlm_frame.h) and writes each
+ *   field at its declared width, MSB first. Floats are quantized to
+ *   Resolution steps above Min with round-half-up; the ground decoder
+ *   recovers the exact codes and rebuilds values as Min + Code * Resolution.
+ *   Rounding is done without libm so the flight and host builds agree.
+ */
+
+#include <math.h>
+#include <string.h>
+
+#include "rf_tlm_pack.h"
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_Bits_Put() -- Append the low Bits of Value               */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void RF_TLM_Bits_Put(RF_TLM_BitWriter_t *Writer, uint32_t Value, uint8_t Bits)
+{
+    uint8_t bit;
+
+    while (Bits > 0)
+    {
+        --Bits;
+
+        if ((Writer->BitPos >> 3) >= Writer->Size)
+        {
+            return;
+        }
+
+        bit = (uint8_t)((Value >> Bits) & 1u);
+        if ((Writer->BitPos & 7u) == 0)
+        {
+            Writer->Buf[Writer->BitPos >> 3] = 0;
+        }
+        Writer->Buf[Writer->BitPos >> 3] |= (uint8_t)(bit << (7u - (Writer->BitPos & 7u)));
+        ++Writer->BitPos;
+    }
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_Bits_Get() -- Read the next Bits as an unsigned value    */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+uint32_t RF_TLM_Bits_Get(RF_TLM_BitReader_t *Reader, uint8_t Bits)
+{
+    uint32_t value = 0;
+
+    while (Bits > 0)
+    {
+        --Bits;
+        value <<= 1;
+
+        if ((Reader->BitPos >> 3) < Reader->Size)
+        {
+            value |= (uint32_t)(Reader->Buf[Reader->BitPos >> 3] >> (7u - (Reader->BitPos & 7u))) & 1u;
+        }
+        ++Reader->BitPos;
+    }
+
+    return value;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_Pack_FindSchema() -- Schema declared for a message ID    */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+const RF_TLM_Schema_t *RF_TLM_Pack_FindSchema(uint16_t MsgId, uint8_t *SchemaId)
+{
+    for (uint8_t i = 0; i < RF_TLM_SchemaCount; i++)
+    {
+        if (RF_TLM_Schemas[i].MsgId == MsgId)
+        {
+            *SchemaId = i;
+            return &RF_TLM_Schemas[i];
+        }
+    }
+
+    return NULL;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_Pack_GetSchema() -- Schema by ID, NULL if out of range   */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+const RF_TLM_Schema_t *RF_TLM_Pack_GetSchema(uint8_t SchemaId)
+{
+    if (SchemaId >= RF_TLM_SchemaCount)
+    {
+        return NULL;
+    }
+
+    return &RF_TLM_Schemas[SchemaId];
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_Pack_BodyBytes() -- Size of the packed fields in bytes   */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+uint16_t RF_TLM_Pack_BodyBytes(const RF_TLM_Schema_t *Schema)
+{
+    uint32_t bits = 2u * Schema->CounterBits;
+
+    for (uint8_t i = 0; i < RF_TLM_RAW_FIELD_COUNT; i++)
+    {
+        if (Schema->Fields[i].Kind != RF_TLM_FIELD_UNUSED)
+        {
+            bits += Schema->Fields[i].Bits;
+        }
+    }
+
+    return (uint16_t)((bits + 7u) / 8u);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_Pack_Word() -- Byte group as a 32-bit word in the        */
+/*                       packet's byte order                       */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+uint32_t RF_TLM_Pack_Word(const RF_TLM_Schema_t *Schema, const uint8_t *Group)
+{
+    if (Schema->BigEndian)
+    {
+        return ((uint32_t)Group[0] << 24) | ((uint32_t)Group[1] << 16) | ((uint32_t)Group[2] << 8) | Group[3];
+    }
+
+    return ((uint32_t)Group[3] << 24) | ((uint32_t)Group[2] << 16) | ((uint32_t)Group[1] << 8) | Group[0];
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_Pack_FieldValue() -- Engineering value of a field word,  */
+/*                             before quantization                 */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+double RF_TLM_Pack_FieldValue(const RF_TLM_FieldSchema_t *Field, uint32_t Word)
+{
+    float fval;
+
+    switch (Field->Kind)
+    {
+        case RF_TLM_FIELD_UINT:
+            return (double)Word;
+
+        case RF_TLM_FIELD_INT:
+            return (double)(int32_t)Word;
+
+        case RF_TLM_FIELD_FLOAT:
+            memcpy(&fval, &Word, sizeof(fval));
+            return (double)fval;
+
+        default:
+            return 0.0;
+    }
+}
+
+/*
+** Code for one field, clamped to its width
+*/
+static uint32_t RF_TLM_Pack_Quantize(const RF_TLM_FieldSchema_t *Field, uint32_t Word)
+{
+    uint32_t max_code = RF_TLM_FLOAT_NAN_CODE(Field->Bits);
+    int32_t  sval;
+    int32_t  smin;
+    int32_t  smax;
+    float    fval;
+    double   steps;
+
+    switch (Field->Kind)
+    {
+        case RF_TLM_FIELD_UINT:
+            return (Word > max_code) ? max_code : Word;
+
+        case RF_TLM_FIELD_INT:
+            sval = (int32_t)Word;
+            smax = (int32_t)(max_code >> 1);
+            smin = -smax - 1;
+            if (sval > smax)
+            {
+                sval = smax;
+            }
+            else if (sval < smin)
+            {
+                sval = smin;
+            }
+            return (uint32_t)sval & max_code;
+
+        case RF_TLM_FIELD_FLOAT:
+            memcpy(&fval, &Word, sizeof(fval));
+            if (fval != fval)
+            {
+                return max_code;
+            }
+
+            /* The all-ones code is reserved for NaN */
+            steps = ((double)fval - (double)Field->Min) / (double)Field->Resolution;
+            if (steps <= 0.0)
+            {
+                return 0;
+            }
+            if (steps >= (double)(max_code - 1u))
+            {
+                return max_code - 1u;
+            }
+            return (uint32_t)(steps + 0.5);
+
+        default:
+            return 0;
+    }
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_Pack_Encode() -- Pack a raw frame, returns bytes written */
+/*                         or 0 if the result does not fit         */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+uint16_t RF_TLM_Pack_Encode(const RF_TLM_Schema_t *Schema, const uint8_t *Raw, uint8_t *Out, uint16_t OutSize)
+{
+    RF_TLM_BitWriter_t          writer;
+    const RF_TLM_FieldSchema_t *field;
+    uint16_t                    body_bytes;
+    uint32_t                    word;
+
+    body_bytes = RF_TLM_Pack_BodyBytes(Schema);
+    if (body_bytes > OutSize)
+    {
+        return 0;
+    }
+
+    writer.Buf    = Out;
+    writer.Size   = body_bytes;
+    writer.BitPos = 0;
+    memset(Out, 0, body_bytes);
+
+    RF_TLM_Bits_Put(&writer, Raw[RF_TLM_RAW_ERRCNT_OFFSET], Schema->CounterBits);
+    RF_TLM_Bits_Put(&writer, Raw[RF_TLM_RAW_CMDCNT_OFFSET], Schema->CounterBits);
+
+    for (uint8_t i = 0; i < RF_TLM_RAW_FIELD_COUNT; i++)
+    {
+        field = &Schema->Fields[i];
+        if (field->Kind == RF_TLM_FIELD_UNUSED)
+        {
+            continue;
+        }
+
+        word = RF_TLM_Pack_Word(Schema, &Raw[RF_TLM_RAW_FIELD_OFFSET + i * RF_TLM_RAW_FIELD_BYTES]);
+        RF_TLM_Bits_Put(&writer, RF_TLM_Pack_Quantize(field, word), field->Bits);
+    }
+
+    return body_bytes;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_Pack_Decode() -- Unpack the fields written by the        */
+/*                         encoder, returns 0 or -1 if In is short */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+int RF_TLM_Pack_Decode(const RF_TLM_Schema_t *Schema, const uint8_t *In, uint16_t Len, RF_TLM_Unpacked_t *Out)
+{
+    RF_TLM_BitReader_t          reader;
+    const RF_TLM_FieldSchema_t *field;
+    uint32_t                    code;
+    uint32_t                    sign;
+
+    if (Len < RF_TLM_Pack_BodyBytes(Schema))
+    {
+        return -1;
+    }
+
+    reader.Buf    = In;
+    reader.Size   = Len;
+    reader.BitPos = 0;
+
+    Out->ErrCounter = (uint8_t)RF_TLM_Bits_Get(&reader, Schema->CounterBits);
+    Out->CmdCounter = (uint8_t)RF_TLM_Bits_Get(&reader, Schema->CounterBits);
+
+    for (uint8_t i = 0; i < RF_TLM_RAW_FIELD_COUNT; i++)
+    {
+        field         = &Schema->Fields[i];
+        Out->Code[i]  = 0;
+        Out->Value[i] = 0.0;
+
+        if (field->Kind == RF_TLM_FIELD_UNUSED)
+        {
+            continue;
+        }
+
+        code         = RF_TLM_Bits_Get(&reader, field->Bits);
+        Out->Code[i] = code;
+
+        switch (field->Kind)
+        {
+            case RF_TLM_FIELD_UINT:
+                Out->Value[i] = (double)code;
+                break;
+
+            case RF_TLM_FIELD_INT:
+                sign = (uint32_t)1 << (field->Bits - 1);
+                Out->Value[i] = (double)((int64_t)(code ^ sign) - (int64_t)sign);
+                break;
+
+            case RF_TLM_FIELD_FLOAT:
+                if (code == RF_TLM_FLOAT_NAN_CODE(field->Bits))
+                {
+                    Out->Value[i] = NAN;
+                }
+                else
+                {
+                    Out->Value[i] = (double)field->Min + (double)code * (double)field->Resolution;
+                }
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    return 0;
+}
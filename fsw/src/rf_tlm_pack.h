@@ -0,0 +1,108 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ * Schema-aware bit packing of RF frames, shared with the ground decoder
+ *
+ * \note This header must not depend on cFE, the ground tools build it on
+ *       the host.
+ */
+
+#ifndef RF_TLM_PACK_H
+#define RF_TLM_PACK_H
+
+#include <stdint.h>
+
+#include "rf_tlm_frame.h"
+
+/*
+** Field kinds
+*/
+#define RF_TLM_FIELD_UNUSED 0 /* Not sent */
+#define RF_TLM_FIELD_UINT   1 /* Unsigned integer, clamped to Bits */
+#define RF_TLM_FIELD_INT    2 /* Signed integer, clamped to Bits, two's complement */
+#define RF_TLM_FIELD_FLOAT  3 /* float32 quantized to Resolution above Min */
+
+/*
+** The all-ones code of a FLOAT field marks a NaN sample
+*/
+#define RF_TLM_FLOAT_NAN_CODE(bits) ((uint32_t)((((uint64_t)1) << (bits)) - 1))
+
+typedef struct
+{
+    uint8_t Kind;       /**< \brief One of RF_TLM_FIELD_* */
+    uint8_t Bits;       /**< \brief Packed width, 1..32 */
+    float   Min;        /**< \brief FLOAT: value of code 0 */
+    float   Resolution; /**< \brief FLOAT: value of one code step */
+} RF_TLM_FieldSchema_t;
+
+typedef struct
+{
+    uint16_t             MsgId;       /**< \brief Source message ID */
+    const char          *Name;        /**< \brief Source name, for the ground tools */
+    uint8_t              CounterBits; /**< \brief Width of each upstream counter, 0 drops them */
+    uint8_t              BigEndian;   /**< \brief Byte order of the byte groups in the packet */
+    RF_TLM_FieldSchema_t Fields[RF_TLM_RAW_FIELD_COUNT];
+} RF_TLM_Schema_t;
+
+/*
+** A packed frame decoded on the ground
+*/
+typedef struct
+{
+    uint8_t  SchemaId;
+    uint8_t  ErrCounter;                      /**< \brief Low CounterBits of the upstream counter */
+    uint8_t  CmdCounter;                      /**< \brief Low CounterBits of the upstream counter */
+    uint32_t Code[RF_TLM_RAW_FIELD_COUNT];    /**< \brief Packed codes, bit-exact with the encoder */
+    double   Value[RF_TLM_RAW_FIELD_COUNT];   /**< \brief Engineering values rebuilt from Code */
+} RF_TLM_Unpacked_t;
+
+/*
+** MSB-first bit stream over a byte buffer
+*/
+typedef struct
+{
+    uint8_t *Buf;
+    uint16_t Size;   /**< \brief Buffer size in bytes */
+    uint32_t BitPos; /**< \brief Bits written so far */
+} RF_TLM_BitWriter_t;
+
+typedef struct
+{
+    const uint8_t *Buf;
+    uint16_t       Size;   /**< \brief Buffer size in bytes */
+    uint32_t       BitPos; /**< \brief Bits read so far */
+} RF_TLM_BitReader_t;
+
+extern const RF_TLM_Schema_t RF_TLM_Schemas[];
+extern const uint8_t         RF_TLM_SchemaCount;
+
+void     RF_TLM_Bits_Put(RF_TLM_BitWriter_t *Writer, uint32_t Value, uint8_t Bits);
+uint32_t RF_TLM_Bits_Get(RF_TLM_BitReader_t *Reader, uint8_t Bits);
+
+const RF_TLM_Schema_t *RF_TLM_Pack_FindSchema(uint16_t MsgId, uint8_t *SchemaId);
+const RF_TLM_Schema_t *RF_TLM_Pack_GetSchema(uint8_t SchemaId);
+uint16_t               RF_TLM_Pack_BodyBytes(const RF_TLM_Schema_t *Schema);
+uint32_t               RF_TLM_Pack_Word(const RF_TLM_Schema_t *Schema, const uint8_t *Group);
+double                 RF_TLM_Pack_FieldValue(const RF_TLM_FieldSchema_t *Field, uint32_t Word);
+uint16_t RF_TLM_Pack_Encode(const RF_TLM_Schema_t *Schema, const uint8_t *Raw, uint8_t *Out, uint16_t OutSize);
+int      RF_TLM_Pack_Decode(const RF_TLM_Schema_t *Schema, const uint8_t *In, uint16_t Len, RF_TLM_Unpacked_t *Out);
+
+#endif /* RF_TLM_PACK_H */
@@ -0,0 +1,162 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * \file
+ *   Link profiles for the RF Telemetry Output App.
+ *
+ *   A profile bundles the send pacing, the per-source queue limit and, for
+ *   every source, its scheduling weight, decimation, minimum interval and
+ *   encoding. Switching applies all of them between two run loop steps, so
+ *   no frame is built under a mix of two profiles. Frames already queued are
+ *   kept and sent under the new settings.
+ *
+ *   The first profile is active at startup.
+ */
+
+#include <string.h>
+
+#include "rf_tlm_events.h"
+#include "rf_tlm.h"
+
+const RF_TLM_Profile_t RF_TLM_Profiles[] = {
+    {
+        /* Every source at full rate, one raw frame per task cycle */
+        .Name             = "default",
+        .SendIntervalMsec = RF_TLM_TASK_MSEC,
+        .FramesPerCycle   = RF_TLM_FRAMES_PER_CYCLE,
+        .QueueLimit       = RF_TLM_SOURCE_QUEUE_DEPTH,
+        .Sources          = {
+            {IMU_APP_RF_DATA_MID, 1, RF_TLM_ENC_RAW, 0, 0},
+            {BLINKY_RF_DATA_MID, 1, RF_TLM_ENC_RAW, 0, 0},
+            {ALTITUDE_APP_RF_DATA_MID, 1, RF_TLM_ENC_RAW, 0, 0},
+            {TEMP_APP_RF_DATA_MID, 1, RF_TLM_ENC_RAW, 0, 0},
+        },
+    },
+    {
+        /* On the pad: a temperature trickle keeps the link alive */
+        .Name             = "pad",
+        .SendIntervalMsec = 1000,
+        .FramesPerCycle   = 1,
+        .QueueLimit       = 4,
+        .Sources          = {
+            {TEMP_APP_RF_DATA_MID, 1, RF_TLM_ENC_PACKED, 0, 5000},
+        },
+    },
+    {
+        /* Powered flight: IMU first, altitude close behind */
+        .Name             = "ascent",
+        .SendIntervalMsec = 100,
+        .FramesPerCycle   = 4,
+        .QueueLimit       = RF_TLM_SOURCE_QUEUE_DEPTH,
+        .Sources          = {
+            {IMU_APP_RF_DATA_MID, 3, RF_TLM_ENC_PACKED, 0, 0},
+            {ALTITUDE_APP_RF_DATA_MID, 2, RF_TLM_ENC_PACKED, 0, 0},
+            {TEMP_APP_RF_DATA_MID, 1, RF_TLM_ENC_PACKED, 10, 0},
+        },
+    },
+    {
+        /* Under canopy: altitude leads, IMU thinned */
+        .Name             = "descent",
+        .SendIntervalMsec = 100,
+        .FramesPerCycle   = 4,
+        .QueueLimit       = RF_TLM_SOURCE_QUEUE_DEPTH,
+        .Sources          = {
+            {ALTITUDE_APP_RF_DATA_MID, 3, RF_TLM_ENC_PACKED, 0, 0},
+            {IMU_APP_RF_DATA_MID, 1, RF_TLM_ENC_PACKED, 2, 0},
+            {TEMP_APP_RF_DATA_MID, 1, RF_TLM_ENC_PACKED, 10, 0},
+        },
+    },
+};
+
+const uint8 RF_TLM_ProfileCount = sizeof(RF_TLM_Profiles) / sizeof(RF_TLM_Profiles[0]);
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_Profile_Find() -- Profile ID by name, -1 if none          */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+int32 RF_TLM_Profile_Find(const char *Name)
+{
+    for (uint8 i = 0; i < RF_TLM_ProfileCount; i++)
+    {
+        if (strncmp(RF_TLM_Profiles[i].Name, Name, RF_TLM_PROFILE_NAME_LEN) == 0)
+        {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_Profile_Apply() -- Make a profile the active one         */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void RF_TLM_Profile_Apply(uint8 ProfileId)
+{
+    const RF_TLM_Profile_t       *Profile = &RF_TLM_Profiles[ProfileId];
+    const RF_TLM_ProfileSource_t *Entry;
+    RF_TLM_Source_t              *Source;
+    uint16                        Limit;
+
+    Limit = Profile->QueueLimit;
+    if (Limit == 0 || Limit > RF_TLM_SOURCE_QUEUE_DEPTH)
+    {
+        Limit = RF_TLM_SOURCE_QUEUE_DEPTH;
+    }
+
+    for (uint16 i = 0; i < RF_TLM_Data.SourceCount; i++)
+    {
+        Source = &RF_TLM_Data.Sources[i];
+        Entry  = NULL;
+
+        for (uint16 j = 0; j < RF_TLM_MAX_SOURCES; j++)
+        {
+            if (Profile->Sources[j].Weight != 0 &&
+                CFE_SB_MsgId_Equal(CFE_SB_ValueToMsgId(Profile->Sources[j].MsgId), Source->MsgId))
+            {
+                Entry = &Profile->Sources[j];
+                break;
+            }
+        }
+
+        RF_TLM_Queue_SetLimit(&Source->Queue, Limit);
+
+        if (Entry == NULL)
+        {
+            Source->Weight = 0;
+            continue;
+        }
+
+        Source->Weight = Entry->Weight;
+        RF_TLM_Rate_Set(&Source->Rate, Entry->Decimation, Entry->MinIntervalMsec);
+
+        /* Packing needs a schema; without one, or without the encoding built in, the source stays raw */
+        Source->Encoding = Entry->Encoding;
+        if (!RF_TLM_ENC_BUILT(Source->Encoding) || (Source->Encoding == RF_TLM_ENC_PACKED && Source->Schema == NULL))
+        {
+            Source->Encoding = RF_TLM_ENC_RAW;
+        }
+    }
+
+    RF_TLM_Data.SendIntervalMsec = Profile->SendIntervalMsec;
+    RF_TLM_Data.FramesPerCycle   = Profile->FramesPerCycle;
+    RF_TLM_Data.ProfileId        = ProfileId;
+}
@@ -0,0 +1,63 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ * Link profiles for the RF Telemetry Output App
+ */
+
+#ifndef RF_TLM_PROFILE_H
+#define RF_TLM_PROFILE_H
+
+#include "cfe.h"
+
+#include "rf_tlm_msg.h"
+
+/*
+** How one source is forwarded under a profile. Sources a profile does not
+** list are not forwarded.
+*/
+typedef struct
+{
+    CFE_SB_MsgId_Atom_t MsgId;
+    uint8               Weight;          /**< \brief Frames sent per scheduling round, 0 stops forwarding */
+    uint8               Encoding;        /**< \brief One of RF_TLM_ENC_* */
+    uint16              Decimation;      /**< \brief Forward every Nth sample, 0 or 1 forwards all */
+    uint32              MinIntervalMsec; /**< \brief Minimum time between forwarded samples, 0 disables */
+} RF_TLM_ProfileSource_t;
+
+/*
+** A named set of link settings, switched as a whole
+*/
+typedef struct
+{
+    const char            *Name;
+    uint32                 SendIntervalMsec; /**< \brief Time between send slots */
+    uint16                 FramesPerCycle;   /**< \brief Frames sent in each slot */
+    uint16                 QueueLimit;       /**< \brief Frames held per source, at most RF_TLM_SOURCE_QUEUE_DEPTH */
+    RF_TLM_ProfileSource_t Sources[RF_TLM_MAX_SOURCES];
+} RF_TLM_Profile_t;
+
+extern const RF_TLM_Profile_t RF_TLM_Profiles[];
+extern const uint8            RF_TLM_ProfileCount;
+
+int32 RF_TLM_Profile_Find(const char *Name);
+void  RF_TLM_Profile_Apply(uint8 ProfileId);
+
+#endif /* RF_TLM_PROFILE_H */
@@ -0,0 +1,144 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * \file
+ *   Outgoing RF frame queue for the RF Telemetry Output App.
+ */
+
+#include "rf_tlm_queue.h"
+
+#include <string.h>
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_Queue_Init() -- Attach storage and empty the queue       */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void RF_TLM_Queue_Init(RF_TLM_FrameQueue_t *Queue, RF_TLM_Frame_t *Storage, uint16 Depth)
+{
+    Queue->Frames       = Storage;
+    Queue->Depth        = Depth;
+    Queue->Limit        = Depth;
+    Queue->Head         = 0;
+    Queue->Count        = 0;
+    Queue->DroppedCount = 0;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_Queue_Push() -- Append a frame, dropping the oldest one  */
+/*                        if the queue is at its limit             */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+bool RF_TLM_Queue_Push(RF_TLM_FrameQueue_t *Queue, const RF_TLM_Frame_t *Frame)
+{
+    bool   kept_all = true;
+    uint16 tail;
+
+    if (Queue->Count >= Queue->Limit)
+    {
+        RF_TLM_Queue_Pop(Queue);
+        ++Queue->DroppedCount;
+        kept_all = false;
+    }
+
+    tail = (uint16)((Queue->Head + Queue->Count) % Queue->Depth);
+    memcpy(&Queue->Frames[tail], Frame, sizeof(*Frame));
+    ++Queue->Count;
+
+    return kept_all;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_Queue_Peek() -- Oldest frame, or NULL if empty           */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+RF_TLM_Frame_t *RF_TLM_Queue_Peek(RF_TLM_FrameQueue_t *Queue)
+{
+    if (Queue->Count == 0)
+    {
+        return NULL;
+    }
+
+    return &Queue->Frames[Queue->Head];
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_Queue_Pop() -- Discard the oldest frame                  */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void RF_TLM_Queue_Pop(RF_TLM_FrameQueue_t *Queue)
+{
+    if (Queue->Count == 0)
+    {
+        return;
+    }
+
+    Queue->Head = (uint16)((Queue->Head + 1) % Queue->Depth);
+    --Queue->Count;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_Queue_PeekNewest() -- Newest frame, or NULL if empty     */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+RF_TLM_Frame_t *RF_TLM_Queue_PeekNewest(RF_TLM_FrameQueue_t *Queue)
+{
+    if (Queue->Count == 0)
+    {
+        return NULL;
+    }
+
+    return &Queue->Frames[(Queue->Head + Queue->Count - 1u) % Queue->Depth];
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_Queue_PopNewest() -- Discard the newest frame            */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void RF_TLM_Queue_PopNewest(RF_TLM_FrameQueue_t *Queue)
+{
+    if (Queue->Count == 0)
+    {
+        return;
+    }
+
+    --Queue->Count;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_Queue_SetLimit() -- Change the number of frames held.    */
+/*                            Frames above a lowered limit stay    */
+/*                            queued until they are sent           */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void RF_TLM_Queue_SetLimit(RF_TLM_FrameQueue_t *Queue, uint16 Limit)
+{
+    if (Limit == 0 || Limit > Queue->Depth)
+    {
+        Limit = Queue->Depth;
+    }
+
+    Queue->Limit = Limit;
+}
@@ -0,0 +1,81 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ * Outgoing RF frame queue for the RF Telemetry Output App
+ */
+
+#ifndef RF_TLM_QUEUE_H
+#define RF_TLM_QUEUE_H
+
+#include "cfe.h"
+
+/*
+** Largest frame the RF microcontroller accepts in one I2C write
+*/
+#define RF_TLM_MAX_FRAME_BYTES 32
+
+/*
+** An encoded frame waiting for the device
+*/
+typedef struct
+{
+    CFE_SB_MsgId_t     MsgId;                        /**< \brief Source of the frame */
+    CFE_TIME_SysTime_t SampleTime;                   /**< \brief Time the source sampled the data */
+    uint16             Length;                       /**< \brief Number of valid bytes in Data */
+    uint8              Data[RF_TLM_MAX_FRAME_BYTES]; /**< \brief Encoded frame */
+} RF_TLM_Frame_t;
+
+/*
+** A frame taken into buffered output (transfer frames, compressed blocks),
+** accounted as sent once the bytes that end it are written
+*/
+typedef struct
+{
+    CFE_TIME_SysTime_t SampleTime; /**< \brief Time the source sampled the data */
+    uint8              Flags;      /**< \brief RF_TLM_SENT_* */
+} RF_TLM_Sent_t;
+
+#define RF_TLM_SENT_EVENT 0x01 /* Event lane frame */
+#define RF_TLM_SENT_SNAP  0x02 /* Snapshot frame */
+
+/*
+** Fixed-size ring of frames. When Limit frames are held the oldest one is
+** dropped so the freshest data is always kept.
+*/
+typedef struct
+{
+    RF_TLM_Frame_t *Frames;       /**< \brief Storage, Depth entries */
+    uint16          Depth;        /**< \brief Capacity in frames */
+    uint16          Limit;        /**< \brief Frames held before the oldest is dropped, at most Depth */
+    uint16          Head;         /**< \brief Index of the oldest frame */
+    uint16          Count;        /**< \brief Frames currently queued */
+    uint32          DroppedCount; /**< \brief Frames dropped on overflow */
+} RF_TLM_FrameQueue_t;
+
+void            RF_TLM_Queue_Init(RF_TLM_FrameQueue_t *Queue, RF_TLM_Frame_t *Storage, uint16 Depth);
+bool            RF_TLM_Queue_Push(RF_TLM_FrameQueue_t *Queue, const RF_TLM_Frame_t *Frame);
+RF_TLM_Frame_t *RF_TLM_Queue_Peek(RF_TLM_FrameQueue_t *Queue);
+void            RF_TLM_Queue_Pop(RF_TLM_FrameQueue_t *Queue);
+RF_TLM_Frame_t *RF_TLM_Queue_PeekNewest(RF_TLM_FrameQueue_t *Queue);
+void            RF_TLM_Queue_PopNewest(RF_TLM_FrameQueue_t *Queue);
+void            RF_TLM_Queue_SetLimit(RF_TLM_FrameQueue_t *Queue, uint16 Limit);
+
+#endif /* RF_TLM_QUEUE_H */
@@ -0,0 +1,82 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * \file
+ *   Per-MID rate shaping for the RF Telemetry Output App.
+ *
+ *   Each source can be decimated (only every Nth sample is forwarded) and
+ *   throttled (samples closer than a minimum interval to the last forwarded
+ *   one are dropped). Both filters run on every received sample, so the
+ *   decimation phase is kept even while the interval filter is suppressing.
+ */
+
+#include "rf_tlm_rate.h"
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_Rate_Set() -- Configure decimation and minimum interval  */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void RF_TLM_Rate_Set(RF_TLM_RateState_t *Rate, uint16 Decimation, uint32 MinIntervalMsec)
+{
+    Rate->Decimation      = Decimation;
+    Rate->MinIntervalMsec = MinIntervalMsec;
+    Rate->DecimCount      = 0;
+    Rate->HasSent         = false;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_Rate_Admit() -- Decide whether a sample is forwarded     */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+bool RF_TLM_Rate_Admit(RF_TLM_RateState_t *Rate, uint32 NowMsec)
+{
+    bool admit = true;
+
+    if (Rate->Decimation > 1)
+    {
+        admit = (Rate->DecimCount == 0);
+
+        ++Rate->DecimCount;
+        if (Rate->DecimCount >= Rate->Decimation)
+        {
+            Rate->DecimCount = 0;
+        }
+    }
+
+    /* Unsigned subtraction keeps the comparison valid across wraparound */
+    if (admit && Rate->MinIntervalMsec != 0 && Rate->HasSent &&
+        (uint32)(NowMsec - Rate->LastSentMsec) < Rate->MinIntervalMsec)
+    {
+        admit = false;
+    }
+
+    if (admit)
+    {
+        Rate->LastSentMsec = NowMsec;
+        Rate->HasSent      = true;
+    }
+    else
+    {
+        ++Rate->SuppressedCount;
+    }
+
+    return admit;
+}
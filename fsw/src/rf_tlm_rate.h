@@ -0,0 +1,47 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ * Per-MID rate shaping (decimation and minimum interval) for the RF
+ * Telemetry Output App
+ */
+
+#ifndef RF_TLM_RATE_H
+#define RF_TLM_RATE_H
+
+#include "cfe.h"
+
+/*
+** Rate shaping state kept for every forwarded source
+*/
+typedef struct
+{
+    uint16 Decimation;      /**< \brief Forward every Nth sample, 0 or 1 forwards all */
+    uint16 DecimCount;      /**< \brief Samples seen since the last admitted one */
+    uint32 MinIntervalMsec; /**< \brief Minimum time between forwarded samples, 0 disables */
+    uint32 LastSentMsec;    /**< \brief Time the last sample was admitted */
+    bool   HasSent;         /**< \brief LastSentMsec is valid */
+    uint32 SuppressedCount; /**< \brief Samples dropped by decimation or interval */
+} RF_TLM_RateState_t;
+
+void RF_TLM_Rate_Set(RF_TLM_RateState_t *Rate, uint16 Decimation, uint32 MinIntervalMsec);
+bool RF_TLM_Rate_Admit(RF_TLM_RateState_t *Rate, uint32 NowMsec);
+
+#endif /* RF_TLM_RATE_H */
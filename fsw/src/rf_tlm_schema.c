@@ -0,0 +1,99 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * \file
+ *   Declared field widths of every forwarded source.
+ *
+ *   The schema ID sent in packed frames is the index in this table, so the
+ *   flight app and the ground decoder must be built from the same copy.
+ *   Entries must follow the RF packet each app fills in; fields an app
+ *   leaves at zero are marked unused and cost nothing on the link.
+ */
+
+#include "rf_tlm_pack.h"
+
+#include "imu_app_msgids.h"
+#include "altitude_app_msgids.h"
+#include "temp_app_msgids.h"
+#include "blinky_msgids.h"
+
+const RF_TLM_Schema_t RF_TLM_Schemas[] = {
+    {
+        /* Accelerations in g, +/-16 g at 1 mg; angular rates in deg/s, +/-2000 at 0.1 */
+        .MsgId       = IMU_APP_RF_DATA_MID,
+        .Name        = "imu",
+        .CounterBits = 4,
+        .BigEndian   = 0,
+        .Fields      = {
+            {RF_TLM_FIELD_FLOAT, 15, -16.0f, 0.001f},
+            {RF_TLM_FIELD_FLOAT, 15, -16.0f, 0.001f},
+            {RF_TLM_FIELD_FLOAT, 15, -16.0f, 0.001f},
+            {RF_TLM_FIELD_FLOAT, 16, -2000.0f, 0.1f},
+            {RF_TLM_FIELD_FLOAT, 16, -2000.0f, 0.1f},
+            {RF_TLM_FIELD_FLOAT, 16, -2000.0f, 0.1f},
+        },
+    },
+    {
+        /* LED state and a 16-bit blink counter */
+        .MsgId       = BLINKY_RF_DATA_MID,
+        .Name        = "blinky",
+        .CounterBits = 4,
+        .BigEndian   = 0,
+        .Fields      = {
+            {RF_TLM_FIELD_UINT, 1, 0.0f, 0.0f},
+            {RF_TLM_FIELD_UINT, 16, 0.0f, 0.0f},
+            {RF_TLM_FIELD_UNUSED, 0, 0.0f, 0.0f},
+            {RF_TLM_FIELD_UNUSED, 0, 0.0f, 0.0f},
+            {RF_TLM_FIELD_UNUSED, 0, 0.0f, 0.0f},
+            {RF_TLM_FIELD_UNUSED, 0, 0.0f, 0.0f},
+        },
+    },
+    {
+        /* Altitude in m at 0.1 m, pressure in Pa at 1 Pa, temperature in degC at 0.01 */
+        .MsgId       = ALTITUDE_APP_RF_DATA_MID,
+        .Name        = "altitude",
+        .CounterBits = 4,
+        .BigEndian   = 0,
+        .Fields      = {
+            {RF_TLM_FIELD_FLOAT, 17, -500.0f, 0.1f},
+            {RF_TLM_FIELD_FLOAT, 17, 0.0f, 1.0f},
+            {RF_TLM_FIELD_FLOAT, 14, -40.0f, 0.01f},
+            {RF_TLM_FIELD_UNUSED, 0, 0.0f, 0.0f},
+            {RF_TLM_FIELD_UNUSED, 0, 0.0f, 0.0f},
+            {RF_TLM_FIELD_UNUSED, 0, 0.0f, 0.0f},
+        },
+    },
+    {
+        /* Temperature in degC at 0.01, raw 12-bit ADC reading */
+        .MsgId       = TEMP_APP_RF_DATA_MID,
+        .Name        = "temp",
+        .CounterBits = 4,
+        .BigEndian   = 0,
+        .Fields      = {
+            {RF_TLM_FIELD_FLOAT, 15, -55.0f, 0.01f},
+            {RF_TLM_FIELD_UINT, 12, 0.0f, 0.0f},
+            {RF_TLM_FIELD_UNUSED, 0, 0.0f, 0.0f},
+            {RF_TLM_FIELD_UNUSED, 0, 0.0f, 0.0f},
+            {RF_TLM_FIELD_UNUSED, 0, 0.0f, 0.0f},
+            {RF_TLM_FIELD_UNUSED, 0, 0.0f, 0.0f},
+        },
+    },
+};
+
+const uint8_t RF_TLM_SchemaCount = sizeof(RF_TLM_Schemas) / sizeof(RF_TLM_Schemas[0]);
@@ -0,0 +1,148 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * \file
+ *   Frame sequence numbers and time references for the RF Telemetry Output
+ *   App.
+ *
+ *   Sequence numbers and time deltas are stamped when a frame is handed to
+ *   the uC rather than when it is queued, and the sequence only advances
+ *   once the uC accepts the frame. A gap seen on the ground is therefore a
+ *   frame lost after the uC, not one dropped by the queue or the rate
+ *   filters.
+ *
+ *   The reference time is the sample time of the frame that needed it, so
+ *   that frame goes out with a zero delta.
+ */
+
+#include "rf_tlm_seq.h"
+#include "rf_tlm_frame.h"
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_Seq_Init() -- Reset the link state of a destination      */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void RF_TLM_Seq_Init(RF_TLM_Dest_t *Dest, uint16 Addr)
+{
+    memset(Dest, 0, sizeof(*Dest));
+    Dest->Addr = Addr;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_Seq_Delta() -- Time of a sample after the reference, or  */
+/*                       false if a new reference must go first    */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+bool RF_TLM_Seq_Delta(const RF_TLM_Dest_t *Dest, CFE_TIME_SysTime_t SampleTime, uint16 *DeltaMsec)
+{
+    CFE_TIME_SysTime_t diff;
+    uint32             msec;
+
+    if (!Dest->RefValid || Dest->FramesSinceRef >= RF_TLM_TIMEREF_PERIOD_FRAMES)
+    {
+        return false;
+    }
+
+    /* Deltas are unsigned, a sample older than the reference needs a new one */
+    if (CFE_TIME_Compare(SampleTime, Dest->RefTime) == CFE_TIME_A_LT_B)
+    {
+        return false;
+    }
+
+    diff = CFE_TIME_Subtract(SampleTime, Dest->RefTime);
+    if (diff.Seconds > RF_TLM_DT_MAX_MSEC / 1000)
+    {
+        return false;
+    }
+
+    msec = diff.Seconds * 1000 + CFE_TIME_Sub2MicroSecs(diff.Subseconds) / 1000;
+    if (msec > RF_TLM_DT_MAX_MSEC)
+    {
+        return false;
+    }
+
+    *DeltaMsec = (uint16)msec;
+
+    return true;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_Seq_BuildTimeRef() -- Encode a time reference frame      */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void RF_TLM_Seq_BuildTimeRef(RF_TLM_Dest_t *Dest, CFE_TIME_SysTime_t RefTime, RF_TLM_Frame_t *Frame)
+{
+    Frame->MsgId   = CFE_SB_INVALID_MSG_ID;
+    Frame->Length  = RF_TLM_TIMEREF_FRAME_BYTES;
+    Frame->Data[0] = RF_TLM_FRAME_TIMEREF;
+
+    RF_TLM_Frame_PutU16(&Frame->Data[RF_TLM_TIMEREF_SEQ_OFFSET], Dest->Seq);
+    RF_TLM_Frame_PutU32(&Frame->Data[RF_TLM_TIMEREF_SECONDS_OFFSET], RefTime.Seconds);
+    RF_TLM_Frame_PutU32(&Frame->Data[RF_TLM_TIMEREF_SUBSECS_OFFSET], RefTime.Subseconds);
+
+    Dest->PendingRefTime = RefTime;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_Seq_Stamp() -- Write sequence and delta into a frame     */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void RF_TLM_Seq_Stamp(const RF_TLM_Dest_t *Dest, RF_TLM_Frame_t *Frame, uint16 DeltaMsec)
+{
+    int offset;
+
+    offset = RF_TLM_Frame_SeqOffset(Frame->Data, Frame->Length);
+    if (offset >= 0)
+    {
+        RF_TLM_Frame_PutU16(&Frame->Data[offset], Dest->Seq);
+    }
+
+    offset = RF_TLM_Frame_DtOffset(Frame->Data, Frame->Length);
+    if (offset >= 0)
+    {
+        RF_TLM_Frame_PutU16(&Frame->Data[offset], DeltaMsec);
+    }
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_Seq_Accepted() -- Advance the link state once the uC has */
+/*                          taken a frame                          */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void RF_TLM_Seq_Accepted(RF_TLM_Dest_t *Dest, const RF_TLM_Frame_t *Frame)
+{
+    ++Dest->Seq;
+
+    if (Frame->Length > 0 && Frame->Data[0] == RF_TLM_FRAME_TIMEREF)
+    {
+        Dest->RefTime        = Dest->PendingRefTime;
+        Dest->RefValid       = true;
+        Dest->FramesSinceRef = 0;
+        ++Dest->TimeRefCount;
+    }
+    else if (Dest->FramesSinceRef < 0xFFFF)
+    {
+        ++Dest->FramesSinceRef;
+    }
+}
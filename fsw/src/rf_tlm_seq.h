@@ -0,0 +1,59 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ * Frame sequence numbers and time references for the RF Telemetry Output
+ * App
+ */
+
+#ifndef RF_TLM_SEQ_H
+#define RF_TLM_SEQ_H
+
+#include "cfe.h"
+
+#include "rf_tlm_queue.h"
+
+/*
+** A time reference is resent after this many frames even when the deltas
+** still fit, so a receiver that joins late or lost the last one resyncs
+*/
+#define RF_TLM_TIMEREF_PERIOD_FRAMES 64
+
+/*
+** Link state kept for each frame destination
+*/
+typedef struct
+{
+    uint16             Addr;           /**< \brief Destination address on the bus */
+    uint16             Seq;            /**< \brief Sequence number of the next frame */
+    CFE_TIME_SysTime_t RefTime;        /**< \brief Time carried by the last accepted reference */
+    CFE_TIME_SysTime_t PendingRefTime; /**< \brief Time carried by the reference being sent */
+    bool               RefValid;       /**< \brief RefTime has reached the destination */
+    uint16             FramesSinceRef; /**< \brief Frames accepted since the last reference */
+    uint32             TimeRefCount;   /**< \brief References accepted */
+} RF_TLM_Dest_t;
+
+void RF_TLM_Seq_Init(RF_TLM_Dest_t *Dest, uint16 Addr);
+bool RF_TLM_Seq_Delta(const RF_TLM_Dest_t *Dest, CFE_TIME_SysTime_t SampleTime, uint16 *DeltaMsec);
+void RF_TLM_Seq_BuildTimeRef(RF_TLM_Dest_t *Dest, CFE_TIME_SysTime_t RefTime, RF_TLM_Frame_t *Frame);
+void RF_TLM_Seq_Stamp(const RF_TLM_Dest_t *Dest, RF_TLM_Frame_t *Frame, uint16 DeltaMsec);
+void RF_TLM_Seq_Accepted(RF_TLM_Dest_t *Dest, const RF_TLM_Frame_t *Frame);
+
+#endif /* RF_TLM_SEQ_H */
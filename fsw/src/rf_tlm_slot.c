@@ -0,0 +1,280 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * \file
+ *   Time-slotted transmission for the RF Telemetry Output App.
+ *
+ *   The slot table cuts CFE time into periods of PeriodMsec, each holding up
+ *   to RF_TLM_MAX_SLOTS windows. Frames stay in their queues outside the
+ *   windows and are released inside them at the active profile's pace. No
+ *   frame is started within GuardMsec of a window end, so a transfer in
+ *   progress cannot spill into the next vehicle's slot. Vehicles sharing a
+ *   frequency share the CFE time source and get windows that do not
+ *   overlap.
+ *
+ *   Slot boundaries follow CFE time, the run loop wakes on them through
+ *   RF_TLM_Slot_WaitMsec(). The delay from a slot start to the first check
+ *   that sees it open is reported as its lateness, and the bus time of the
+ *   frames released in a slot as its utilization.
+ *
+ *   A period of 0 leaves the output free running, paced by the profile only.
+ */
+
+#include <string.h>
+
+#include "rf_tlm_events.h"
+#include "rf_tlm.h"
+
+/*
+** Checks further apart than this, or CFE time going backwards, restart the
+** slot accounting instead of counting every slot in between as missed
+*/
+#define RF_TLM_SLOT_RESYNC_MSEC 60000
+
+/*
+** Table loaded at startup. Free running; two vehicles splitting a one
+** second period would load, for instance,
+**   { .PeriodMsec = 1000, .GuardMsec = 10, .Windows = {{0, 450}} }
+**   { .PeriodMsec = 1000, .GuardMsec = 10, .Windows = {{500, 450}} }
+*/
+static const RF_TLM_SlotTable_t RF_TLM_SlotDefaults = {
+    .PeriodMsec = 0,
+};
+
+/*
+** CFE time in milliseconds, the clock the slots are aligned to
+*/
+static uint64 RF_TLM_Slot_NowMsec(void)
+{
+    CFE_TIME_SysTime_t now = CFE_TIME_GetTime();
+
+    return (uint64)now.Seconds * 1000u + CFE_TIME_Sub2MicroSecs(now.Subseconds) / 1000u;
+}
+
+/*
+** Place a time in the table. Started is the number of windows started up to
+** then, so it identifies the open window or the last one that closed.
+** Returns true inside a window, with Window its index, Elapsed the time
+** since it started and Remaining the time left in it; outside, Remaining is
+** the time to the next window start.
+*/
+static bool RF_TLM_Slot_Locate(uint64 NowMsec, uint64 *Started, uint8 *Window, uint32 *Elapsed, uint32 *Remaining)
+{
+    const RF_TLM_SlotTable_t *Table = &RF_TLM_Data.Slot.Table;
+    uint8                     n     = RF_TLM_Data.Slot.Count;
+    uint32                    pos   = (uint32)(NowMsec % Table->PeriodMsec);
+    uint32                    end;
+    uint8                     w;
+
+    for (w = 0; w < n && Table->Windows[w].OffsetMsec <= pos; w++)
+    {
+    }
+
+    *Started = (NowMsec / Table->PeriodMsec) * n + w;
+
+    if (w > 0)
+    {
+        end = Table->Windows[w - 1].OffsetMsec + Table->Windows[w - 1].LengthMsec;
+        if (pos < end)
+        {
+            *Window    = w - 1;
+            *Elapsed   = pos - Table->Windows[w - 1].OffsetMsec;
+            *Remaining = end - pos;
+            return true;
+        }
+    }
+
+    *Remaining = (w < n) ? Table->Windows[w].OffsetMsec - pos : Table->PeriodMsec - pos + Table->Windows[0].OffsetMsec;
+
+    return false;
+}
+
+/*
+** Account for the slot that just closed
+*/
+static void RF_TLM_Slot_Close(void)
+{
+    RF_TLM_Slot_t *Slot = &RF_TLM_Data.Slot;
+    uint64         util;
+
+    util = Slot->SlotBusNs / ((uint64)Slot->Table.Windows[Slot->Window].LengthMsec * 1000u);
+    Slot->UtilPermille = (util > 1000) ? 1000 : (uint16)util;
+
+    if (Slot->SlotFrames > 0)
+    {
+        ++Slot->SlotsUsed;
+    }
+
+    Slot->InSlot = false;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_Slot_Init() -- Load the startup slot table               */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void RF_TLM_Slot_Init(void)
+{
+    memset(&RF_TLM_Data.Slot, 0, sizeof(RF_TLM_Data.Slot));
+
+    RF_TLM_Slot_Load(&RF_TLM_SlotDefaults);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_Slot_Load() -- Check and activate a slot table, false    */
+/*                       leaves the active one in place            */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+bool RF_TLM_Slot_Load(const RF_TLM_SlotTable_t *Table)
+{
+    RF_TLM_Slot_t *Slot  = &RF_TLM_Data.Slot;
+    uint32         start = 0;
+    uint8          n;
+
+    for (n = 0; n < RF_TLM_MAX_SLOTS && Table->Windows[n].LengthMsec != 0; n++)
+    {
+        /* Windows are in order, do not overlap and leave room for a frame after the guard */
+        if (Table->Windows[n].OffsetMsec < start ||
+            (uint32)Table->Windows[n].OffsetMsec + Table->Windows[n].LengthMsec > Table->PeriodMsec ||
+            Table->Windows[n].LengthMsec <= Table->GuardMsec)
+        {
+            return false;
+        }
+        start = Table->Windows[n].OffsetMsec + Table->Windows[n].LengthMsec;
+    }
+
+    if (Table->PeriodMsec > RF_TLM_SLOT_MAX_PERIOD_MSEC || (Table->PeriodMsec != 0 && n == 0))
+    {
+        return false;
+    }
+
+    Slot->Table  = *Table;
+    Slot->Count  = (Table->PeriodMsec == 0) ? 0 : n;
+    Slot->Synced = false;
+    Slot->InSlot = false;
+
+    return true;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_Slot_Open() -- Whether a frame may be started now        */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+bool RF_TLM_Slot_Open(void)
+{
+    RF_TLM_Slot_t *Slot = &RF_TLM_Data.Slot;
+    uint64         now;
+    uint64         started;
+    uint8          window = 0;
+    uint32         elapsed = 0;
+    uint32         remaining;
+    bool           in;
+
+    if (Slot->Count == 0)
+    {
+        return true;
+    }
+
+    now = RF_TLM_Slot_NowMsec();
+    in  = RF_TLM_Slot_Locate(now, &started, &window, &elapsed, &remaining);
+
+    if (!Slot->Synced || now < Slot->LastCheckMsec || now - Slot->LastCheckMsec > RF_TLM_SLOT_RESYNC_MSEC)
+    {
+        /* Count the window open now, if any, as seen for the first time */
+        Slot->InSlot    = false;
+        Slot->LastIndex = in ? started - 1 : started;
+        Slot->Synced    = true;
+    }
+    Slot->LastCheckMsec = now;
+
+    if (started != Slot->LastIndex)
+    {
+        if (Slot->InSlot)
+        {
+            RF_TLM_Slot_Close();
+        }
+
+        /* Every window started since the last check but the open one went by unseen */
+        Slot->SlotsMissed += (uint32)(started - Slot->LastIndex) - (in ? 1 : 0);
+        Slot->LastIndex = started;
+
+        if (in)
+        {
+            Slot->InSlot     = true;
+            Slot->Window     = window;
+            Slot->SlotFrames = 0;
+            Slot->SlotBusNs  = 0;
+            Slot->LateMsec   = (uint16)elapsed;
+            if (Slot->LateMsec > Slot->LateMaxMsec)
+            {
+                Slot->LateMaxMsec = Slot->LateMsec;
+            }
+            ++Slot->Slots;
+        }
+    }
+    else if (Slot->InSlot && !in)
+    {
+        RF_TLM_Slot_Close();
+    }
+
+    return in && remaining > Slot->Table.GuardMsec;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_Slot_Released() -- Charge a sent frame to the open slot  */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void RF_TLM_Slot_Released(uint64 BusNs)
+{
+    RF_TLM_Slot_t *Slot = &RF_TLM_Data.Slot;
+
+    if (Slot->InSlot)
+    {
+        ++Slot->SlotFrames;
+        ++Slot->Frames;
+        Slot->SlotBusNs += BusNs;
+    }
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_Slot_WaitMsec() -- How long the run loop may pend        */
+/*                           before the next slot boundary         */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+uint32 RF_TLM_Slot_WaitMsec(uint32 MaxMsec)
+{
+    uint64 started;
+    uint8  window;
+    uint32 elapsed;
+    uint32 remaining;
+
+    if (RF_TLM_Data.Slot.Count == 0)
+    {
+        return MaxMsec;
+    }
+
+    /* Inside a window this wakes the loop at its end, to find the next start */
+    RF_TLM_Slot_Locate(RF_TLM_Slot_NowMsec(), &started, &window, &elapsed, &remaining);
+
+    return (remaining < MaxMsec) ? remaining : MaxMsec;
+}
@@ -0,0 +1,59 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ * Time-slotted transmission for the RF Telemetry Output App
+ */
+
+#ifndef RF_TLM_SLOT_H
+#define RF_TLM_SLOT_H
+
+#include "cfe.h"
+
+#include "rf_tlm_msg.h"
+
+typedef struct
+{
+    RF_TLM_SlotTable_t Table;         /**< \brief Active slot table */
+    uint8              Count;         /**< \brief Windows in use in Table */
+    bool               Synced;        /**< \brief LastIndex is valid */
+    bool               InSlot;        /**< \brief A slot was open at the last check */
+    uint8              Window;        /**< \brief Table window of the open slot */
+    uint64             LastIndex;     /**< \brief Windows started up to the last check */
+    uint64             LastCheckMsec; /**< \brief CFE time of the last check */
+    uint64             SlotStartMsec; /**< \brief CFE time the open slot started */
+    uint64             SlotBusNs;     /**< \brief Bus time of the frames released in the open slot */
+    uint16             SlotFrames;    /**< \brief Frames released in the open slot */
+    uint32             Slots;         /**< \brief Slots the scheduler saw open */
+    uint32             SlotsUsed;     /**< \brief Slots in which at least one frame was released */
+    uint32             SlotsMissed;   /**< \brief Slots that opened and closed between two checks */
+    uint32             Frames;        /**< \brief Frames released in slots */
+    uint16             UtilPermille;  /**< \brief Bus time share of the last closed slot */
+    uint16             LateMsec;      /**< \brief Slot start to first check, last slot */
+    uint16             LateMaxMsec;   /**< \brief Slot start to first check, worst slot */
+} RF_TLM_Slot_t;
+
+void   RF_TLM_Slot_Init(void);
+bool   RF_TLM_Slot_Load(const RF_TLM_SlotTable_t *Table);
+bool   RF_TLM_Slot_Open(void);
+void   RF_TLM_Slot_Released(uint64 BusNs);
+uint32 RF_TLM_Slot_WaitMsec(uint32 MaxMsec);
+
+#endif /* RF_TLM_SLOT_H */
@@ -0,0 +1,146 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * \file
+ *   On-demand telemetry snapshots of the RF Telemetry Output App.
+ *
+ *   Every sample received from a source is kept as the source's latest,
+ *   whether or not it is forwarded, in a fixed slot indexed like
+ *   RF_TLM_Data.Sources: one copy of the fixed sample layout per message.
+ *
+ *   A snapshot request from the ground queues the latest sample of each
+ *   named source, encoded as the source's raw or packed frames are, on a
+ *   queue served right after the event lane and sent without waiting for
+ *   the send interval. A source can be put on pull at the same time, and
+ *   is then sent on request only; its samples are still kept.
+ *
+ *   Fragment-encoded sources are forwarded whole, which the fixed copy
+ *   cannot rebuild, so they are neither snapshotted nor put on pull. A
+ *   request naming one counts it as missing.
+ */
+
+#include <string.h>
+
+#include "rf_tlm_events.h"
+#include "rf_tlm.h"
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_Snap_Init() -- Empty the cache and the snapshot queue    */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void RF_TLM_Snap_Init(void)
+{
+    RF_TLM_Snap_t *Snap = &RF_TLM_Data.Snap;
+
+    memset(Snap, 0, sizeof(*Snap));
+    RF_TLM_Queue_Init(&Snap->Queue, Snap->Store, RF_TLM_SNAP_QUEUE_DEPTH);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_Snap_Keep() -- Keep a received message as its source's   */
+/*                       latest sample                             */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void RF_TLM_Snap_Keep(uint16 Index, const CFE_SB_Buffer_t *TlmMsgPtr)
+{
+    RF_TLM_SnapSample_t *Latest = &RF_TLM_Data.Snap.Latest[Index];
+    CFE_MSG_Size_t       MsgSize;
+
+    /* Snapshots are encoded from the fixed sample layout, a shorter message keeps the previous sample */
+    CFE_MSG_GetSize(&TlmMsgPtr->Msg, &MsgSize);
+    if (MsgSize < sizeof(Latest->Sample))
+    {
+        return;
+    }
+
+    memcpy(&Latest->Sample, TlmMsgPtr, sizeof(Latest->Sample));
+    CFE_MSG_GetMsgTime(&TlmMsgPtr->Msg, &Latest->SampleTime);
+    if (Latest->SampleTime.Seconds == 0 && Latest->SampleTime.Subseconds == 0)
+    {
+        /* Source did not timestamp the packet */
+        Latest->SampleTime = CFE_TIME_GetTime();
+    }
+    Latest->Valid = true;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_Snap_Allowed() -- Whether a source can be snapshotted    */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+bool RF_TLM_Snap_Allowed(uint16 Index)
+{
+#if RF_TLM_CFG_ENC_FRAGMENT
+    return RF_TLM_Data.Sources[Index].Encoding != RF_TLM_ENC_FRAGMENT;
+#else
+    (void)Index;
+    return true;
+#endif
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_Snap_Queue() -- Queue the latest sample of a source,     */
+/*                        false when none arrived yet              */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+bool RF_TLM_Snap_Queue(uint16 Index)
+{
+    RF_TLM_Snap_t       *Snap   = &RF_TLM_Data.Snap;
+    RF_TLM_SnapSample_t *Latest = &Snap->Latest[Index];
+    RF_TLM_Frame_t       Frame;
+
+    /* Only the fixed sample layout is kept, a whole message cannot be rebuilt for a fragment source */
+    if (!Latest->Valid || !RF_TLM_Snap_Allowed(Index))
+    {
+        ++Snap->Missing;
+        return false;
+    }
+
+    /* Encoded as the forwarding path does */
+    RF_TLM_store_sample(&Latest->Sample);
+    Frame.MsgId      = RF_TLM_Data.Sources[Index].MsgId;
+    Frame.SampleTime = Latest->SampleTime;
+    RF_TLM_encode_frame(&Frame, &RF_TLM_Data.Sources[Index]);
+
+    RF_TLM_Queue_Push(&Snap->Queue, &Frame);
+    ++Snap->Queued;
+
+    return true;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_Snap_Sent() -- Account a snapshot frame the uC accepted  */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void RF_TLM_Snap_Sent(void)
+{
+    RF_TLM_Snap_t *Snap = &RF_TLM_Data.Snap;
+    uint32         msec = RF_TLM_GetMsec() - Snap->RequestMsec;
+
+    ++Snap->Sent;
+    Snap->LatencyMsec = (uint16)((msec > 0xFFFF) ? 0xFFFF : msec);
+    if (Snap->LatencyMsec > Snap->LatencyMaxMsec)
+    {
+        Snap->LatencyMaxMsec = Snap->LatencyMsec;
+    }
+}
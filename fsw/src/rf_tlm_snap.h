@@ -0,0 +1,67 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ * On-demand telemetry snapshots of the RF Telemetry Output App
+ */
+
+#ifndef RF_TLM_SNAP_H
+#define RF_TLM_SNAP_H
+
+#include "cfe.h"
+
+#include "rf_tlm_msg.h"
+#include "rf_tlm_queue.h"
+
+#define RF_TLM_SNAP_QUEUE_DEPTH RF_TLM_MAX_SOURCES /* One request for every source fits */
+
+/*
+** Latest sample received from a source
+*/
+typedef struct
+{
+    SUBS_APP_OutData_t Sample;     /**< \brief Fixed sample layout, header included */
+    CFE_TIME_SysTime_t SampleTime; /**< \brief Time the source sampled it */
+    bool               Valid;      /**< \brief A sample was received since startup */
+} RF_TLM_SnapSample_t;
+
+typedef struct
+{
+    RF_TLM_SnapSample_t Latest[RF_TLM_MAX_SOURCES];     /**< \brief Per source, in RF_TLM_Data.Sources order */
+    RF_TLM_FrameQueue_t Queue;                          /**< \brief Served after events, ahead of the rest */
+    RF_TLM_Frame_t      Store[RF_TLM_SNAP_QUEUE_DEPTH];
+    uint8               PullMask;       /**< \brief Bit i set while source i is sent on request only */
+    uint32              RequestMsec;    /**< \brief Time of the last request */
+    uint32              Requests;       /**< \brief Snapshot commands accepted */
+    uint32              Queued;         /**< \brief Snapshot frames queued */
+    uint32              Missing;        /**< \brief Sources requested with no sample to send */
+    uint32              Sent;           /**< \brief Snapshot frames accepted by the uC */
+    uint32              Held;           /**< \brief Samples of pull sources kept without being forwarded */
+    uint16              LatencyMsec;    /**< \brief Last request to uC acceptance of a frame it queued */
+    uint16              LatencyMaxMsec; /**< \brief Worst of the above */
+} RF_TLM_Snap_t;
+
+void RF_TLM_Snap_Init(void);
+void RF_TLM_Snap_Keep(uint16 Index, const CFE_SB_Buffer_t *TlmMsgPtr);
+bool RF_TLM_Snap_Allowed(uint16 Index);
+bool RF_TLM_Snap_Queue(uint16 Index);
+void RF_TLM_Snap_Sent(void);
+
+#endif /* RF_TLM_SNAP_H */
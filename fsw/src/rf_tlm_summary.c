@@ -0,0 +1,187 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * \file
+ *   Windowed field statistics for the RF Telemetry Output App.
+ *
+ *   A summarized source is not forwarded sample by sample. Each sample
+ *   updates the minimum, maximum, sum and last value of the configured
+ *   fields, and when the window has run out one summary frame per field is
+ *   queued instead. Windows are timed from the arrival of their first
+ *   sample, so a source that stops publishing leaves no empty windows.
+ *
+ *   Field values are read with the source's pack schema, as the deadband
+ *   reads them, and sent as float32 whatever the field kind.
+ */
+
+#include <math.h>
+#include <string.h>
+
+#include "rf_tlm_summary.h"
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_Summary_Init() -- Start a source on raw forwarding       */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void RF_TLM_Summary_Init(RF_TLM_Summary_t *Summary)
+{
+    memset(Summary, 0, sizeof(*Summary));
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_Summary_Configure() -- Set the window and the fields,    */
+/*                               dropping the window in progress   */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void RF_TLM_Summary_Configure(RF_TLM_Summary_t *Summary, uint32 WindowMsec, uint8 FieldMask)
+{
+    Summary->WindowMsec = WindowMsec;
+    Summary->FieldMask  = (WindowMsec != 0) ? FieldMask : 0;
+    Summary->Count      = 0;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_Summary_Add() -- Take a sample into the current window   */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void RF_TLM_Summary_Add(RF_TLM_Summary_t *Summary, const RF_TLM_Schema_t *Schema,
+                        const uint8 *const Groups[RF_TLM_RAW_FIELD_COUNT], uint32 NowMsec,
+                        CFE_TIME_SysTime_t SampleTime)
+{
+    RF_TLM_FieldSummary_t *Field;
+    double                 value;
+
+    if (Summary->Count == 0)
+    {
+        Summary->StartMsec = NowMsec;
+        memset(Summary->Fields, 0, sizeof(Summary->Fields));
+    }
+
+    for (uint8 f = 0; f < RF_TLM_RAW_FIELD_COUNT; f++)
+    {
+        if ((Summary->FieldMask & (1u << f)) == 0)
+        {
+            continue;
+        }
+
+        Field       = &Summary->Fields[f];
+        value       = RF_TLM_Pack_FieldValue(&Schema->Fields[f], RF_TLM_Pack_Word(Schema, Groups[f]));
+        Field->Last = value;
+        if (isnan(value))
+        {
+            continue;
+        }
+
+        if (Field->Valid == 0 || value < Field->Min)
+        {
+            Field->Min = value;
+        }
+        if (Field->Valid == 0 || value > Field->Max)
+        {
+            Field->Max = value;
+        }
+        Field->Sum += value;
+        ++Field->Valid;
+    }
+
+    /* The frame count field is 16 bits; longer windows keep their statistics */
+    if (Summary->Count < 0xFFFF)
+    {
+        ++Summary->Count;
+    }
+    Summary->LastMsec = NowMsec;
+    Summary->LastTime = SampleTime;
+    ++Summary->Samples;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_Summary_Due() -- The current window has run out          */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+bool RF_TLM_Summary_Due(const RF_TLM_Summary_t *Summary, uint32 NowMsec)
+{
+    return Summary->Count != 0 && (NowMsec - Summary->StartMsec) >= Summary->WindowMsec;
+}
+
+/*
+** Statistic as a big-endian float32
+*/
+static void RF_TLM_Summary_PutValue(uint8 *Dst, double Value)
+{
+    float  fval = (float)Value;
+    uint32 word;
+
+    memcpy(&word, &fval, sizeof(word));
+    RF_TLM_Frame_PutU32(Dst, word);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_Summary_BuildFrame() -- Summary frame of one field of    */
+/*                                the current window, returns its  */
+/*                                length                           */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+uint16 RF_TLM_Summary_BuildFrame(const RF_TLM_Summary_t *Summary, uint8 SchemaId, uint8 Field, uint8 *Out)
+{
+    const RF_TLM_FieldSummary_t *Stats = &Summary->Fields[Field];
+    uint32                       span  = Summary->LastMsec - Summary->StartMsec;
+
+    memset(Out, 0, RF_TLM_SUMMARY_FRAME_BYTES);
+
+    /* Sequence and time delta are stamped when the frame is sent */
+    Out[0]                            = RF_TLM_FRAME_SUMMARY;
+    Out[RF_TLM_SUMMARY_SCHEMA_OFFSET] = SchemaId;
+    Out[RF_TLM_SUMMARY_FIELD_OFFSET]  = Field;
+    Out[RF_TLM_SUMMARY_WINDOW_OFFSET] = Summary->WindowNum;
+    RF_TLM_Frame_PutU16(&Out[RF_TLM_SUMMARY_COUNT_OFFSET], Summary->Count);
+    RF_TLM_Frame_PutU16(&Out[RF_TLM_SUMMARY_SPAN_OFFSET], (uint16)((span > 0xFFFF) ? 0xFFFF : span));
+
+    if (Stats->Valid != 0)
+    {
+        RF_TLM_Summary_PutValue(&Out[RF_TLM_SUMMARY_MIN_OFFSET], Stats->Min);
+        RF_TLM_Summary_PutValue(&Out[RF_TLM_SUMMARY_MAX_OFFSET], Stats->Max);
+        RF_TLM_Summary_PutValue(&Out[RF_TLM_SUMMARY_MEAN_OFFSET], Stats->Sum / Stats->Valid);
+    }
+    else
+    {
+        RF_TLM_Summary_PutValue(&Out[RF_TLM_SUMMARY_MIN_OFFSET], NAN);
+        RF_TLM_Summary_PutValue(&Out[RF_TLM_SUMMARY_MAX_OFFSET], NAN);
+        RF_TLM_Summary_PutValue(&Out[RF_TLM_SUMMARY_MEAN_OFFSET], NAN);
+    }
+    RF_TLM_Summary_PutValue(&Out[RF_TLM_SUMMARY_LAST_OFFSET], Stats->Last);
+
+    return RF_TLM_SUMMARY_FRAME_BYTES;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_Summary_Close() -- End the current window                */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void RF_TLM_Summary_Close(RF_TLM_Summary_t *Summary)
+{
+    Summary->Count = 0;
+    ++Summary->WindowNum;
+    ++Summary->Windows;
+}
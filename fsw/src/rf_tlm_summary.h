@@ -0,0 +1,72 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ * Windowed field statistics for the RF Telemetry Output App
+ */
+
+#ifndef RF_TLM_SUMMARY_H
+#define RF_TLM_SUMMARY_H
+
+#include "cfe.h"
+
+#include "rf_tlm_frame.h"
+#include "rf_tlm_pack.h"
+
+/*
+** Running statistics of one field over the current window
+*/
+typedef struct
+{
+    uint16 Valid; /**< \brief Samples that were not NaN */
+    double Min;
+    double Max;
+    double Sum;
+    double Last;  /**< \brief Last value, NaN included */
+} RF_TLM_FieldSummary_t;
+
+/*
+** Summary state kept for every forwarded source. A window of zero leaves
+** the source on raw forwarding.
+*/
+typedef struct
+{
+    uint32                WindowMsec; /**< \brief Window length, 0 forwards every sample */
+    uint8                 FieldMask;  /**< \brief Bit i summarizes byte group i */
+    uint8                 WindowNum;  /**< \brief Rolling number of the current window */
+    uint16                Count;      /**< \brief Samples in the current window */
+    uint32                StartMsec;  /**< \brief Arrival of the first sample of the window */
+    uint32                LastMsec;   /**< \brief Arrival of the last one */
+    CFE_TIME_SysTime_t    LastTime;   /**< \brief Sample time of the last one */
+    RF_TLM_FieldSummary_t Fields[RF_TLM_RAW_FIELD_COUNT];
+    uint32                Samples;    /**< \brief Samples taken into summaries */
+    uint32                Windows;    /**< \brief Windows closed */
+} RF_TLM_Summary_t;
+
+void   RF_TLM_Summary_Init(RF_TLM_Summary_t *Summary);
+void   RF_TLM_Summary_Configure(RF_TLM_Summary_t *Summary, uint32 WindowMsec, uint8 FieldMask);
+void   RF_TLM_Summary_Add(RF_TLM_Summary_t *Summary, const RF_TLM_Schema_t *Schema,
+                          const uint8 *const Groups[RF_TLM_RAW_FIELD_COUNT], uint32 NowMsec,
+                          CFE_TIME_SysTime_t SampleTime);
+bool   RF_TLM_Summary_Due(const RF_TLM_Summary_t *Summary, uint32 NowMsec);
+uint16 RF_TLM_Summary_BuildFrame(const RF_TLM_Summary_t *Summary, uint8 SchemaId, uint8 Field, uint8 *Out);
+void   RF_TLM_Summary_Close(RF_TLM_Summary_t *Summary);
+
+#endif /* RF_TLM_SUMMARY_H */
@@ -0,0 +1,307 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * \file
+ *   RF uplink for the RF Telemetry Output App.
+ *
+ *   The uC keeps received uplink frames in a mailbox. Each poll reads the
+ *   header of the oldest one; when a command is pending its packet is read,
+ *   checked and published on the software bus as is, and an
+ *   acknowledgement frame is queued for the downlink. Polls run from the
+ *   same loop as the downlink sends, so the two never contend for the bus.
+ *
+ *   Polling is adaptive: the interval drops to RF_TLM_UPLINK_POLL_MIN_MSEC
+ *   when a command arrives and doubles on every empty poll, so an idle
+ *   uplink costs one 4-byte read every RF_TLM_UPLINK_POLL_MAX_MSEC.
+ */
+
+#include "rf_tlm_events.h"
+#include "rf_tlm.h"
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_Uplink_Init() -- Start polling at the slowest interval   */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void RF_TLM_Uplink_Init(void)
+{
+    memset(&RF_TLM_Data.Uplink, 0, sizeof(RF_TLM_Data.Uplink));
+
+    RF_TLM_Data.Uplink.PollMsec     = RF_TLM_UPLINK_POLL_MAX_MSEC;
+    RF_TLM_Data.Uplink.NextPollMsec = RF_TLM_GetMsec();
+}
+
+/*
+** Check a command packet read from the uC, returns an RF_TLM_ACK_* status
+*/
+static uint8 RF_TLM_Uplink_Validate(const CFE_MSG_Message_t *MsgPtr, uint16 Len)
+{
+    CFE_MSG_Size_t size = 0;
+    CFE_MSG_Type_t type = CFE_MSG_Type_Invalid;
+    bool           has_secondary = false;
+    bool           valid = false;
+
+    if (Len < sizeof(CFE_MSG_CommandHeader_t) || Len > RF_TLM_UPLINK_MAX_CMD_BYTES)
+    {
+        return RF_TLM_ACK_BAD_LENGTH;
+    }
+
+    CFE_MSG_GetSize(MsgPtr, &size);
+    if (size != Len)
+    {
+        return RF_TLM_ACK_BAD_LENGTH;
+    }
+
+    CFE_MSG_GetType(MsgPtr, &type);
+    if (type != CFE_MSG_Type_Cmd)
+    {
+        return RF_TLM_ACK_NOT_COMMAND;
+    }
+
+    CFE_MSG_GetHasSecondaryHeader(MsgPtr, &has_secondary);
+    if (has_secondary)
+    {
+        CFE_MSG_ValidateChecksum(MsgPtr, &valid);
+        if (!valid)
+        {
+            return RF_TLM_ACK_BAD_CHECKSUM;
+        }
+    }
+
+    return RF_TLM_ACK_ACCEPTED;
+}
+
+/*
+** Copy a validated command into an SB buffer and send it
+*/
+static uint8 RF_TLM_Uplink_Publish(const CFE_MSG_Message_t *MsgPtr, uint16 Len)
+{
+    CFE_SB_Buffer_t *BufPtr;
+
+    BufPtr = CFE_SB_AllocateMessageBuffer(Len);
+    if (BufPtr == NULL)
+    {
+        return RF_TLM_ACK_BUS_ERROR;
+    }
+
+    memcpy(BufPtr, MsgPtr, Len);
+
+    /* The ground set the sequence count, keep it */
+    if (CFE_SB_TransmitBuffer(BufPtr, false) != CFE_SUCCESS)
+    {
+        CFE_SB_ReleaseMessageBuffer(BufPtr);
+        return RF_TLM_ACK_BUS_ERROR;
+    }
+
+    return RF_TLM_ACK_ACCEPTED;
+}
+
+/*
+** Queue the acknowledgement of an uplink frame for the downlink
+*/
+static void RF_TLM_Uplink_Ack(uint8 UplinkSeq, uint8 Status, uint16 LatencyMsec)
+{
+    RF_TLM_Frame_t Ack;
+
+    memset(&Ack, 0, sizeof(Ack));
+
+    Ack.MsgId      = CFE_SB_INVALID_MSG_ID;
+    Ack.SampleTime = CFE_TIME_GetTime();
+    Ack.Length     = RF_TLM_ACK_FRAME_BYTES;
+    Ack.Data[0]    = RF_TLM_FRAME_ACK;
+
+    Ack.Data[RF_TLM_ACK_UPLINK_SEQ_OFFSET] = UplinkSeq;
+    Ack.Data[RF_TLM_ACK_STATUS_OFFSET]     = Status;
+    RF_TLM_Frame_PutU16(&Ack.Data[RF_TLM_ACK_LATENCY_OFFSET], LatencyMsec);
+
+    RF_TLM_Queue_Push(&RF_TLM_Data.FrameQueue, &Ack);
+}
+
+/*
+** Read one frame from the mailbox. Returns 1 if a frame was handled, 0 if
+** the mailbox was empty and -1 on a bus error.
+*/
+static int32 RF_TLM_Uplink_Poll(uint32 PollStartMsec)
+{
+    RF_TLM_Uplink_t *Uplink = &RF_TLM_Data.Uplink;
+    uint8            hdr[RF_TLM_UPLINK_HDR_BYTES];
+    uint8            seq;
+    uint8            status;
+    uint16           len;
+    uint16           read_len;
+    uint32           latency;
+    uint64_t         start_ns;
+    int              rv;
+
+    union
+    {
+        CFE_MSG_Message_t Msg;
+        uint8             Bytes[RF_TLM_UPLINK_MAX_CMD_BYTES];
+    } cmd;
+
+    start_ns = uC_monotonic_ns();
+
+    ++Uplink->Polls;
+    rv = uC_read_buffer(UC_ADDRESS, UC_REG_UPLINK_HDR, hdr, sizeof(hdr));
+    if (rv >= 0 && hdr[RF_TLM_UPLINK_LEN_OFFSET] == 0)
+    {
+        ++Uplink->EmptyPolls;
+        Uplink->PollBusyNs += uC_monotonic_ns() - start_ns;
+        return 0;
+    }
+
+    if (rv >= 0)
+    {
+        /* Reading the packet frees the slot, so an oversized one is still drained */
+        len      = hdr[RF_TLM_UPLINK_LEN_OFFSET];
+        read_len = (len > sizeof(cmd.Bytes)) ? sizeof(cmd.Bytes) : len;
+        rv       = uC_read_buffer(UC_ADDRESS, UC_REG_UPLINK_DATA, cmd.Bytes, read_len);
+    }
+
+    Uplink->PollBusyNs += uC_monotonic_ns() - start_ns;
+
+    if (rv < 0)
+    {
+        CFE_EVS_SendEvent(RF_TLM_UPLINK_ERR_EID, CFE_EVS_EventType_ERROR, "RF TLM: uplink read failed (%d)", rv);
+        RF_TLM_Dev_Lost();
+        return -1;
+    }
+
+    seq = hdr[RF_TLM_UPLINK_SEQ_OFFSET];
+    if (Uplink->HaveSeq && seq == Uplink->LastSeq)
+    {
+        ++Uplink->Duplicates;
+        return 1;
+    }
+    Uplink->HaveSeq = true;
+    Uplink->LastSeq = seq;
+
+    status = RF_TLM_Uplink_Validate(&cmd.Msg, len);
+    if (status == RF_TLM_ACK_ACCEPTED)
+    {
+        status = RF_TLM_Uplink_Publish(&cmd.Msg, len);
+    }
+
+    latency = RF_TLM_Frame_GetU16(&hdr[RF_TLM_UPLINK_AGE_OFFSET]) + (RF_TLM_GetMsec() - PollStartMsec);
+    if (latency > 0xFFFF)
+    {
+        latency = 0xFFFF;
+    }
+
+    if (status == RF_TLM_ACK_ACCEPTED)
+    {
+        ++Uplink->Accepted;
+        Uplink->LastLatencyMsec = (uint16)latency;
+        if (Uplink->LastLatencyMsec > Uplink->MaxLatencyMsec)
+        {
+            Uplink->MaxLatencyMsec = Uplink->LastLatencyMsec;
+        }
+
+        CFE_EVS_SendEvent(RF_TLM_UPLINK_INF_EID, CFE_EVS_EventType_DEBUG,
+                          "RF TLM: uplink command %u published, %u bytes, %lu ms after receipt", seq, len,
+                          (unsigned long)latency);
+    }
+    else
+    {
+        ++Uplink->Rejected;
+        CFE_EVS_SendEvent(RF_TLM_UPLINK_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "RF TLM: uplink command %u rejected, %u bytes, status %u", seq, len, status);
+    }
+
+    RF_TLM_Uplink_Ack(seq, status, (uint16)latency);
+
+    return 1;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_Uplink_Step() -- Poll the uC mailbox, if due             */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void RF_TLM_Uplink_Step(void)
+{
+    RF_TLM_Uplink_t *Uplink = &RF_TLM_Data.Uplink;
+    uint32           now;
+    int32            got = 0;
+    bool             active = false;
+
+    if (!RF_TLM_Dev_IsReady())
+    {
+        return;
+    }
+
+    now = RF_TLM_GetMsec();
+    if ((int32)(now - Uplink->NextPollMsec) < 0)
+    {
+        return;
+    }
+
+    RF_TLM_PERF_MARK_ENTRY(RF_TLM_UPLINK_PERF_ID);
+
+    for (uint16 n = 0; n < RF_TLM_UPLINK_FRAMES_PER_POLL; n++)
+    {
+        got = RF_TLM_Uplink_Poll(now);
+        if (got <= 0)
+        {
+            break;
+        }
+        active = true;
+    }
+
+    RF_TLM_PERF_MARK_EXIT(RF_TLM_UPLINK_PERF_ID);
+
+    if (active)
+    {
+        Uplink->PollMsec = RF_TLM_UPLINK_POLL_MIN_MSEC;
+    }
+    else if (got == 0)
+    {
+        Uplink->PollMsec *= 2;
+        if (Uplink->PollMsec > RF_TLM_UPLINK_POLL_MAX_MSEC)
+        {
+            Uplink->PollMsec = RF_TLM_UPLINK_POLL_MAX_MSEC;
+        }
+    }
+
+    Uplink->NextPollMsec = now + Uplink->PollMsec;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* RF_TLM_Uplink_WaitMsec() -- How long the run loop may pend      */
+/*                             before the next poll is due         */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+uint32 RF_TLM_Uplink_WaitMsec(uint32 MaxMsec)
+{
+    int32 remaining;
+
+    if (!RF_TLM_Dev_IsReady())
+    {
+        return MaxMsec;
+    }
+
+    remaining = (int32)(RF_TLM_Data.Uplink.NextPollMsec - RF_TLM_GetMsec());
+    if (remaining < 0)
+    {
+        return 0;
+    }
+
+    return ((uint32)remaining < MaxMsec) ? (uint32)remaining : MaxMsec;
+}
@@ -0,0 +1,63 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ * RF uplink: polling the uC for ground commands
+ */
+
+#ifndef RF_TLM_UPLINK_H
+#define RF_TLM_UPLINK_H
+
+#include "cfe.h"
+
+/*
+** Poll interval limits. The interval drops to the minimum when a command
+** arrives and doubles on every empty poll up to the maximum.
+*/
+#define RF_TLM_UPLINK_POLL_MIN_MSEC 50
+#define RF_TLM_UPLINK_POLL_MAX_MSEC 1000
+
+/*
+** Frames drained from the mailbox per poll, bounds the time a command
+** burst can hold the bus away from the downlink
+*/
+#define RF_TLM_UPLINK_FRAMES_PER_POLL 4
+
+typedef struct
+{
+    uint32 PollMsec;        /**< \brief Current poll interval */
+    uint32 NextPollMsec;    /**< \brief Time of the next poll */
+    bool   HaveSeq;         /**< \brief LastSeq is valid */
+    uint8  LastSeq;         /**< \brief Uplink sequence number of the last frame read */
+    uint32 Polls;           /**< \brief Mailbox header reads */
+    uint32 EmptyPolls;      /**< \brief Header reads that found nothing */
+    uint32 Accepted;        /**< \brief Commands published on the software bus */
+    uint32 Rejected;        /**< \brief Frames that failed validation or publication */
+    uint32 Duplicates;      /**< \brief Frames presented again with the same sequence number */
+    uint64 PollBusyNs;      /**< \brief Bus time spent on uplink reads */
+    uint16 LastLatencyMsec; /**< \brief Radio receipt to publication, last command */
+    uint16 MaxLatencyMsec;  /**< \brief Radio receipt to publication, worst command */
+} RF_TLM_Uplink_t;
+
+void   RF_TLM_Uplink_Init(void);
+void   RF_TLM_Uplink_Step(void);
+uint32 RF_TLM_Uplink_WaitMsec(uint32 MaxMsec);
+
+#endif /* RF_TLM_UPLINK_H */
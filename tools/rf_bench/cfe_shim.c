@@ -0,0 +1,486 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * \file
+ *   Host stand-in for the cFE services used by the RF Telemetry Output App,
+ *   see shim/cfe.h.
+ */
+
+#include <errno.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include <stdarg.h>
+#include <time.h>
+
+#include "cfe.h"
+
+#define CFE_SHIM_PIPES       8
+#define CFE_SHIM_TASKS       4
+#define CFE_SHIM_SEMS        8
+#define CFE_SHIM_BUFFER_SIZE 256
+#define CFE_SHIM_CDS_SIZE    4096
+
+#define CFE_SHIM_STREAM_CMD  0x1000 /* Packet type bit of the stream ID */
+#define CFE_SHIM_STREAM_SHDR 0x0800 /* Secondary header flag */
+
+static CFE_SB_Buffer_t *CFE_Shim_Pending[CFE_SHIM_PIPES];
+static uint32           CFE_Shim_Pipes;
+static uint32           CFE_Shim_Events;
+
+/* One CDS block, kept for the life of the process like a CDS across app restarts */
+static uint8  CFE_Shim_Cds[CFE_SHIM_CDS_SIZE];
+static size_t CFE_Shim_CdsSize;
+static bool   CFE_Shim_CdsWritten;
+
+/* Child tasks and semaphores, by ID - 1 */
+static pthread_t                    CFE_Shim_Tasks[CFE_SHIM_TASKS];
+static CFE_ES_ChildTaskMainFuncPtr_t CFE_Shim_TaskMain[CFE_SHIM_TASKS];
+static bool                         CFE_Shim_TaskUsed[CFE_SHIM_TASKS];
+static pthread_mutex_t              CFE_Shim_MutSems[CFE_SHIM_SEMS];
+static uint32                       CFE_Shim_MutSemCount;
+static sem_t                        CFE_Shim_BinSems[CFE_SHIM_SEMS];
+static uint32                       CFE_Shim_BinSemCount;
+
+static union
+{
+    CFE_SB_Buffer_t Buf;
+    uint8           Bytes[CFE_SHIM_BUFFER_SIZE];
+} CFE_Shim_SbBuffer;
+
+static uint16 CFE_Shim_Get16(const uint8 *Src)
+{
+    return (uint16)((Src[0] << 8) | Src[1]);
+}
+
+static void CFE_Shim_Put16(uint8 *Dst, uint16 Value)
+{
+    Dst[0] = (uint8)(Value >> 8);
+    Dst[1] = (uint8)Value;
+}
+
+void CFE_Shim_QueueBuffer(CFE_SB_PipeId_t PipeId, CFE_SB_Buffer_t *Buf)
+{
+    if (PipeId < CFE_SHIM_PIPES)
+    {
+        CFE_Shim_Pending[PipeId] = Buf;
+    }
+}
+
+uint32 CFE_Shim_EventCount(void)
+{
+    return CFE_Shim_Events;
+}
+
+int32 CFE_ES_WriteToSysLog(const char *SpecStringPtr, ...)
+{
+    (void)SpecStringPtr;
+    return CFE_SUCCESS;
+}
+
+bool CFE_ES_RunLoop(uint32 *RunStatus)
+{
+    return *RunStatus == CFE_ES_RunStatus_APP_RUN;
+}
+
+void CFE_ES_ExitApp(uint32 ExitStatus)
+{
+    (void)ExitStatus;
+}
+
+int32 CFE_ES_RegisterCDS(CFE_ES_CDSHandle_t *CDSHandlePtr, size_t BlockSize, const char *Name)
+{
+    (void)Name;
+
+    if (BlockSize == 0 || BlockSize > sizeof(CFE_Shim_Cds))
+    {
+        return CFE_ES_BAD_ARGUMENT;
+    }
+
+    *CDSHandlePtr = 1;
+    if (CFE_Shim_CdsWritten && BlockSize == CFE_Shim_CdsSize)
+    {
+        return CFE_ES_CDS_ALREADY_EXISTS;
+    }
+
+    CFE_Shim_CdsSize    = BlockSize;
+    CFE_Shim_CdsWritten = false;
+    return CFE_SUCCESS;
+}
+
+int32 CFE_ES_CopyToCDS(CFE_ES_CDSHandle_t Handle, const void *DataToCopy)
+{
+    (void)Handle;
+
+    memcpy(CFE_Shim_Cds, DataToCopy, CFE_Shim_CdsSize);
+    CFE_Shim_CdsWritten = true;
+    return CFE_SUCCESS;
+}
+
+int32 CFE_ES_RestoreFromCDS(void *RestoreToMemory, CFE_ES_CDSHandle_t Handle)
+{
+    (void)Handle;
+
+    memcpy(RestoreToMemory, CFE_Shim_Cds, CFE_Shim_CdsSize);
+    return CFE_SUCCESS;
+}
+
+static void *CFE_Shim_TaskEntry(void *Arg)
+{
+    CFE_Shim_TaskMain[(uintptr_t)Arg]();
+    return NULL;
+}
+
+int32 CFE_ES_CreateChildTask(CFE_ES_TaskId_t *TaskIdPtr, const char *TaskName, CFE_ES_ChildTaskMainFuncPtr_t FunctionPtr,
+                             void *StackPtr, size_t StackSize, uint16 Priority, uint32 Flags)
+{
+    uintptr_t i;
+
+    (void)TaskName;
+    (void)StackPtr;
+    (void)StackSize;
+    (void)Priority;
+    (void)Flags;
+
+    for (i = 0; i < CFE_SHIM_TASKS && CFE_Shim_TaskUsed[i]; i++)
+    {
+    }
+    if (i == CFE_SHIM_TASKS)
+    {
+        return CFE_ES_BAD_ARGUMENT;
+    }
+
+    CFE_Shim_TaskMain[i] = FunctionPtr;
+    if (pthread_create(&CFE_Shim_Tasks[i], NULL, CFE_Shim_TaskEntry, (void *)i) != 0)
+    {
+        return CFE_ES_BAD_ARGUMENT;
+    }
+
+    CFE_Shim_TaskUsed[i] = true;
+    *TaskIdPtr           = (CFE_ES_TaskId_t)(i + 1);
+    return CFE_SUCCESS;
+}
+
+/* The task goes at its next cancellation point, as a blocked task would under ES */
+int32 CFE_ES_DeleteChildTask(CFE_ES_TaskId_t TaskId)
+{
+    if (TaskId == 0 || TaskId > CFE_SHIM_TASKS || !CFE_Shim_TaskUsed[TaskId - 1])
+    {
+        return CFE_ES_BAD_ARGUMENT;
+    }
+
+    pthread_cancel(CFE_Shim_Tasks[TaskId - 1]);
+    pthread_join(CFE_Shim_Tasks[TaskId - 1], NULL);
+    CFE_Shim_TaskUsed[TaskId - 1] = false;
+    return CFE_SUCCESS;
+}
+
+void CFE_ES_ExitChildTask(void)
+{
+    pthread_exit(NULL);
+}
+
+int32 OS_MutSemCreate(osal_id_t *sem_id, const char *sem_name, uint32 options)
+{
+    (void)sem_name;
+    (void)options;
+
+    if (CFE_Shim_MutSemCount == CFE_SHIM_SEMS)
+    {
+        return OS_ERROR;
+    }
+
+    pthread_mutex_init(&CFE_Shim_MutSems[CFE_Shim_MutSemCount], NULL);
+    *sem_id = ++CFE_Shim_MutSemCount;
+    return OS_SUCCESS;
+}
+
+int32 OS_MutSemTake(osal_id_t sem_id)
+{
+    return (pthread_mutex_lock(&CFE_Shim_MutSems[sem_id - 1]) == 0) ? OS_SUCCESS : OS_ERROR;
+}
+
+int32 OS_MutSemGive(osal_id_t sem_id)
+{
+    return (pthread_mutex_unlock(&CFE_Shim_MutSems[sem_id - 1]) == 0) ? OS_SUCCESS : OS_ERROR;
+}
+
+int32 OS_BinSemCreate(osal_id_t *sem_id, const char *sem_name, uint32 sem_initial_value, uint32 options)
+{
+    (void)sem_name;
+    (void)options;
+
+    if (CFE_Shim_BinSemCount == CFE_SHIM_SEMS)
+    {
+        return OS_ERROR;
+    }
+
+    sem_init(&CFE_Shim_BinSems[CFE_Shim_BinSemCount], 0, sem_initial_value ? 1 : 0);
+    *sem_id = ++CFE_Shim_BinSemCount;
+    return OS_SUCCESS;
+}
+
+int32 OS_BinSemTake(osal_id_t sem_id)
+{
+    while (sem_wait(&CFE_Shim_BinSems[sem_id - 1]) != 0)
+    {
+        if (errno != EINTR)
+        {
+            return OS_ERROR;
+        }
+    }
+    return OS_SUCCESS;
+}
+
+int32 OS_BinSemTimedWait(osal_id_t sem_id, uint32 msecs)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_REALTIME, &ts);
+    ts.tv_sec += msecs / 1000;
+    ts.tv_nsec += (long)(msecs % 1000) * 1000000L;
+    if (ts.tv_nsec >= 1000000000L)
+    {
+        ts.tv_sec++;
+        ts.tv_nsec -= 1000000000L;
+    }
+
+    while (sem_timedwait(&CFE_Shim_BinSems[sem_id - 1], &ts) != 0)
+    {
+        if (errno == ETIMEDOUT)
+        {
+            return OS_SEM_TIMEOUT;
+        }
+        if (errno != EINTR)
+        {
+            return OS_ERROR;
+        }
+    }
+    return OS_SUCCESS;
+}
+
+/* Binary: a give on a full semaphore is lost */
+int32 OS_BinSemGive(osal_id_t sem_id)
+{
+    int value;
+
+    sem_getvalue(&CFE_Shim_BinSems[sem_id - 1], &value);
+    if (value == 0)
+    {
+        sem_post(&CFE_Shim_BinSems[sem_id - 1]);
+    }
+    return OS_SUCCESS;
+}
+
+int32 CFE_EVS_Register(const void *Filters, uint16 NumFilteredEvents, uint16 FilterScheme)
+{
+    (void)Filters;
+    (void)NumFilteredEvents;
+    (void)FilterScheme;
+    return CFE_SUCCESS;
+}
+
+int32 CFE_EVS_SendEvent(uint16 EventID, uint16 EventType, const char *Spec, ...)
+{
+    (void)EventID;
+    (void)EventType;
+    (void)Spec;
+    ++CFE_Shim_Events;
+    return CFE_SUCCESS;
+}
+
+int32 CFE_SB_CreatePipe(CFE_SB_PipeId_t *PipeIdPtr, uint16 Depth, const char *PipeName)
+{
+    (void)Depth;
+    (void)PipeName;
+
+    if (CFE_Shim_Pipes >= CFE_SHIM_PIPES)
+    {
+        return CFE_SB_BAD_ARGUMENT;
+    }
+
+    *PipeIdPtr = CFE_Shim_Pipes++;
+    return CFE_SUCCESS;
+}
+
+int32 CFE_SB_Subscribe(CFE_SB_MsgId_t MsgId, CFE_SB_PipeId_t PipeId)
+{
+    (void)MsgId;
+    (void)PipeId;
+    return CFE_SUCCESS;
+}
+
+int32 CFE_SB_SubscribeEx(CFE_SB_MsgId_t MsgId, CFE_SB_PipeId_t PipeId, CFE_SB_Qos_t Quality, uint16 MsgLim)
+{
+    (void)Quality;
+    (void)MsgLim;
+    return CFE_SB_Subscribe(MsgId, PipeId);
+}
+
+int32 CFE_SB_ReceiveBuffer(CFE_SB_Buffer_t **BufPtr, CFE_SB_PipeId_t PipeId, int32 TimeOut)
+{
+    if (PipeId >= CFE_SHIM_PIPES || CFE_Shim_Pending[PipeId] == NULL)
+    {
+        return (TimeOut == CFE_SB_POLL) ? CFE_SB_NO_MESSAGE : CFE_SB_TIME_OUT;
+    }
+
+    *BufPtr                  = CFE_Shim_Pending[PipeId];
+    CFE_Shim_Pending[PipeId] = NULL;
+    return CFE_SUCCESS;
+}
+
+int32 CFE_SB_TransmitMsg(const CFE_MSG_Message_t *MsgPtr, bool IncrementSequenceCount)
+{
+    (void)MsgPtr;
+    (void)IncrementSequenceCount;
+    return CFE_SUCCESS;
+}
+
+CFE_SB_Buffer_t *CFE_SB_AllocateMessageBuffer(size_t MsgSize)
+{
+    /* The real bus hands out pool buffers, never heap memory */
+    return (MsgSize <= sizeof(CFE_Shim_SbBuffer)) ? &CFE_Shim_SbBuffer.Buf : NULL;
+}
+
+int32 CFE_SB_TransmitBuffer(CFE_SB_Buffer_t *BufPtr, bool IncrementSequenceCount)
+{
+    (void)BufPtr;
+    (void)IncrementSequenceCount;
+    return CFE_SUCCESS;
+}
+
+int32 CFE_SB_ReleaseMessageBuffer(CFE_SB_Buffer_t *BufPtr)
+{
+    (void)BufPtr;
+    return CFE_SUCCESS;
+}
+
+void CFE_SB_TimeStampMsg(CFE_MSG_Message_t *MsgPtr)
+{
+    (void)MsgPtr;
+}
+
+int32 CFE_MSG_Init(CFE_MSG_Message_t *MsgPtr, CFE_SB_MsgId_t MsgId, CFE_MSG_Size_t Size)
+{
+    memset(MsgPtr, 0, Size);
+    CFE_Shim_Put16(MsgPtr->StreamId, (uint16)(MsgId | CFE_SHIM_STREAM_SHDR));
+    CFE_Shim_Put16(MsgPtr->Length, (uint16)(Size - 7));
+    return CFE_SUCCESS;
+}
+
+int32 CFE_MSG_GetMsgId(const CFE_MSG_Message_t *MsgPtr, CFE_SB_MsgId_t *MsgId)
+{
+    /* V1 message IDs are the whole stream ID, secondary header flag included */
+    *MsgId = CFE_Shim_Get16(MsgPtr->StreamId);
+    return CFE_SUCCESS;
+}
+
+int32 CFE_MSG_GetSize(const CFE_MSG_Message_t *MsgPtr, CFE_MSG_Size_t *Size)
+{
+    *Size = (CFE_MSG_Size_t)CFE_Shim_Get16(MsgPtr->Length) + 7;
+    return CFE_SUCCESS;
+}
+
+int32 CFE_MSG_GetType(const CFE_MSG_Message_t *MsgPtr, CFE_MSG_Type_t *Type)
+{
+    *Type = (CFE_Shim_Get16(MsgPtr->StreamId) & CFE_SHIM_STREAM_CMD) ? CFE_MSG_Type_Cmd : CFE_MSG_Type_Tlm;
+    return CFE_SUCCESS;
+}
+
+int32 CFE_MSG_GetHasSecondaryHeader(const CFE_MSG_Message_t *MsgPtr, bool *HasSecondary)
+{
+    *HasSecondary = (CFE_Shim_Get16(MsgPtr->StreamId) & CFE_SHIM_STREAM_SHDR) != 0;
+    return CFE_SUCCESS;
+}
+
+int32 CFE_MSG_GetFcnCode(const CFE_MSG_Message_t *MsgPtr, CFE_MSG_FcnCode_t *FcnCode)
+{
+    *FcnCode = ((const CFE_MSG_CommandHeader_t *)MsgPtr)->FunctionCode & 0x7F;
+    return CFE_SUCCESS;
+}
+
+int32 CFE_MSG_GetMsgTime(const CFE_MSG_Message_t *MsgPtr, CFE_TIME_SysTime_t *Time)
+{
+    const uint8 *t = ((const CFE_MSG_TelemetryHeader_t *)MsgPtr)->Time;
+
+    Time->Seconds    = ((uint32)t[0] << 24) | ((uint32)t[1] << 16) | ((uint32)t[2] << 8) | t[3];
+    Time->Subseconds = (uint32)CFE_Shim_Get16(&t[4]) << 16;
+    return CFE_SUCCESS;
+}
+
+int32 CFE_MSG_ValidateChecksum(const CFE_MSG_Message_t *MsgPtr, bool *IsValid)
+{
+    CFE_MSG_Size_t size;
+    const uint8   *bytes = (const uint8 *)MsgPtr;
+    uint8          sum   = 0xFF;
+
+    CFE_MSG_GetSize(MsgPtr, &size);
+    for (CFE_MSG_Size_t i = 0; i < size; i++)
+    {
+        sum ^= bytes[i];
+    }
+
+    *IsValid = (sum == 0);
+    return CFE_SUCCESS;
+}
+
+CFE_TIME_SysTime_t CFE_TIME_GetTime(void)
+{
+    struct timespec    ts;
+    CFE_TIME_SysTime_t now;
+
+    clock_gettime(CLOCK_REALTIME, &ts);
+    now.Seconds    = (uint32)ts.tv_sec;
+    now.Subseconds = (uint32)(((uint64)ts.tv_nsec << 32) / 1000000000u);
+    return now;
+}
+
+CFE_TIME_SysTime_t CFE_TIME_Subtract(CFE_TIME_SysTime_t Time1, CFE_TIME_SysTime_t Time2)
+{
+    CFE_TIME_SysTime_t diff;
+
+    diff.Subseconds = Time1.Subseconds - Time2.Subseconds;
+    diff.Seconds    = Time1.Seconds - Time2.Seconds - ((diff.Subseconds > Time1.Subseconds) ? 1 : 0);
+    return diff;
+}
+
+CFE_TIME_Compare_t CFE_TIME_Compare(CFE_TIME_SysTime_t TimeA, CFE_TIME_SysTime_t TimeB)
+{
+    if (TimeA.Seconds != TimeB.Seconds)
+    {
+        return (TimeA.Seconds < TimeB.Seconds) ? CFE_TIME_A_LT_B : CFE_TIME_A_GT_B;
+    }
+    if (TimeA.Subseconds != TimeB.Subseconds)
+    {
+        return (TimeA.Subseconds < TimeB.Subseconds) ? CFE_TIME_A_LT_B : CFE_TIME_A_GT_B;
+    }
+    return CFE_TIME_EQUAL;
+}
+
+uint32 CFE_TIME_Sub2MicroSecs(uint32 SubSeconds)
+{
+    return (uint32)(((uint64)SubSeconds * 1000000u) >> 32);
+}
+
+void CFE_PSP_GetTime(OS_time_t *LocalTime)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    LocalTime->ticks = (int64)ts.tv_sec * 10000000 + ts.tv_nsec / 100;
+}
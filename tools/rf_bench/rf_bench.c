@@ -0,0 +1,579 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * \file
+ *   Micro-benchmarks of the RF Telemetry Output App hot routines.
+ *
+ *   Each case runs one routine in isolation on the Linux host, against the
+ *   cFE stand-in in shim/ and the loopback uC transport, and reports the
+ *   median time per operation over several batches, heap allocations per
+ *   operation and bytes copied per operation. Results can be saved as a
+ *   baseline and later runs compared against it.
+ *
+ *   Allocations and library copies are counted by wrapping malloc, calloc,
+ *   realloc, memcpy and memmove at link time; the sources are built with
+ *   the memcpy/memmove builtins off so every copy goes through the wrapper.
+ *   Copies done by open-coded loops are declared per case.
+ *
+ *   frame_path runs one sample from the pipe to the uC, loopback transfer
+ *   included; uc_set_bytes_loopback is that transfer alone.
+ *
+ *   lz_compress and lz_expand run over one full block of sample frames,
+ *   laid out as RF_TLM_Lz_Put() lays them, sequence numbers advancing:
+ *   seven frames, 231 bytes, which lz_expand rebuilds byte by byte.
+ *
+ *   New stages get a case in rf_bench_cases[].
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "rf_tlm_events.h"
+#include "rf_tlm.h"
+
+#define RF_BENCH_BATCHES       5
+#define RF_BENCH_BATCH_NS      20000000ull /* Target duration of one batch */
+#define RF_BENCH_COUNT_OPS     1000        /* Operations in the counting pass */
+#define RF_BENCH_MAX_CASES     32
+#define RF_BENCH_NAME_MAX      32
+#define RF_BENCH_TOLERANCE_PCT 10.0
+
+typedef struct
+{
+    const char *Name;
+    void (*Setup)(void);
+    void (*Run)(void);
+    uint32 OpenCodedBytes; /* Bytes per op copied by loops rather than memcpy */
+} rf_bench_case_t;
+
+typedef struct
+{
+    char   Name[RF_BENCH_NAME_MAX];
+    double NsPerOp;
+    double AllocsPerOp;
+    double BytesPerOp;
+} rf_bench_result_t;
+
+/*
+** Allocation and copy accounting, see the --wrap options in the Makefile
+*/
+static uint64_t rf_bench_allocs;
+static uint64_t rf_bench_copied;
+
+void *__real_malloc(size_t Size);
+void *__real_calloc(size_t Count, size_t Size);
+void *__real_realloc(void *Ptr, size_t Size);
+void *__real_memcpy(void *Dst, const void *Src, size_t Len);
+void *__real_memmove(void *Dst, const void *Src, size_t Len);
+
+void *__wrap_malloc(size_t Size)
+{
+    ++rf_bench_allocs;
+    return __real_malloc(Size);
+}
+
+void *__wrap_calloc(size_t Count, size_t Size)
+{
+    ++rf_bench_allocs;
+    return __real_calloc(Count, Size);
+}
+
+void *__wrap_realloc(void *Ptr, size_t Size)
+{
+    ++rf_bench_allocs;
+    return __real_realloc(Ptr, Size);
+}
+
+void *__wrap_memcpy(void *Dst, const void *Src, size_t Len)
+{
+    rf_bench_copied += Len;
+    return __real_memcpy(Dst, Src, Len);
+}
+
+void *__wrap_memmove(void *Dst, const void *Src, size_t Len)
+{
+    rf_bench_copied += Len;
+    return __real_memmove(Dst, Src, Len);
+}
+
+/*
+** Fixtures
+*/
+static RF_TLM_Frame_t  rf_bench_frame;
+static RF_TLM_Source_t rf_bench_raw_source;
+static RF_TLM_Source_t rf_bench_packed_source;
+static uint8           rf_bench_packed_body[RF_TLM_MAX_FRAME_BYTES];
+
+static union
+{
+    CFE_SB_Buffer_t    Buf;
+    SUBS_APP_OutData_t Sample;
+} rf_bench_sample;
+
+static union
+{
+    CFE_SB_Buffer_t  Buf;
+    RF_TLM_NoopCmd_t Cmd;
+} rf_bench_noop;
+
+static uint8  rf_bench_wire[RF_TLM_MAX_FRAME_BYTES];
+static uint8 *rf_bench_wire_ptr = rf_bench_wire;
+
+static uint8  rf_bench_lz_raw[RF_TLM_LZ_BLOCK_BYTES];
+static uint16 rf_bench_lz_raw_len;
+static uint8  rf_bench_lz_packed[RF_TLM_LZ_BLOCK_BYTES];
+static uint16 rf_bench_lz_packed_len;
+
+static void rf_bench_setup_app(void)
+{
+    memset(&RF_TLM_Data, 0, sizeof(RF_TLM_Data));
+
+    RF_TLM_Data.downlink_on = true;
+    RF_TLM_Queue_Init(&RF_TLM_Data.FrameQueue, RF_TLM_Data.FrameStore, RF_TLM_FRAME_QUEUE_DEPTH);
+    RF_TLM_Seq_Init(&RF_TLM_Data.Dest, UC_ADDRESS);
+    CFE_SB_CreatePipe(&RF_TLM_Data.TlmPipe, RF_TLM_TO_PIPE_DEPTH, "RF_BENCH_TLM");
+
+    memset(&rf_bench_raw_source, 0, sizeof(rf_bench_raw_source));
+    rf_bench_raw_source.MsgId    = CFE_SB_ValueToMsgId(IMU_APP_RF_DATA_MID);
+    rf_bench_raw_source.Encoding = RF_TLM_ENC_RAW;
+
+    rf_bench_packed_source          = rf_bench_raw_source;
+    rf_bench_packed_source.Encoding = RF_TLM_ENC_PACKED;
+    rf_bench_packed_source.Schema   = RF_TLM_Pack_FindSchema(IMU_APP_RF_DATA_MID, &rf_bench_packed_source.SchemaId);
+
+    RF_TLM_Data.Sources[0]  = rf_bench_raw_source;
+    RF_TLM_Data.SourceCount = 1;
+    RF_TLM_Queue_Init(&RF_TLM_Data.Sources[0].Queue, RF_TLM_Data.SourceStore[0], RF_TLM_SOURCE_QUEUE_DEPTH);
+    RF_TLM_Data.Sources[0].Weight = 1;
+
+    CFE_MSG_Init(CFE_MSG_PTR(rf_bench_sample.Sample.TelemetryHeader), CFE_SB_ValueToMsgId(IMU_APP_RF_DATA_MID),
+                 sizeof(rf_bench_sample.Sample));
+    rf_bench_sample.Sample.AppID_H = (uint8)(IMU_APP_RF_DATA_MID >> 8);
+    rf_bench_sample.Sample.AppID_L = (uint8)IMU_APP_RF_DATA_MID;
+    for (int i = 0; i < 4; i++)
+    {
+        rf_bench_sample.Sample.byte_group_1[i] = (uint8)(0x10 + i);
+        rf_bench_sample.Sample.byte_group_2[i] = (uint8)(0x20 + i);
+        rf_bench_sample.Sample.byte_group_3[i] = (uint8)(0x30 + i);
+        rf_bench_sample.Sample.byte_group_4[i] = (uint8)(0x40 + i);
+        rf_bench_sample.Sample.byte_group_5[i] = (uint8)(0x50 + i);
+        rf_bench_sample.Sample.byte_group_6[i] = (uint8)(0x60 + i);
+    }
+    RF_TLM_store_sample(&rf_bench_sample.Sample);
+
+    CFE_MSG_Init(CFE_MSG_PTR(rf_bench_noop.Cmd.CmdHeader), CFE_SB_ValueToMsgId(RF_TLM_CMD_MID),
+                 sizeof(rf_bench_noop.Cmd));
+    rf_bench_noop.Cmd.CmdHeader.FunctionCode = RF_TLM_NOOP_CC;
+
+    uC_set_transport(&uC_loopback_transport);
+    uC_start(RF_TLM_I2C_WORKER_PRIORITY);
+    uC_loopback_reset();
+}
+
+/*
+** Cases
+*/
+static void rf_bench_encode_raw(void)
+{
+    RF_TLM_encode_frame(&rf_bench_frame, &rf_bench_raw_source);
+}
+
+static void rf_bench_encode_packed(void)
+{
+    RF_TLM_encode_frame(&rf_bench_frame, &rf_bench_packed_source);
+}
+
+static void rf_bench_pack_encode(void)
+{
+    RF_TLM_Pack_Encode(rf_bench_packed_source.Schema, rf_bench_frame.Data, rf_bench_packed_body,
+                       sizeof(rf_bench_packed_body));
+}
+
+static void rf_bench_setup_frame(void)
+{
+    rf_bench_setup_app();
+    RF_TLM_encode_frame(&rf_bench_frame, &rf_bench_raw_source);
+}
+
+static void rf_bench_seq_stamp(void)
+{
+    RF_TLM_Seq_Stamp(&RF_TLM_Data.Dest, &rf_bench_frame, 123);
+}
+
+static void rf_bench_store_sample(void)
+{
+    RF_TLM_store_sample(&rf_bench_sample.Sample);
+}
+
+static void rf_bench_forward_one(void)
+{
+    CFE_Shim_QueueBuffer(RF_TLM_Data.TlmPipe, &rf_bench_sample.Buf);
+    RF_TLM_forward_telemetry();
+    RF_TLM_Queue_Pop(&RF_TLM_Data.Sources[0].Queue);
+}
+
+static void rf_bench_tm_crc(void)
+{
+    RF_TLM_Frame_Crc16(rf_bench_frame.Data, RF_TLM_TM_FRAME_BYTES - RF_TLM_TM_FECF_BYTES);
+}
+
+static void rf_bench_setup_lz(void)
+{
+    uint16 i;
+
+    rf_bench_setup_app();
+
+    /* Consecutive samples of one source, the block the compressor sees in flight */
+    rf_bench_lz_raw_len = 0;
+    for (i = 0;; i++)
+    {
+        rf_bench_sample.Sample.byte_group_1[0] = (uint8)i;
+        RF_TLM_store_sample(&rf_bench_sample.Sample);
+        RF_TLM_encode_frame(&rf_bench_frame, &rf_bench_raw_source);
+        RF_TLM_Seq_Stamp(&RF_TLM_Data.Dest, &rf_bench_frame, 100);
+        if (rf_bench_lz_raw_len + 1u + rf_bench_frame.Length > RF_TLM_LZ_BLOCK_BYTES)
+        {
+            break;
+        }
+        rf_bench_lz_raw[rf_bench_lz_raw_len++] = (uint8)rf_bench_frame.Length;
+        memcpy(&rf_bench_lz_raw[rf_bench_lz_raw_len], rf_bench_frame.Data, rf_bench_frame.Length);
+        rf_bench_lz_raw_len += rf_bench_frame.Length;
+    }
+
+    rf_bench_lz_packed_len = RF_TLM_Frame_Compress(rf_bench_lz_packed, rf_bench_lz_raw, rf_bench_lz_raw_len);
+    if (rf_bench_lz_packed_len == 0)
+    {
+        fprintf(stderr, "lz: sample block does not compress, lz_expand times nothing\n");
+    }
+}
+
+static void rf_bench_lz_compress(void)
+{
+    RF_TLM_Frame_Compress(rf_bench_lz_packed, rf_bench_lz_raw, rf_bench_lz_raw_len);
+}
+
+static void rf_bench_lz_expand(void)
+{
+    RF_TLM_Frame_Expand(rf_bench_lz_raw, sizeof(rf_bench_lz_raw), rf_bench_lz_packed, rf_bench_lz_packed_len);
+}
+
+static void rf_bench_setup_link(void)
+{
+    rf_bench_setup_app();
+
+    /* uC up, no pacing and room for a time reference next to each frame */
+    RF_TLM_Data.Dev.State      = RF_TLM_DEV_READY;
+    RF_TLM_Data.FramesPerCycle = 2;
+}
+
+static void rf_bench_frame_path(void)
+{
+    CFE_Shim_QueueBuffer(RF_TLM_Data.TlmPipe, &rf_bench_sample.Buf);
+    RF_TLM_forward_telemetry();
+    RF_TLM_send_queued();
+}
+
+static void rf_bench_uc_set_bytes(void)
+{
+    uC_set_bytes(UC_ADDRESS, &rf_bench_wire_ptr, RF_TLM_RAW_FRAME_BYTES);
+}
+
+static void rf_bench_dispatch_noop(void)
+{
+    RF_TLM_ProcessGroundCommand(&rf_bench_noop.Buf);
+}
+
+static const rf_bench_case_t rf_bench_cases[] = {
+    {"encode_raw", rf_bench_setup_app, rf_bench_encode_raw, 0},
+    {"encode_packed", rf_bench_setup_app, rf_bench_encode_packed, 0},
+    {"pack_encode", rf_bench_setup_frame, rf_bench_pack_encode, 0},
+    {"seq_stamp", rf_bench_setup_frame, rf_bench_seq_stamp, 0},
+    {"tm_crc", rf_bench_setup_frame, rf_bench_tm_crc, 0},
+    {"store_sample", rf_bench_setup_app, rf_bench_store_sample, 28},
+    {"forward_one", rf_bench_setup_app, rf_bench_forward_one, 28},
+    {"frame_path", rf_bench_setup_link, rf_bench_frame_path, 28},
+    {"uc_set_bytes_loopback", rf_bench_setup_app, rf_bench_uc_set_bytes, 0},
+    {"dispatch_noop", rf_bench_setup_app, rf_bench_dispatch_noop, 0},
+    {"lz_compress", rf_bench_setup_lz, rf_bench_lz_compress, 0},
+    {"lz_expand", rf_bench_setup_lz, rf_bench_lz_expand, 231},
+};
+
+#define RF_BENCH_CASE_COUNT (sizeof(rf_bench_cases) / sizeof(rf_bench_cases[0]))
+
+/*
+** Measurement
+*/
+static uint64_t rf_bench_now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static double rf_bench_batch(const rf_bench_case_t *Case, uint64_t Ops)
+{
+    uint64_t start = rf_bench_now_ns();
+
+    for (uint64_t i = 0; i < Ops; i++)
+    {
+        Case->Run();
+    }
+
+    return (double)(rf_bench_now_ns() - start) / (double)Ops;
+}
+
+static int rf_bench_compare_double(const void *A, const void *B)
+{
+    double a = *(const double *)A;
+    double b = *(const double *)B;
+
+    return (a > b) - (a < b);
+}
+
+static void rf_bench_measure(const rf_bench_case_t *Case, rf_bench_result_t *Result)
+{
+    double   batches[RF_BENCH_BATCHES];
+    uint64_t ops = 16;
+    uint64_t allocs;
+    uint64_t copied;
+
+    Case->Setup();
+
+    /* Grow the batch until it takes long enough to time reliably */
+    while (rf_bench_batch(Case, ops) * (double)ops < (double)RF_BENCH_BATCH_NS && ops < (1ull << 32))
+    {
+        ops *= 2;
+    }
+
+    for (int b = 0; b < RF_BENCH_BATCHES; b++)
+    {
+        batches[b] = rf_bench_batch(Case, ops);
+    }
+    qsort(batches, RF_BENCH_BATCHES, sizeof(batches[0]), rf_bench_compare_double);
+
+    allocs = rf_bench_allocs;
+    copied = rf_bench_copied;
+    rf_bench_batch(Case, RF_BENCH_COUNT_OPS);
+
+    snprintf(Result->Name, sizeof(Result->Name), "%s", Case->Name);
+    Result->NsPerOp     = batches[RF_BENCH_BATCHES / 2];
+    Result->AllocsPerOp = (double)(rf_bench_allocs - allocs) / RF_BENCH_COUNT_OPS;
+    Result->BytesPerOp  = (double)(rf_bench_copied - copied) / RF_BENCH_COUNT_OPS + Case->OpenCodedBytes;
+}
+
+/*
+** Baseline files hold one "name ns_per_op allocs_per_op bytes_per_op"
+** line per case, '#' starts a comment
+*/
+static int rf_bench_load(const char *Path, rf_bench_result_t *Results, int Max)
+{
+    FILE *in;
+    char  line[256];
+    int   count = 0;
+
+    in = fopen(Path, "r");
+    if (in == NULL)
+    {
+        perror(Path);
+        return -1;
+    }
+
+    while (count < Max && fgets(line, sizeof(line), in) != NULL)
+    {
+        if (line[0] == '#')
+        {
+            continue;
+        }
+        if (sscanf(line, "%31s %lf %lf %lf", Results[count].Name, &Results[count].NsPerOp,
+                   &Results[count].AllocsPerOp, &Results[count].BytesPerOp) == 4)
+        {
+            ++count;
+        }
+    }
+
+    fclose(in);
+    return count;
+}
+
+static int rf_bench_save(const char *Path, const rf_bench_result_t *Results, int Count)
+{
+    FILE *out;
+
+    out = fopen(Path, "w");
+    if (out == NULL)
+    {
+        perror(Path);
+        return -1;
+    }
+
+    fprintf(out, "# rf_bench baseline: name ns_per_op allocs_per_op bytes_per_op\n");
+    for (int i = 0; i < Count; i++)
+    {
+        fprintf(out, "%s %.2f %.2f %.2f\n", Results[i].Name, Results[i].NsPerOp, Results[i].AllocsPerOp,
+                Results[i].BytesPerOp);
+    }
+
+    fclose(out);
+    return 0;
+}
+
+static const rf_bench_result_t *rf_bench_find(const rf_bench_result_t *Results, int Count, const char *Name)
+{
+    for (int i = 0; i < Count; i++)
+    {
+        if (strcmp(Results[i].Name, Name) == 0)
+        {
+            return &Results[i];
+        }
+    }
+
+    return NULL;
+}
+
+static void rf_bench_usage(const char *Prog)
+{
+    fprintf(stderr,
+            "usage: %s [-f filter] [-s save-file] [-c baseline-file] [-t tolerance-pct] [-m mhz]\n"
+            "  -f  only run cases whose name contains filter\n"
+            "  -s  write the results as a new baseline\n"
+            "  -c  compare with a baseline, exit 1 on a regression\n"
+            "  -t  slowdown tolerated before a case counts as a regression (default %.0f%%)\n"
+            "  -m  also report cycles per op for a core clocked at mhz\n",
+            Prog, RF_BENCH_TOLERANCE_PCT);
+}
+
+int main(int argc, char *argv[])
+{
+    rf_bench_result_t        results[RF_BENCH_MAX_CASES];
+    rf_bench_result_t        baseline[RF_BENCH_MAX_CASES];
+    const rf_bench_result_t *base;
+    const char              *filter    = NULL;
+    const char              *save_path = NULL;
+    const char              *base_path = NULL;
+    double                   tolerance = RF_BENCH_TOLERANCE_PCT;
+    double                   mhz       = 0.0;
+    double                   delta;
+    int                      base_count = 0;
+    int                      count      = 0;
+    int                      regressions = 0;
+    const char              *verdict;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (i + 1 < argc && strcmp(argv[i], "-f") == 0)
+        {
+            filter = argv[++i];
+        }
+        else if (i + 1 < argc && strcmp(argv[i], "-s") == 0)
+        {
+            save_path = argv[++i];
+        }
+        else if (i + 1 < argc && strcmp(argv[i], "-c") == 0)
+        {
+            base_path = argv[++i];
+        }
+        else if (i + 1 < argc && strcmp(argv[i], "-t") == 0)
+        {
+            tolerance = atof(argv[++i]);
+        }
+        else if (i + 1 < argc && strcmp(argv[i], "-m") == 0)
+        {
+            mhz = atof(argv[++i]);
+        }
+        else
+        {
+            rf_bench_usage(argv[0]);
+            return 2;
+        }
+    }
+
+    if (base_path != NULL)
+    {
+        base_count = rf_bench_load(base_path, baseline, RF_BENCH_MAX_CASES);
+        if (base_count < 0)
+        {
+            return 2;
+        }
+    }
+
+    printf("%-24s %10s %10s %10s", "case", "ns/op", "allocs/op", "bytes/op");
+    if (mhz > 0.0)
+    {
+        printf(" %10s", "cycles/op");
+    }
+    if (base_path != NULL)
+    {
+        printf(" %10s %8s", "base ns", "delta");
+    }
+    printf("\n");
+
+    for (size_t c = 0; c < RF_BENCH_CASE_COUNT; c++)
+    {
+        if (filter != NULL && strstr(rf_bench_cases[c].Name, filter) == NULL)
+        {
+            continue;
+        }
+
+        rf_bench_measure(&rf_bench_cases[c], &results[count]);
+        printf("%-24s %10.1f %10.2f %10.1f", results[count].Name, results[count].NsPerOp,
+               results[count].AllocsPerOp, results[count].BytesPerOp);
+        if (mhz > 0.0)
+        {
+            printf(" %10.0f", results[count].NsPerOp * mhz / 1000.0);
+        }
+
+        if (base_path != NULL)
+        {
+            base = rf_bench_find(baseline, base_count, results[count].Name);
+            if (base == NULL)
+            {
+                printf(" %10s %8s  new", "-", "-");
+            }
+            else
+            {
+                delta   = 100.0 * (results[count].NsPerOp - base->NsPerOp) / base->NsPerOp;
+                verdict = "";
+                if (delta > tolerance || results[count].AllocsPerOp > base->AllocsPerOp ||
+                    results[count].BytesPerOp > base->BytesPerOp)
+                {
+                    verdict = "  REGRESSION";
+                    ++regressions;
+                }
+                else if (delta < -tolerance)
+                {
+                    verdict = "  improved";
+                }
+                printf(" %10.1f %+7.1f%%%s", base->NsPerOp, delta, verdict);
+            }
+        }
+        printf("\n");
+
+        ++count;
+    }
+
+    if (save_path != NULL && rf_bench_save(save_path, results, count) != 0)
+    {
+        return 2;
+    }
+
+    return (regressions > 0) ? 1 : 0;
+}
@@ -0,0 +1,268 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ * Host stand-in for the part of the cFE API the RF Telemetry Output App
+ * uses, so its routines can be benchmarked on a Linux host without a
+ * running cFE. Message headers follow the CCSDS v1 layout used by cFE.
+ *
+ * \note Benchmark use only. Bus, event and table services do nothing
+ *       beyond what the harness needs to drive the routines.
+ */
+
+#ifndef CFE_H
+#define CFE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+typedef int8_t   int8;
+typedef int16_t  int16;
+typedef int32_t  int32;
+typedef int64_t  int64;
+typedef uint8_t  uint8;
+typedef uint16_t uint16;
+typedef uint32_t uint32;
+typedef uint64_t uint64;
+
+/*
+** Status codes
+*/
+#define CFE_SUCCESS       ((int32)0)
+#define CFE_SB_TIME_OUT   ((int32)0xca000001)
+#define CFE_SB_NO_MESSAGE ((int32)0xca00000e)
+#define CFE_SB_BAD_ARGUMENT ((int32)0xca000003)
+#define CFE_ES_BAD_ARGUMENT ((int32)0xc4000002)
+#define CFE_ES_CDS_ALREADY_EXISTS ((int32)0x4400000F)
+
+#define OS_SUCCESS         0
+#define OS_ERROR           ((int32)-1)
+#define OS_SEM_TIMEOUT     ((int32)-6)
+#define OS_QUEUE_MAX_DEPTH 50
+
+#define CFE_MISSION_MAX_API_LEN 20
+
+/*
+** Software bus
+*/
+typedef uint32 CFE_SB_MsgId_Atom_t;
+typedef uint32 CFE_SB_MsgId_t;
+typedef uint32 CFE_SB_PipeId_t;
+
+typedef struct
+{
+    uint8 Priority;
+    uint8 Reliability;
+} CFE_SB_Qos_t;
+
+#define CFE_SB_MSGID_RESERVED ((CFE_SB_MsgId_t)0)
+#define CFE_SB_INVALID_MSG_ID ((CFE_SB_MsgId_t)0)
+#define CFE_SB_DEFAULT_QOS    ((CFE_SB_Qos_t) {0, 0})
+#define CFE_SB_POLL           0
+#define CFE_SB_PEND_FOREVER   (-1)
+
+/*
+** Message headers, CCSDS v1: 6-byte primary header, command secondary
+** header of function code and checksum, telemetry secondary header of a
+** 6-byte time
+*/
+typedef struct
+{
+    uint8 StreamId[2];
+    uint8 Sequence[2];
+    uint8 Length[2];
+} CFE_MSG_Message_t;
+
+typedef struct
+{
+    CFE_MSG_Message_t Msg;
+    uint8             FunctionCode;
+    uint8             Checksum;
+} CFE_MSG_CommandHeader_t;
+
+typedef struct
+{
+    CFE_MSG_Message_t Msg;
+    uint8             Time[6];
+    uint8             Spare[4];
+} CFE_MSG_TelemetryHeader_t;
+
+typedef union
+{
+    CFE_MSG_Message_t Msg;
+    long long         LongInt;
+    long double       LongDouble;
+} CFE_SB_Buffer_t;
+
+typedef uint8  CFE_MSG_FcnCode_t;
+typedef size_t CFE_MSG_Size_t;
+
+typedef enum
+{
+    CFE_MSG_Type_Invalid,
+    CFE_MSG_Type_Cmd,
+    CFE_MSG_Type_Tlm
+} CFE_MSG_Type_t;
+
+#define CFE_MSG_PTR(shdr) (&((shdr).Msg))
+
+/*
+** Time
+*/
+typedef struct
+{
+    uint32 Seconds;
+    uint32 Subseconds;
+} CFE_TIME_SysTime_t;
+
+typedef enum
+{
+    CFE_TIME_A_LT_B = -1,
+    CFE_TIME_EQUAL  = 0,
+    CFE_TIME_A_GT_B = 1
+} CFE_TIME_Compare_t;
+
+typedef struct
+{
+    int64 ticks; /* 100 ns */
+} OS_time_t;
+
+/*
+** Events and executive services
+*/
+typedef struct
+{
+    uint16 EventID;
+    uint16 Mask;
+} CFE_EVS_BinFilter_t;
+
+enum
+{
+    CFE_EVS_EventType_DEBUG       = 1,
+    CFE_EVS_EventType_INFORMATION = 2,
+    CFE_EVS_EventType_ERROR       = 3,
+    CFE_EVS_EventType_CRITICAL    = 4
+};
+
+#define CFE_EVS_EventFilter_BINARY 0
+
+typedef uint32 CFE_ES_CDSHandle_t;
+
+#define CFE_ES_RunStatus_APP_RUN   1
+#define CFE_ES_RunStatus_APP_EXIT  2
+#define CFE_ES_RunStatus_APP_ERROR 3
+
+/*
+** Child tasks and semaphores, on POSIX threads
+*/
+typedef uint32 osal_id_t;
+typedef uint32 CFE_ES_TaskId_t;
+typedef void (*CFE_ES_ChildTaskMainFuncPtr_t)(void);
+
+#define CFE_ES_TASK_STACK_ALLOCATE NULL
+#define OS_SEM_EMPTY               0
+#define OS_SEM_FULL                1
+
+/* Performance markers are not logged on the host */
+#define CFE_ES_PerfLogEntry(id) ((void)(id))
+#define CFE_ES_PerfLogExit(id)  ((void)(id))
+
+static inline CFE_SB_MsgId_t CFE_SB_ValueToMsgId(CFE_SB_MsgId_Atom_t Value)
+{
+    return Value;
+}
+
+static inline CFE_SB_MsgId_Atom_t CFE_SB_MsgIdToValue(CFE_SB_MsgId_t MsgId)
+{
+    return MsgId;
+}
+
+static inline bool CFE_SB_MsgId_Equal(CFE_SB_MsgId_t A, CFE_SB_MsgId_t B)
+{
+    return A == B;
+}
+
+static inline int64 OS_TimeGetTotalMilliseconds(OS_time_t Time)
+{
+    return Time.ticks / 10000;
+}
+
+int32 CFE_ES_WriteToSysLog(const char *SpecStringPtr, ...);
+bool  CFE_ES_RunLoop(uint32 *RunStatus);
+void  CFE_ES_ExitApp(uint32 ExitStatus);
+int32 CFE_ES_RegisterCDS(CFE_ES_CDSHandle_t *CDSHandlePtr, size_t BlockSize, const char *Name);
+int32 CFE_ES_CopyToCDS(CFE_ES_CDSHandle_t Handle, const void *DataToCopy);
+int32 CFE_ES_RestoreFromCDS(void *RestoreToMemory, CFE_ES_CDSHandle_t Handle);
+int32 CFE_ES_CreateChildTask(CFE_ES_TaskId_t *TaskIdPtr, const char *TaskName, CFE_ES_ChildTaskMainFuncPtr_t FunctionPtr,
+                             void *StackPtr, size_t StackSize, uint16 Priority, uint32 Flags);
+int32 CFE_ES_DeleteChildTask(CFE_ES_TaskId_t TaskId);
+void  CFE_ES_ExitChildTask(void);
+
+int32 OS_MutSemCreate(osal_id_t *sem_id, const char *sem_name, uint32 options);
+int32 OS_MutSemTake(osal_id_t sem_id);
+int32 OS_MutSemGive(osal_id_t sem_id);
+int32 OS_BinSemCreate(osal_id_t *sem_id, const char *sem_name, uint32 sem_initial_value, uint32 options);
+int32 OS_BinSemTake(osal_id_t sem_id);
+int32 OS_BinSemTimedWait(osal_id_t sem_id, uint32 msecs);
+int32 OS_BinSemGive(osal_id_t sem_id);
+
+int32 CFE_EVS_Register(const void *Filters, uint16 NumFilteredEvents, uint16 FilterScheme);
+int32 CFE_EVS_SendEvent(uint16 EventID, uint16 EventType, const char *Spec, ...);
+
+int32 CFE_SB_CreatePipe(CFE_SB_PipeId_t *PipeIdPtr, uint16 Depth, const char *PipeName);
+int32 CFE_SB_Subscribe(CFE_SB_MsgId_t MsgId, CFE_SB_PipeId_t PipeId);
+int32 CFE_SB_SubscribeEx(CFE_SB_MsgId_t MsgId, CFE_SB_PipeId_t PipeId, CFE_SB_Qos_t Quality, uint16 MsgLim);
+int32 CFE_SB_ReceiveBuffer(CFE_SB_Buffer_t **BufPtr, CFE_SB_PipeId_t PipeId, int32 TimeOut);
+int32 CFE_SB_TransmitMsg(const CFE_MSG_Message_t *MsgPtr, bool IncrementSequenceCount);
+int32 CFE_SB_TransmitBuffer(CFE_SB_Buffer_t *BufPtr, bool IncrementSequenceCount);
+int32 CFE_SB_ReleaseMessageBuffer(CFE_SB_Buffer_t *BufPtr);
+void  CFE_SB_TimeStampMsg(CFE_MSG_Message_t *MsgPtr);
+
+CFE_SB_Buffer_t *CFE_SB_AllocateMessageBuffer(size_t MsgSize);
+
+int32 CFE_MSG_Init(CFE_MSG_Message_t *MsgPtr, CFE_SB_MsgId_t MsgId, CFE_MSG_Size_t Size);
+int32 CFE_MSG_GetMsgId(const CFE_MSG_Message_t *MsgPtr, CFE_SB_MsgId_t *MsgId);
+int32 CFE_MSG_GetSize(const CFE_MSG_Message_t *MsgPtr, CFE_MSG_Size_t *Size);
+int32 CFE_MSG_GetType(const CFE_MSG_Message_t *MsgPtr, CFE_MSG_Type_t *Type);
+int32 CFE_MSG_GetHasSecondaryHeader(const CFE_MSG_Message_t *MsgPtr, bool *HasSecondary);
+int32 CFE_MSG_GetFcnCode(const CFE_MSG_Message_t *MsgPtr, CFE_MSG_FcnCode_t *FcnCode);
+int32 CFE_MSG_GetMsgTime(const CFE_MSG_Message_t *MsgPtr, CFE_TIME_SysTime_t *Time);
+int32 CFE_MSG_ValidateChecksum(const CFE_MSG_Message_t *MsgPtr, bool *IsValid);
+
+CFE_TIME_SysTime_t CFE_TIME_GetTime(void);
+CFE_TIME_SysTime_t CFE_TIME_Subtract(CFE_TIME_SysTime_t Time1, CFE_TIME_SysTime_t Time2);
+CFE_TIME_Compare_t CFE_TIME_Compare(CFE_TIME_SysTime_t TimeA, CFE_TIME_SysTime_t TimeB);
+uint32             CFE_TIME_Sub2MicroSecs(uint32 SubSeconds);
+
+void CFE_PSP_GetTime(OS_time_t *LocalTime);
+
+/*
+** Harness hooks
+*/
+
+/** Hand Buf to the next CFE_SB_ReceiveBuffer() on PipeId, once */
+void CFE_Shim_QueueBuffer(CFE_SB_PipeId_t PipeId, CFE_SB_Buffer_t *Buf);
+
+/** Events sent since start */
+uint32 CFE_Shim_EventCount(void);
+
+#endif /* CFE_H */
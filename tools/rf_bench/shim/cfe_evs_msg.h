@@ -0,0 +1,66 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ * Host stand-in, see cfe.h: event message layout
+ */
+
+#ifndef CFE_EVS_MSG_H
+#define CFE_EVS_MSG_H
+
+#include "cfe.h"
+
+#define CFE_MISSION_EVS_MAX_MESSAGE_LENGTH 122
+
+typedef struct
+{
+    char   AppName[CFE_MISSION_MAX_API_LEN];
+    uint16 EventID;
+    uint16 EventType;
+    uint32 SpacecraftID;
+    uint32 ProcessorID;
+} CFE_EVS_PacketID_t;
+
+typedef struct
+{
+    CFE_EVS_PacketID_t PacketID;
+    char               Message[CFE_MISSION_EVS_MAX_MESSAGE_LENGTH];
+    uint8              Spare1;
+    uint8              Spare2;
+} CFE_EVS_LongEventTlm_Payload_t;
+
+typedef struct
+{
+    CFE_MSG_TelemetryHeader_t      TelemetryHeader;
+    CFE_EVS_LongEventTlm_Payload_t Payload;
+} CFE_EVS_LongEventTlm_t;
+
+typedef struct
+{
+    CFE_EVS_PacketID_t PacketID;
+} CFE_EVS_ShortEventTlm_Payload_t;
+
+typedef struct
+{
+    CFE_MSG_TelemetryHeader_t       TelemetryHeader;
+    CFE_EVS_ShortEventTlm_Payload_t Payload;
+} CFE_EVS_ShortEventTlm_t;
+
+#endif /* CFE_EVS_MSG_H */
@@ -0,0 +1,1513 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * \file
+ *   Ground decoder for RF Telemetry Output frames.
+ *
+ *   Reads a capture, one frame per line as hex bytes or (-b) length-prefixed
+ *   binary records, and prints one CSV row per frame. The capture is mapped
+ *   and decoded in place; with -o the rows are split into one CSV per
+ *   source, and -B adds a binary capture per source.
+ *
+ *   Packed frames are decoded with the same schema table the flight app is
+ *   built with, so the codes printed are bit-exact with the encoder.
+ *
+ *   Every row starts with the frame kind, its sequence number and its
+ *   sample time in CFE seconds, rebuilt from the last time reference (empty
+ *   until one is seen). Sequence gaps are reported as "gap" rows; a frame
+ *   arriving behind the sequence is counted as late rather than lost. A
+ *   summary with the effective loss rate is printed to stderr at the end.
+ *
+ *   Fragments are reassembled by message number. A complete message is
+ *   printed as a "message" row with its bytes in hex. A message that misses
+ *   a fragment for longer than the timeout (-T, in sample time) is dropped
+ *   with a "fragfail" row; so is one whose slot is taken by a newer
+ *   message. Without a time reference, the timeout counts frames instead,
+ *   RF_DECODE_FRAG_WINDOW of them. The summary adds the reassembly failure
+ *   rate and the fragmentation efficiency, message bytes over frame bytes.
+ *
+ *   Summary frames are printed as "summary" rows: source, field, window
+ *   number, sample count, span in ms, then minimum, maximum, mean and last
+ *   value.
+ *
+ *   Event frames are printed as "event" rows: app name, event type, event
+ *   ID, events dropped on board so far, then the arguments as signed
+ *   integers. App names come from the RF_TLM_EVENT_APP_LIST the flight app
+ *   is built with; apps outside it are printed as "other".
+ *
+ *   Link test frames are printed as "test" rows with the number of filler
+ *   bytes that do not match. Their own sequence gives the loss of each run,
+ *   reported in the summary apart from the link loss.
+ *
+ *   With -C the capture holds CCSDS TM transfer frames. Frames failing the
+ *   frame error control are dropped, virtual channel count gaps are
+ *   reported as "tmgap" rows, and the space packets are rebuilt from the
+ *   first header pointers and decoded as above. Idle packets are counted
+ *   and skipped.
+ *
+ *   Compressed blocks are collected piece by piece and expanded once the
+ *   last piece is in; the frames inside are then decoded as above. A block
+ *   that misses a piece or does not expand is dropped with an "lzfail" row,
+ *   and block numbers that never showed up are reported as "lzgap" rows.
+ *   The summary adds the blocks lost and the compression ratio, piece
+ *   bytes over frame bytes.
+ */
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "rf_tlm_frame.h"
+#include "rf_tlm_pack.h"
+#include "rf_tlm_platform_cfg.h"
+
+#define RF_DECODE_FRAME_MAX 256
+
+/*
+** Binary captures are a sequence of records: a big-endian 16-bit frame
+** length, then the frame. The per-source binary export uses the same
+** format, so its files decode again.
+*/
+#define RF_DECODE_CAPTURE_LEN_BYTES 2
+
+/*
+** Sequence and time reconstruction state
+*/
+typedef struct
+{
+    int           HaveSeq;
+    uint16_t      NextSeq;
+    int           HaveRef;
+    double        RefTime; /* CFE seconds of the last time reference */
+    unsigned long Received;
+    unsigned long Lost;
+    unsigned long Late;
+} rf_decode_link_t;
+
+static rf_decode_link_t rf_decode_link;
+
+/*
+** Messages being reassembled
+*/
+#define RF_DECODE_FRAG_SLOTS  8
+#define RF_DECODE_FRAG_WINDOW 512
+
+typedef struct
+{
+    int           Used;
+    uint8_t       MsgNum;
+    uint8_t       Count;
+    uint16_t      Got;
+    uint16_t      Len;
+    int           HaveTime;
+    double        LastTime;  /* Sample time of the latest fragment */
+    unsigned long LastFrame; /* Frames received when the latest fragment arrived */
+    uint8_t       Have[(RF_TLM_FRAG_MAX_COUNT + 7) / 8];
+    uint8_t       Data[RF_TLM_FRAG_MAX_MSG_BYTES];
+} rf_decode_partial_t;
+
+typedef struct
+{
+    double              TimeoutSec;
+    rf_decode_partial_t Slots[RF_DECODE_FRAG_SLOTS];
+    unsigned long       Messages;
+    unsigned long       Failed;
+    unsigned long       DataBytes;
+    unsigned long       FrameBytes;
+} rf_decode_reasm_t;
+
+static rf_decode_reasm_t rf_decode_reasm = {.TimeoutSec = 5.0};
+
+/*
+** Link test frames, counted apart from the link sequence
+*/
+typedef struct
+{
+    int           HaveSeq;
+    uint8_t       Run;
+    uint32_t      NextSeq;
+    unsigned long Received;
+    unsigned long Lost;
+    unsigned long Corrupt;
+} rf_decode_test_t;
+
+static rf_decode_test_t rf_decode_test;
+
+/*
+** CCSDS transfer frame input: packet reassembly across frames
+*/
+#define RF_DECODE_PACKET_MAX (RF_TLM_SP_HDR_BYTES + RF_DECODE_FRAME_MAX)
+
+typedef struct
+{
+    int           Enabled;
+    int           Synced;     /* The next data field byte continues Packet */
+    uint8_t       HaveVc[RF_TLM_TM_VCID_MAX + 1];
+    uint8_t       NextVc[RF_TLM_TM_VCID_MAX + 1];
+    uint16_t      Have;       /* Bytes of Packet received */
+    uint16_t      Need;       /* Bytes of Packet expected, the header until it is in */
+    uint8_t       Packet[RF_DECODE_PACKET_MAX];
+    unsigned long Frames;
+    unsigned long BadCrc;
+    unsigned long Lost;
+    unsigned long Packets;
+    unsigned long IdleBytes;
+} rf_decode_tm_t;
+
+static rf_decode_tm_t rf_decode_tm;
+
+/*
+** Compressed block being collected
+*/
+typedef struct
+{
+    int           Active;     /* Pieces of Block are being collected */
+    int           HaveBlock;
+    uint8_t       Block;
+    uint8_t       NextBlock;  /* Block number expected to start next */
+    uint8_t       NextPiece;
+    uint16_t      Len;
+    uint8_t       Data[RF_TLM_LZ_BLOCK_BYTES];
+    uint8_t       Raw[RF_TLM_LZ_BLOCK_BYTES];
+    unsigned long Blocks;
+    unsigned long Lost;
+    unsigned long Frames;
+    unsigned long FrameBytes;
+    unsigned long PieceBytes;
+} rf_decode_lz_t;
+
+static rf_decode_lz_t rf_decode_lz;
+
+/*
+** Output streams: rows of the current frame's source, and link-level rows
+** (gaps, errors). Both are stdout unless -o splits the output per source.
+*/
+#define RF_DECODE_SINKS      32
+#define RF_DECODE_KEY_MAX    24
+#define RF_DECODE_STDIO_BUF  (1u << 20)
+
+typedef struct
+{
+    char  Key[RF_DECODE_KEY_MAX];
+    FILE *Csv;
+    FILE *Bin;
+} rf_decode_sink_t;
+
+static FILE            *rf_decode_out;
+static FILE            *rf_decode_log;
+static const char      *rf_decode_dir;
+static int              rf_decode_bin_export;
+static rf_decode_sink_t rf_decode_sinks[RF_DECODE_SINKS];
+static int              rf_decode_sink_count;
+
+/*
+** Hex digit values, -1 for separators
+*/
+static signed char rf_decode_hexval[256];
+
+static void rf_decode_init_hex(void)
+{
+    memset(rf_decode_hexval, -1, sizeof(rf_decode_hexval));
+    for (int i = 0; i < 10; i++)
+    {
+        rf_decode_hexval['0' + i] = (signed char)i;
+    }
+    for (int i = 0; i < 6; i++)
+    {
+        rf_decode_hexval['a' + i] = (signed char)(10 + i);
+        rf_decode_hexval['A' + i] = (signed char)(10 + i);
+    }
+}
+
+/*
+** Parse hex bytes up to End, ignoring separators. Returns the byte count
+** or -1.
+*/
+static int rf_decode_parse_hex(const char *Line, const char *End, uint8_t *Frame, int Max)
+{
+    int count = 0;
+    int nibble;
+    int high = -1;
+
+    for (; Line < End; Line++)
+    {
+        nibble = rf_decode_hexval[(unsigned char)*Line];
+        if (nibble < 0)
+        {
+            continue;
+        }
+
+        if (high < 0)
+        {
+            high = nibble;
+        }
+        else
+        {
+            if (count >= Max)
+            {
+                return -1;
+            }
+            Frame[count++] = (uint8_t)((high << 4) | nibble);
+            high           = -1;
+        }
+    }
+
+    return (high < 0) ? count : -1;
+}
+
+static FILE *rf_decode_open(const char *Key, const char *Ext)
+{
+    char  path[4096];
+    FILE *file;
+
+    snprintf(path, sizeof(path), "%s/%s.%s", rf_decode_dir, Key, Ext);
+    file = fopen(path, "wb");
+    if (file == NULL)
+    {
+        perror(path);
+        exit(1);
+    }
+    setvbuf(file, NULL, _IOFBF, RF_DECODE_STDIO_BUF);
+
+    return file;
+}
+
+/*
+** Route the rows of a frame to its source's files, and copy the frame to
+** the binary export
+*/
+static void rf_decode_select(const char *Key, const uint8_t *Frame, int Len)
+{
+    rf_decode_sink_t *sink = NULL;
+    uint8_t           prefix[RF_DECODE_CAPTURE_LEN_BYTES];
+
+    if (rf_decode_dir == NULL)
+    {
+        return;
+    }
+
+    for (int i = 0; i < rf_decode_sink_count; i++)
+    {
+        if (strcmp(rf_decode_sinks[i].Key, Key) == 0)
+        {
+            sink = &rf_decode_sinks[i];
+            break;
+        }
+    }
+
+    if (sink == NULL)
+    {
+        if (rf_decode_sink_count == RF_DECODE_SINKS)
+        {
+            /* Too many sources: the rest share the link file */
+            rf_decode_out = rf_decode_log;
+            return;
+        }
+
+        sink = &rf_decode_sinks[rf_decode_sink_count++];
+        snprintf(sink->Key, sizeof(sink->Key), "%s", Key);
+        sink->Csv = rf_decode_open(Key, "csv");
+        sink->Bin = rf_decode_bin_export ? rf_decode_open(Key, "bin") : NULL;
+    }
+
+    rf_decode_out = sink->Csv;
+
+    if (sink->Bin != NULL && Frame != NULL)
+    {
+        RF_TLM_Frame_PutU16(prefix, (uint16_t)Len);
+        fwrite(prefix, 1, sizeof(prefix), sink->Bin);
+        fwrite(Frame, 1, (size_t)Len, sink->Bin);
+    }
+}
+
+/*
+** Row formatting for the frames seen most often, much faster than printf
+*/
+static const char rf_decode_digits[] = "0123456789ABCDEF";
+
+static char *rf_decode_fmt_uint(char *p, unsigned long Value)
+{
+    char  tmp[24];
+    char *t = tmp;
+
+    do
+    {
+        *t++ = (char)('0' + Value % 10);
+        Value /= 10;
+    } while (Value != 0);
+
+    while (t > tmp)
+    {
+        *p++ = *--t;
+    }
+
+    return p;
+}
+
+static char *rf_decode_fmt_hex(char *p, const uint8_t *Data, int Len)
+{
+    for (int i = 0; i < Len; i++)
+    {
+        *p++ = rf_decode_digits[Data[i] >> 4];
+        *p++ = rf_decode_digits[Data[i] & 0x0F];
+    }
+
+    return p;
+}
+
+/*
+** Seconds with three decimals, as %.3f for the non-negative times seen here
+*/
+static char *rf_decode_fmt_msec(char *p, double Seconds)
+{
+    unsigned long long msec = (unsigned long long)(Seconds * 1000.0 + 0.5);
+    unsigned           frac = (unsigned)(msec % 1000);
+
+    p    = rf_decode_fmt_uint(p, (unsigned long)(msec / 1000));
+    *p++ = '.';
+    *p++ = (char)('0' + frac / 100);
+    *p++ = (char)('0' + frac / 10 % 10);
+    *p++ = (char)('0' + frac % 10);
+
+    return p;
+}
+
+/*
+** Account for the sequence number of a frame and print the row prefix
+*/
+static void rf_decode_track(const char *Kind, const uint8_t *Frame, int Len)
+{
+    char              buf[64];
+    char             *p;
+    rf_decode_link_t *link = &rf_decode_link;
+    uint16_t          seq;
+    uint16_t          ahead;
+    int               offset;
+
+    offset = RF_TLM_Frame_SeqOffset(Frame, (uint16_t)Len);
+    seq    = RF_TLM_Frame_GetU16(&Frame[offset]);
+    ++link->Received;
+
+    if (!link->HaveSeq)
+    {
+        link->HaveSeq = 1;
+        link->NextSeq = (uint16_t)(seq + 1);
+    }
+    else
+    {
+        ahead = (uint16_t)(seq - link->NextSeq);
+        if (ahead < 0x8000u)
+        {
+            if (ahead != 0)
+            {
+                fprintf(rf_decode_log, "gap,%u,%u,%u\n", link->NextSeq, (uint16_t)(seq - 1), ahead);
+                link->Lost += ahead;
+            }
+            link->NextSeq = (uint16_t)(seq + 1);
+        }
+        else
+        {
+            /* Behind the sequence: reordered or duplicated, no longer missing */
+            ++link->Late;
+            if (link->Lost > 0)
+            {
+                --link->Lost;
+            }
+        }
+    }
+
+    p = buf;
+    while (*Kind != '\0')
+    {
+        *p++ = *Kind++;
+    }
+    *p++ = ',';
+    p    = rf_decode_fmt_uint(p, seq);
+    *p++ = ',';
+
+    offset = RF_TLM_Frame_DtOffset(Frame, (uint16_t)Len);
+    if (offset >= 0 && link->HaveRef)
+    {
+        p = rf_decode_fmt_msec(p, link->RefTime + RF_TLM_Frame_GetU16(&Frame[offset]) / 1000.0);
+    }
+
+    fwrite(buf, 1, (size_t)(p - buf), rf_decode_out);
+}
+
+static void rf_decode_timeref(const uint8_t *Frame, int Len)
+{
+    if (Len < RF_TLM_TIMEREF_FRAME_BYTES)
+    {
+        fprintf(rf_decode_log, "error,short time reference (%d bytes)\n", Len);
+        return;
+    }
+
+    rf_decode_link.HaveRef = 1;
+    rf_decode_link.RefTime = RF_TLM_Frame_GetU32(&Frame[RF_TLM_TIMEREF_SECONDS_OFFSET]) +
+                             RF_TLM_Frame_GetU32(&Frame[RF_TLM_TIMEREF_SUBSECS_OFFSET]) / 4294967296.0;
+
+    rf_decode_track("timeref", Frame, Len);
+    fprintf(rf_decode_out, "%.6f\n", rf_decode_link.RefTime);
+}
+
+static void rf_decode_ack(const uint8_t *Frame, int Len)
+{
+    if (Len < RF_TLM_ACK_FRAME_BYTES)
+    {
+        fprintf(rf_decode_log, "error,short acknowledgement (%d bytes)\n", Len);
+        return;
+    }
+
+    rf_decode_track("ack", Frame, Len);
+    fprintf(rf_decode_out, ",%u,%u,%u\n", Frame[RF_TLM_ACK_UPLINK_SEQ_OFFSET], Frame[RF_TLM_ACK_STATUS_OFFSET],
+           RF_TLM_Frame_GetU16(&Frame[RF_TLM_ACK_LATENCY_OFFSET]));
+}
+
+static void rf_decode_put_hex(const uint8_t *Data, uint16_t Len)
+{
+    char     buf[2 * 64];
+    uint16_t chunk;
+
+    while (Len > 0)
+    {
+        chunk = (Len < sizeof(buf) / 2) ? Len : (uint16_t)(sizeof(buf) / 2);
+        fwrite(buf, 1, (size_t)(rf_decode_fmt_hex(buf, Data, chunk) - buf), rf_decode_out);
+        Data += chunk;
+        Len = (uint16_t)(Len - chunk);
+    }
+}
+
+static void rf_decode_frag_fail(rf_decode_partial_t *Partial, const char *Reason)
+{
+    fprintf(rf_decode_out, "fragfail,%u,%u,%u,%s\n", Partial->MsgNum, Partial->Got, Partial->Count, Reason);
+    ++rf_decode_reasm.Failed;
+    Partial->Used = 0;
+}
+
+/*
+** Drop messages that have waited too long for a fragment
+*/
+static void rf_decode_frag_expire(int HaveTime, double Now)
+{
+    rf_decode_partial_t *partial;
+
+    for (int i = 0; i < RF_DECODE_FRAG_SLOTS; i++)
+    {
+        partial = &rf_decode_reasm.Slots[i];
+        if (!partial->Used)
+        {
+            continue;
+        }
+
+        if (HaveTime && partial->HaveTime)
+        {
+            if (Now - partial->LastTime > rf_decode_reasm.TimeoutSec)
+            {
+                rf_decode_frag_fail(partial, "timeout");
+            }
+        }
+        else if (rf_decode_link.Received - partial->LastFrame > RF_DECODE_FRAG_WINDOW)
+        {
+            rf_decode_frag_fail(partial, "timeout");
+        }
+    }
+}
+
+static void rf_decode_fragment(const uint8_t *Frame, int Len)
+{
+    rf_decode_partial_t *partial = NULL;
+    rf_decode_partial_t *oldest  = NULL;
+    uint8_t              msgnum;
+    uint8_t              index;
+    uint8_t              count;
+    uint16_t             start;
+    uint16_t             datalen;
+    int                  have_time;
+    double               now = 0.0;
+
+    if (Len < RF_TLM_FRAG_HDR_BYTES)
+    {
+        fprintf(rf_decode_log, "error,short fragment (%d bytes)\n", Len);
+        return;
+    }
+
+    msgnum  = Frame[RF_TLM_FRAG_MSGNUM_OFFSET];
+    index   = Frame[RF_TLM_FRAG_INDEX_OFFSET];
+    count   = Frame[RF_TLM_FRAG_COUNT_OFFSET];
+    datalen = (uint16_t)(Len - RF_TLM_FRAG_HDR_BYTES);
+
+    /* Every fragment but the last is full */
+    if (count == 0 || index >= count || datalen == 0 || datalen > RF_TLM_FRAG_DATA_BYTES ||
+        (index + 1 < count && datalen != RF_TLM_FRAG_DATA_BYTES))
+    {
+        fprintf(rf_decode_log, "error,bad fragment %u/%u of message %u (%d bytes)\n", index, count, msgnum, Len);
+        return;
+    }
+
+    rf_decode_track("fragment", Frame, Len);
+    fprintf(rf_decode_out, ",%u,%u,%u\n", msgnum, index, count);
+
+    rf_decode_reasm.DataBytes += datalen;
+    rf_decode_reasm.FrameBytes += (unsigned long)Len;
+
+    have_time = rf_decode_link.HaveRef;
+    if (have_time)
+    {
+        now = rf_decode_link.RefTime + RF_TLM_Frame_GetU16(&Frame[RF_TLM_FRAG_DT_OFFSET]) / 1000.0;
+    }
+    rf_decode_frag_expire(have_time, now);
+
+    for (int i = 0; i < RF_DECODE_FRAG_SLOTS; i++)
+    {
+        if (rf_decode_reasm.Slots[i].Used && rf_decode_reasm.Slots[i].MsgNum == msgnum)
+        {
+            partial = &rf_decode_reasm.Slots[i];
+            break;
+        }
+    }
+
+    /* The message number came round again for a different message */
+    if (partial != NULL && partial->Count != count)
+    {
+        rf_decode_frag_fail(partial, "replaced");
+        partial = NULL;
+    }
+
+    if (partial == NULL)
+    {
+        for (int i = 0; i < RF_DECODE_FRAG_SLOTS; i++)
+        {
+            if (!rf_decode_reasm.Slots[i].Used)
+            {
+                partial = &rf_decode_reasm.Slots[i];
+                break;
+            }
+            if (oldest == NULL || rf_decode_reasm.Slots[i].LastFrame < oldest->LastFrame)
+            {
+                oldest = &rf_decode_reasm.Slots[i];
+            }
+        }
+
+        if (partial == NULL)
+        {
+            rf_decode_frag_fail(oldest, "evicted");
+            partial = oldest;
+        }
+
+        memset(partial->Have, 0, sizeof(partial->Have));
+        partial->Used   = 1;
+        partial->MsgNum = msgnum;
+        partial->Count  = count;
+        partial->Got    = 0;
+        partial->Len    = 0;
+    }
+
+    partial->HaveTime  = have_time;
+    partial->LastTime  = now;
+    partial->LastFrame = rf_decode_link.Received;
+
+    if (partial->Have[index / 8] & (1u << (index % 8)))
+    {
+        return;
+    }
+
+    start = (uint16_t)(index * RF_TLM_FRAG_DATA_BYTES);
+    memcpy(&partial->Data[start], &Frame[RF_TLM_FRAG_HDR_BYTES], datalen);
+    partial->Have[index / 8] |= (uint8_t)(1u << (index % 8));
+    ++partial->Got;
+    if (index + 1 == count)
+    {
+        partial->Len = (uint16_t)(start + datalen);
+    }
+
+    if (partial->Got == partial->Count)
+    {
+        fprintf(rf_decode_out, "message,%u,%u,", partial->MsgNum, partial->Len);
+        rf_decode_put_hex(partial->Data, partial->Len);
+        fputc('\n', rf_decode_out);
+
+        ++rf_decode_reasm.Messages;
+        partial->Used = 0;
+    }
+}
+
+static void rf_decode_raw(const uint8_t *Frame, int Len)
+{
+    char  buf[128];
+    char *p = buf;
+
+    if (Len < RF_TLM_RAW_FRAME_BYTES)
+    {
+        fprintf(rf_decode_log, "error,short raw frame (%d bytes)\n", Len);
+        return;
+    }
+
+    rf_decode_track("raw", Frame, Len);
+
+    *p++ = ',';
+    *p++ = '0';
+    *p++ = 'x';
+    p    = rf_decode_fmt_hex(p, &Frame[RF_TLM_RAW_APPID_OFFSET], 2);
+    *p++ = ',';
+    p    = rf_decode_fmt_uint(p, Frame[RF_TLM_RAW_ERRCNT_OFFSET]);
+    *p++ = ',';
+    p    = rf_decode_fmt_uint(p, Frame[RF_TLM_RAW_CMDCNT_OFFSET]);
+
+    for (int i = 0; i < RF_TLM_RAW_FIELD_COUNT; i++)
+    {
+        *p++ = ',';
+        *p++ = '0';
+        *p++ = 'x';
+        p    = rf_decode_fmt_hex(p, &Frame[RF_TLM_RAW_FIELD_OFFSET + i * RF_TLM_RAW_FIELD_BYTES],
+                                 RF_TLM_RAW_FIELD_BYTES);
+    }
+    *p++ = '\n';
+
+    fwrite(buf, 1, (size_t)(p - buf), rf_decode_out);
+}
+
+static void rf_decode_packed(const uint8_t *Frame, int Len)
+{
+    const RF_TLM_Schema_t *schema;
+    RF_TLM_Unpacked_t      unpacked;
+
+    if (Len < RF_TLM_PACKED_BITS_OFFSET)
+    {
+        fprintf(rf_decode_log, "error,short packed frame (%d bytes)\n", Len);
+        return;
+    }
+
+    schema = RF_TLM_Pack_GetSchema(Frame[RF_TLM_PACKED_SCHEMA_OFFSET]);
+    if (schema == NULL)
+    {
+        fprintf(rf_decode_log, "error,unknown schema %u\n", Frame[RF_TLM_PACKED_SCHEMA_OFFSET]);
+        return;
+    }
+
+    if (RF_TLM_Pack_Decode(schema, &Frame[RF_TLM_PACKED_BITS_OFFSET], (uint16_t)(Len - RF_TLM_PACKED_BITS_OFFSET),
+                           &unpacked) != 0)
+    {
+        fprintf(rf_decode_log, "error,short %s packed frame (%d bytes)\n", schema->Name, Len);
+        return;
+    }
+
+    rf_decode_track("packed", Frame, Len);
+    fprintf(rf_decode_out, ",%s,%u,%u", schema->Name, unpacked.ErrCounter, unpacked.CmdCounter);
+    for (int i = 0; i < RF_TLM_RAW_FIELD_COUNT; i++)
+    {
+        if (schema->Fields[i].Kind == RF_TLM_FIELD_UNUSED)
+        {
+            fprintf(rf_decode_out, ",");
+        }
+        else
+        {
+            fprintf(rf_decode_out, ",%.9g", unpacked.Value[i]);
+        }
+    }
+    fprintf(rf_decode_out, "\n");
+}
+
+/*
+** Big-endian float32 statistic of a summary frame
+*/
+static double rf_decode_float(const uint8_t *Src)
+{
+    uint32_t word = RF_TLM_Frame_GetU32(Src);
+    float    fval;
+
+    memcpy(&fval, &word, sizeof(fval));
+
+    return (double)fval;
+}
+
+/*
+** App names by event app code
+*/
+#define RF_DECODE_EVENT_APP(Name, MinType) Name,
+static const char *const rf_decode_event_apps[] = {RF_TLM_EVENT_APP_LIST(RF_DECODE_EVENT_APP)};
+#undef RF_DECODE_EVENT_APP
+
+static void rf_decode_event(const uint8_t *Frame, int Len)
+{
+    uint8_t argc;
+    uint8_t code;
+
+    if (Len < RF_TLM_EVENT_HDR_BYTES)
+    {
+        fprintf(rf_decode_log, "error,short event frame (%d bytes)\n", Len);
+        return;
+    }
+
+    argc = Frame[RF_TLM_EVENT_ARGC_OFFSET];
+    if (argc > RF_TLM_EVENT_MAX_ARGS || Len < RF_TLM_EVENT_HDR_BYTES + 4 * argc)
+    {
+        fprintf(rf_decode_log, "error,short event frame (%d bytes, %u arguments)\n", Len, argc);
+        return;
+    }
+
+    rf_decode_track("event", Frame, Len);
+
+    code = Frame[RF_TLM_EVENT_APP_OFFSET];
+    if (code < sizeof(rf_decode_event_apps) / sizeof(rf_decode_event_apps[0]))
+    {
+        fprintf(rf_decode_out, ",%s", rf_decode_event_apps[code]);
+    }
+    else if (code == RF_TLM_EVENT_APP_OTHER)
+    {
+        fprintf(rf_decode_out, ",other");
+    }
+    else
+    {
+        fprintf(rf_decode_out, ",app_%u", code);
+    }
+    fprintf(rf_decode_out, ",%u,%u,%u", Frame[RF_TLM_EVENT_TYPE_OFFSET],
+            RF_TLM_Frame_GetU16(&Frame[RF_TLM_EVENT_EID_OFFSET]), Frame[RF_TLM_EVENT_DROPPED_OFFSET]);
+    for (uint8_t i = 0; i < argc; i++)
+    {
+        fprintf(rf_decode_out, ",%ld", (long)(int32_t)RF_TLM_Frame_GetU32(&Frame[RF_TLM_EVENT_HDR_BYTES + 4 * i]));
+    }
+    fprintf(rf_decode_out, "\n");
+}
+
+static void rf_decode_summary(const uint8_t *Frame, int Len)
+{
+    const RF_TLM_Schema_t *schema;
+
+    if (Len < RF_TLM_SUMMARY_FRAME_BYTES)
+    {
+        fprintf(rf_decode_log, "error,short summary frame (%d bytes)\n", Len);
+        return;
+    }
+
+    schema = RF_TLM_Pack_GetSchema(Frame[RF_TLM_SUMMARY_SCHEMA_OFFSET]);
+    if (schema == NULL || Frame[RF_TLM_SUMMARY_FIELD_OFFSET] >= RF_TLM_RAW_FIELD_COUNT)
+    {
+        fprintf(rf_decode_log, "error,unknown summary schema %u field %u\n", Frame[RF_TLM_SUMMARY_SCHEMA_OFFSET],
+                Frame[RF_TLM_SUMMARY_FIELD_OFFSET]);
+        return;
+    }
+
+    rf_decode_track("summary", Frame, Len);
+    fprintf(rf_decode_out, ",%s,%u,%u,%u,%u,%.9g,%.9g,%.9g,%.9g\n", schema->Name,
+            Frame[RF_TLM_SUMMARY_FIELD_OFFSET], Frame[RF_TLM_SUMMARY_WINDOW_OFFSET],
+            RF_TLM_Frame_GetU16(&Frame[RF_TLM_SUMMARY_COUNT_OFFSET]),
+            RF_TLM_Frame_GetU16(&Frame[RF_TLM_SUMMARY_SPAN_OFFSET]),
+            rf_decode_float(&Frame[RF_TLM_SUMMARY_MIN_OFFSET]), rf_decode_float(&Frame[RF_TLM_SUMMARY_MAX_OFFSET]),
+            rf_decode_float(&Frame[RF_TLM_SUMMARY_MEAN_OFFSET]), rf_decode_float(&Frame[RF_TLM_SUMMARY_LAST_OFFSET]));
+}
+
+static void rf_decode_testframe(const uint8_t *Frame, int Len)
+{
+    rf_decode_test_t *test = &rf_decode_test;
+    uint8_t           run;
+    uint32_t          seq;
+    int               bad;
+
+    if (Len < RF_TLM_TEST_HDR_BYTES)
+    {
+        fprintf(rf_decode_log, "error,short test frame (%d bytes)\n", Len);
+        return;
+    }
+
+    run = Frame[RF_TLM_TEST_RUN_OFFSET];
+    seq = RF_TLM_Frame_GetU32(&Frame[RF_TLM_TEST_SEQ_OFFSET]);
+    bad = RF_TLM_Frame_CheckTest(Frame, (uint16_t)Len);
+
+    if (!test->HaveSeq || run != test->Run)
+    {
+        /* A new run starts at 0, the frames before the first one seen were lost */
+        test->HaveSeq = 1;
+        test->Run     = run;
+        test->Lost += seq;
+        test->NextSeq = seq + 1;
+    }
+    else if (seq >= test->NextSeq)
+    {
+        test->Lost += seq - test->NextSeq;
+        test->NextSeq = seq + 1;
+    }
+    else if (test->Lost > 0)
+    {
+        --test->Lost;
+    }
+
+    ++test->Received;
+    if (bad != 0)
+    {
+        ++test->Corrupt;
+    }
+
+    fprintf(rf_decode_out, "test,%u,%lu,%d,%d\n", run, (unsigned long)seq, Len, bad);
+}
+
+/*
+** Source a frame's rows are filed under: the schema name where the frame
+** comes from a known source, the frame kind otherwise
+*/
+static void rf_decode_key(const uint8_t *Frame, int Len, char *Key, size_t Size)
+{
+    const RF_TLM_Schema_t *schema = NULL;
+    uint8_t                id;
+
+    switch (Frame[0])
+    {
+        case RF_TLM_FRAME_TIMEREF:
+            snprintf(Key, Size, "timeref");
+            return;
+
+        case RF_TLM_FRAME_ACK:
+            snprintf(Key, Size, "ack");
+            return;
+
+        case RF_TLM_FRAME_FRAGMENT:
+            snprintf(Key, Size, "fragment");
+            return;
+
+        case RF_TLM_FRAME_TEST:
+            snprintf(Key, Size, "test");
+            return;
+
+        case RF_TLM_FRAME_EVENT:
+            snprintf(Key, Size, "event");
+            return;
+
+        case RF_TLM_FRAME_PACKED:
+            if (Len > RF_TLM_PACKED_SCHEMA_OFFSET)
+            {
+                schema = RF_TLM_Pack_GetSchema(Frame[RF_TLM_PACKED_SCHEMA_OFFSET]);
+            }
+            break;
+
+        case RF_TLM_FRAME_SUMMARY:
+            if (Len > RF_TLM_SUMMARY_SCHEMA_OFFSET)
+            {
+                schema = RF_TLM_Pack_GetSchema(Frame[RF_TLM_SUMMARY_SCHEMA_OFFSET]);
+            }
+            break;
+
+        default:
+            if (Frame[0] < RF_TLM_FRAME_TYPE_MIN && Len >= 2)
+            {
+                schema = RF_TLM_Pack_FindSchema(RF_TLM_Frame_GetU16(&Frame[RF_TLM_RAW_APPID_OFFSET]), &id);
+                if (schema == NULL)
+                {
+                    snprintf(Key, Size, "app_%04X", RF_TLM_Frame_GetU16(&Frame[RF_TLM_RAW_APPID_OFFSET]));
+                    return;
+                }
+            }
+            break;
+    }
+
+    snprintf(Key, Size, "%s", (schema != NULL) ? schema->Name : "unknown");
+}
+
+static void rf_decode_frame(const uint8_t *Frame, int Len);
+
+static void rf_decode_lz_fail(const char *Reason)
+{
+    fprintf(rf_decode_log, "lzfail,%u,%u,%s\n", rf_decode_lz.Block, rf_decode_lz.NextPiece, Reason);
+    ++rf_decode_lz.Lost;
+    rf_decode_lz.Active = 0;
+}
+
+/*
+** Frames of a complete block, one record after the other
+*/
+static void rf_decode_lz_block(int Stored)
+{
+    rf_decode_lz_t *lz = &rf_decode_lz;
+    const uint8_t  *raw;
+    int             len;
+    int             pos;
+    int             n;
+
+    if (Stored)
+    {
+        raw = lz->Data;
+        len = lz->Len;
+    }
+    else
+    {
+        raw = lz->Raw;
+        len = RF_TLM_Frame_Expand(lz->Raw, sizeof(lz->Raw), lz->Data, lz->Len);
+        if (len == 0)
+        {
+            rf_decode_lz_fail("corrupt");
+            return;
+        }
+    }
+
+    lz->Active = 0;
+    ++lz->Blocks;
+
+    for (pos = 0; pos < len; pos += 1 + n)
+    {
+        n = raw[pos];
+        if (n == 0 || n > len - pos - 1 || raw[pos + 1] == RF_TLM_FRAME_LZ)
+        {
+            fprintf(rf_decode_log, "error,bad record in block %u\n", lz->Block);
+            return;
+        }
+        ++lz->Frames;
+        lz->FrameBytes += (unsigned long)n;
+        rf_decode_frame(&raw[pos + 1], n);
+    }
+}
+
+static void rf_decode_lzpiece(const uint8_t *Frame, int Len)
+{
+    rf_decode_lz_t *lz = &rf_decode_lz;
+    uint8_t         block;
+    uint8_t         info;
+    uint8_t         index;
+    int             n;
+
+    if (Len <= RF_TLM_LZ_HDR_BYTES)
+    {
+        fprintf(rf_decode_log, "error,short compressed piece\n");
+        return;
+    }
+
+    block = Frame[RF_TLM_LZ_BLOCK_NUM_OFFSET];
+    info  = Frame[RF_TLM_LZ_INFO_OFFSET];
+    index = info & RF_TLM_LZ_INDEX_MASK;
+    lz->PieceBytes += (unsigned long)Len;
+
+    if (lz->Active && (block != lz->Block || index != lz->NextPiece))
+    {
+        rf_decode_lz_fail("incomplete");
+    }
+
+    /* Pieces of a block whose start was lost are skipped, the gap counts it */
+    if (!lz->Active)
+    {
+        if (index != 0)
+        {
+            return;
+        }
+        if (lz->HaveBlock && block != lz->NextBlock)
+        {
+            n = (uint8_t)(block - lz->NextBlock);
+            lz->Lost += (unsigned long)n;
+            fprintf(rf_decode_log, "lzgap,%u,%d\n", lz->NextBlock, n);
+        }
+        lz->HaveBlock = 1;
+        lz->NextBlock = (uint8_t)(block + 1);
+        lz->Active    = 1;
+        lz->Block     = block;
+        lz->NextPiece = 0;
+        lz->Len       = 0;
+    }
+
+    n = Len - RF_TLM_LZ_HDR_BYTES;
+    if (n > (int)sizeof(lz->Data) - lz->Len)
+    {
+        rf_decode_lz_fail("oversized");
+        return;
+    }
+    memcpy(&lz->Data[lz->Len], &Frame[RF_TLM_LZ_HDR_BYTES], (size_t)n);
+    lz->Len = (uint16_t)(lz->Len + n);
+    ++lz->NextPiece;
+
+    if (info & RF_TLM_LZ_LAST)
+    {
+        rf_decode_lz_block((info & RF_TLM_LZ_STORED) != 0);
+    }
+}
+
+static void rf_decode_frame(const uint8_t *Frame, int Len)
+{
+    char key[RF_DECODE_KEY_MAX];
+
+    if (Len <= 0)
+    {
+        return;
+    }
+
+    /* Not a row of its own: the frames inside are decoded once the block is complete */
+    if (Frame[0] == RF_TLM_FRAME_LZ)
+    {
+        rf_decode_lzpiece(Frame, Len);
+        return;
+    }
+
+    rf_decode_out = (rf_decode_dir != NULL) ? rf_decode_log : stdout;
+    if (rf_decode_dir != NULL)
+    {
+        rf_decode_key(Frame, Len, key, sizeof(key));
+        rf_decode_select(key, Frame, Len);
+    }
+
+    if (Frame[0] == RF_TLM_FRAME_TIMEREF)
+    {
+        rf_decode_timeref(Frame, Len);
+    }
+    else if (Frame[0] == RF_TLM_FRAME_ACK)
+    {
+        rf_decode_ack(Frame, Len);
+    }
+    else if (Frame[0] == RF_TLM_FRAME_PACKED)
+    {
+        rf_decode_packed(Frame, Len);
+    }
+    else if (Frame[0] == RF_TLM_FRAME_FRAGMENT)
+    {
+        rf_decode_fragment(Frame, Len);
+    }
+    else if (Frame[0] == RF_TLM_FRAME_TEST)
+    {
+        rf_decode_testframe(Frame, Len);
+    }
+    else if (Frame[0] == RF_TLM_FRAME_SUMMARY)
+    {
+        rf_decode_summary(Frame, Len);
+    }
+    else if (Frame[0] == RF_TLM_FRAME_EVENT)
+    {
+        rf_decode_event(Frame, Len);
+    }
+    else if (Frame[0] < RF_TLM_FRAME_TYPE_MIN)
+    {
+        rf_decode_raw(Frame, Len);
+    }
+    else
+    {
+        fprintf(rf_decode_log, "error,unknown frame type 0x%02X\n", Frame[0]);
+    }
+}
+
+/*
+** Space packet rebuilt from transfer frames
+*/
+static void rf_decode_packet(const uint8_t *Packet, uint16_t Len)
+{
+    if ((RF_TLM_Frame_GetU16(Packet) & RF_TLM_SP_APID_MASK) == RF_TLM_SP_IDLE_APID)
+    {
+        rf_decode_tm.IdleBytes += Len;
+        return;
+    }
+
+    ++rf_decode_tm.Packets;
+    rf_decode_frame(&Packet[RF_TLM_SP_HDR_BYTES], Len - RF_TLM_SP_HDR_BYTES);
+}
+
+static void rf_decode_tmframe(const uint8_t *Frame, int Len)
+{
+    rf_decode_tm_t *tm = &rf_decode_tm;
+    const uint8_t  *data;
+    int             data_len;
+    int             pos;
+    int             n;
+    uint8_t         vc;
+    uint16_t        fhp;
+
+    rf_decode_out = (rf_decode_dir != NULL) ? rf_decode_log : stdout;
+
+    if (Len < RF_TLM_TM_HDR_BYTES + RF_TLM_TM_FECF_BYTES + 1)
+    {
+        fprintf(rf_decode_log, "error,short transfer frame\n");
+        return;
+    }
+
+    ++tm->Frames;
+    if (RF_TLM_Frame_Crc16(Frame, (uint16_t)(Len - RF_TLM_TM_FECF_BYTES)) !=
+        RF_TLM_Frame_GetU16(&Frame[Len - RF_TLM_TM_FECF_BYTES]))
+    {
+        ++tm->BadCrc;
+        tm->Synced = 0;
+        fprintf(rf_decode_log, "error,transfer frame CRC\n");
+        return;
+    }
+
+    /* A count gap cuts the packet in progress, resync on the next header */
+    vc = (uint8_t)((Frame[1] >> 1) & RF_TLM_TM_VCID_MAX);
+    if (tm->HaveVc[vc] && Frame[RF_TLM_TM_VCCOUNT_OFFSET] != tm->NextVc[vc])
+    {
+        n = (uint8_t)(Frame[RF_TLM_TM_VCCOUNT_OFFSET] - tm->NextVc[vc]);
+        tm->Lost += (unsigned long)n;
+        tm->Synced = 0;
+        fprintf(rf_decode_log, "tmgap,%u,%u,%d\n", vc, tm->NextVc[vc], n);
+    }
+    tm->HaveVc[vc] = 1;
+    tm->NextVc[vc] = (uint8_t)(Frame[RF_TLM_TM_VCCOUNT_OFFSET] + 1);
+
+    data     = &Frame[RF_TLM_TM_HDR_BYTES];
+    data_len = Len - RF_TLM_TM_HDR_BYTES - RF_TLM_TM_FECF_BYTES;
+    fhp      = RF_TLM_Frame_GetU16(&Frame[RF_TLM_TM_DFS_OFFSET]) & RF_TLM_TM_FHP_MASK;
+    pos      = 0;
+
+    if (!tm->Synced)
+    {
+        if (fhp == RF_TLM_TM_FHP_NONE || fhp >= data_len)
+        {
+            return;
+        }
+        pos        = fhp;
+        tm->Synced = 1;
+        tm->Have   = 0;
+        tm->Need   = RF_TLM_SP_HDR_BYTES;
+    }
+
+    while (pos < data_len)
+    {
+        n = tm->Need - tm->Have;
+        if (n > data_len - pos)
+        {
+            n = data_len - pos;
+        }
+        memcpy(&tm->Packet[tm->Have], &data[pos], (size_t)n);
+        tm->Have = (uint16_t)(tm->Have + n);
+        pos += n;
+
+        if (tm->Have < tm->Need)
+        {
+            break;
+        }
+
+        if (tm->Need == RF_TLM_SP_HDR_BYTES)
+        {
+            tm->Need = (uint16_t)(RF_TLM_SP_HDR_BYTES + RF_TLM_Frame_GetU16(&tm->Packet[RF_TLM_SP_LEN_OFFSET]) + 1);
+            if (tm->Need > RF_DECODE_PACKET_MAX)
+            {
+                fprintf(rf_decode_log, "error,packet of %u bytes\n", tm->Need);
+                tm->Synced = 0;
+                return;
+            }
+            continue;
+        }
+
+        rf_decode_packet(tm->Packet, tm->Need);
+        tm->Have = 0;
+        tm->Need = RF_TLM_SP_HDR_BYTES;
+    }
+}
+
+/*
+** A capture record: a frame, or with -C a transfer frame
+*/
+static void rf_decode_record(const uint8_t *Frame, int Len)
+{
+    if (rf_decode_tm.Enabled)
+    {
+        rf_decode_tmframe(Frame, Len);
+    }
+    else
+    {
+        rf_decode_frame(Frame, Len);
+    }
+}
+
+/*
+** One frame per line of hex
+*/
+static void rf_decode_hex_capture(const char *Data, size_t Size)
+{
+    const char *end = Data + Size;
+    const char *eol;
+    uint8_t     frame[RF_DECODE_FRAME_MAX];
+    int         len;
+
+    while (Data < end)
+    {
+        eol = memchr(Data, '\n', (size_t)(end - Data));
+        if (eol == NULL)
+        {
+            eol = end;
+        }
+
+        len = rf_decode_parse_hex(Data, eol, frame, sizeof(frame));
+        if (len > 0)
+        {
+            rf_decode_record(frame, len);
+        }
+        else if (len < 0)
+        {
+            fprintf(rf_decode_log, "error,bad hex line\n");
+        }
+
+        Data = eol + 1;
+    }
+}
+
+/*
+** Length-prefixed binary records
+*/
+static void rf_decode_bin_capture(const uint8_t *Data, size_t Size)
+{
+    size_t   pos = 0;
+    uint16_t len;
+
+    while (pos + RF_DECODE_CAPTURE_LEN_BYTES <= Size)
+    {
+        len = RF_TLM_Frame_GetU16(&Data[pos]);
+        pos += RF_DECODE_CAPTURE_LEN_BYTES;
+
+        if (len > Size - pos)
+        {
+            fprintf(rf_decode_log, "error,truncated record at byte %zu\n", pos - RF_DECODE_CAPTURE_LEN_BYTES);
+            return;
+        }
+
+        /* Frames are decoded in place, the mapping is never copied */
+        rf_decode_record(&Data[pos], len);
+        pos += len;
+    }
+
+    if (pos != Size)
+    {
+        fprintf(rf_decode_log, "error,truncated record at byte %zu\n", pos);
+    }
+}
+
+/*
+** Whole input in memory: mapped for regular files, read for pipes
+*/
+static const uint8_t *rf_decode_load(const char *Path, size_t *Size, int *Mapped)
+{
+    struct stat st;
+    uint8_t    *data = NULL;
+    size_t      cap  = 0;
+    size_t      got;
+    int         fd = STDIN_FILENO;
+
+    *Size   = 0;
+    *Mapped = 0;
+
+    if (Path != NULL)
+    {
+        fd = open(Path, O_RDONLY);
+        if (fd < 0)
+        {
+            perror(Path);
+            exit(1);
+        }
+    }
+
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode))
+    {
+        if (st.st_size == 0)
+        {
+            close(fd);
+            return (const uint8_t *)"";
+        }
+
+        data = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data != MAP_FAILED)
+        {
+            madvise(data, (size_t)st.st_size, MADV_SEQUENTIAL);
+            close(fd);
+            *Size   = (size_t)st.st_size;
+            *Mapped = 1;
+            return data;
+        }
+        data = NULL;
+    }
+
+    for (;;)
+    {
+        if (*Size == cap)
+        {
+            cap  = (cap == 0) ? RF_DECODE_STDIO_BUF : cap * 2;
+            data = realloc(data, cap);
+            if (data == NULL)
+            {
+                fprintf(stderr, "out of memory reading input\n");
+                exit(1);
+            }
+        }
+
+        got = (size_t)read(fd, data + *Size, cap - *Size);
+        if (got == 0 || got == (size_t)-1)
+        {
+            break;
+        }
+        *Size += got;
+    }
+
+    if (fd != STDIN_FILENO)
+    {
+        close(fd);
+    }
+
+    return data;
+}
+
+static void rf_decode_usage(const char *Name)
+{
+    fprintf(stderr,
+            "usage: %s [-b] [-C] [-o dir [-B]] [-T fragment-timeout-sec] [capture-file]\n"
+            "  -b  capture is length-prefixed binary records instead of hex lines\n"
+            "  -C  records are CCSDS TM transfer frames carrying the frames in space packets\n"
+            "  -o  write one CSV per source into dir, link rows into dir/link.csv\n"
+            "  -B  with -o, also write each source's frames as a binary capture\n"
+            "  -T  seconds a message may wait for a missing fragment (default 5)\n",
+            Name);
+}
+
+int main(int argc, char *argv[])
+{
+    const uint8_t *data;
+    size_t         size;
+    int            mapped;
+    int            binary = 0;
+    int            opt;
+    char           path[4096];
+    unsigned long  attempts;
+
+    while ((opt = getopt(argc, argv, "bCo:BT:")) != -1)
+    {
+        switch (opt)
+        {
+            case 'b':
+                binary = 1;
+                break;
+
+            case 'C':
+                rf_decode_tm.Enabled = 1;
+                break;
+
+            case 'o':
+                rf_decode_dir = optarg;
+                break;
+
+            case 'B':
+                rf_decode_bin_export = 1;
+                break;
+
+            case 'T':
+                rf_decode_reasm.TimeoutSec = atof(optarg);
+                break;
+
+            default:
+                rf_decode_usage(argv[0]);
+                return 2;
+        }
+    }
+
+    if (argc - optind > 1 || (rf_decode_bin_export && rf_decode_dir == NULL))
+    {
+        rf_decode_usage(argv[0]);
+        return 2;
+    }
+
+    rf_decode_init_hex();
+    setvbuf(stdout, NULL, _IOFBF, RF_DECODE_STDIO_BUF);
+    rf_decode_out = stdout;
+    rf_decode_log = stdout;
+
+    if (rf_decode_dir != NULL)
+    {
+        snprintf(path, sizeof(path), "%s/link.csv", rf_decode_dir);
+        rf_decode_log = fopen(path, "w");
+        if (rf_decode_log == NULL)
+        {
+            perror(path);
+            return 1;
+        }
+        setvbuf(rf_decode_log, NULL, _IOFBF, RF_DECODE_STDIO_BUF);
+    }
+
+    data = rf_decode_load((optind < argc) ? argv[optind] : NULL, &size, &mapped);
+
+    if (binary)
+    {
+        rf_decode_bin_capture(data, size);
+    }
+    else
+    {
+        rf_decode_hex_capture((const char *)data, size);
+    }
+
+    /* Whatever is still waiting for fragments at the end never completes */
+    for (int i = 0; i < RF_DECODE_FRAG_SLOTS; i++)
+    {
+        if (rf_decode_reasm.Slots[i].Used)
+        {
+            rf_decode_out = stdout;
+            rf_decode_select("fragment", NULL, 0);
+            rf_decode_frag_fail(&rf_decode_reasm.Slots[i], "incomplete");
+        }
+    }
+
+    if (rf_decode_lz.Active)
+    {
+        rf_decode_lz_fail("incomplete");
+    }
+
+    fprintf(stderr, "frames %lu, lost %lu, late %lu, loss %.2f%%\n", rf_decode_link.Received, rf_decode_link.Lost,
+            rf_decode_link.Late,
+            (rf_decode_link.Received + rf_decode_link.Lost) == 0
+                ? 0.0
+                : 100.0 * rf_decode_link.Lost / (rf_decode_link.Received + rf_decode_link.Lost));
+
+    attempts = rf_decode_reasm.Messages + rf_decode_reasm.Failed;
+    if (attempts > 0)
+    {
+        fprintf(stderr, "messages %lu, failed %lu, failure %.2f%%, fragment efficiency %.1f%%\n",
+                rf_decode_reasm.Messages, rf_decode_reasm.Failed, 100.0 * rf_decode_reasm.Failed / attempts,
+                rf_decode_reasm.FrameBytes == 0 ? 0.0
+                                                : 100.0 * rf_decode_reasm.DataBytes / rf_decode_reasm.FrameBytes);
+    }
+
+    if (rf_decode_tm.Enabled)
+    {
+        fprintf(stderr, "transfer frames %lu, bad CRC %lu, lost %lu, packets %lu, idle %lu bytes\n",
+                rf_decode_tm.Frames, rf_decode_tm.BadCrc, rf_decode_tm.Lost, rf_decode_tm.Packets,
+                rf_decode_tm.IdleBytes);
+    }
+
+    if (rf_decode_lz.Blocks + rf_decode_lz.Lost > 0)
+    {
+        fprintf(stderr, "compressed blocks %lu, lost %lu, frames %lu, ratio %.1f%%\n", rf_decode_lz.Blocks,
+                rf_decode_lz.Lost, rf_decode_lz.Frames,
+                rf_decode_lz.FrameBytes == 0 ? 0.0 : 100.0 * rf_decode_lz.PieceBytes / rf_decode_lz.FrameBytes);
+    }
+
+    if (rf_decode_test.Received > 0)
+    {
+        fprintf(stderr, "test frames %lu, lost %lu, corrupt %lu, loss %.2f%%\n", rf_decode_test.Received,
+                rf_decode_test.Lost, rf_decode_test.Corrupt,
+                100.0 * rf_decode_test.Lost / (rf_decode_test.Received + rf_decode_test.Lost));
+    }
+
+    if (mapped)
+    {
+        munmap((void *)data, size);
+    }
+
+    for (int i = 0; i < rf_decode_sink_count; i++)
+    {
+        fclose(rf_decode_sinks[i].Csv);
+        if (rf_decode_sinks[i].Bin != NULL)
+        {
+            fclose(rf_decode_sinks[i].Bin);
+        }
+    }
+    if (rf_decode_log != stdout)
+    {
+        fclose(rf_decode_log);
+    }
+    fflush(stdout);
+
+    return 0;
+}
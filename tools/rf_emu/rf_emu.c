@@ -0,0 +1,561 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * \file
+ *   Host emulator of the RF microcontroller and its radio link.
+ *
+ *   rf_emu_transport stands in for the uC at UC_ADDRESS behind the gen-uC
+ *   driver. Every transfer costs the modelled I2C time. Written frames go to
+ *   a transmit buffer of limited size and leave it at the modelled on-air
+ *   rate; a write that does not fit is NAKed, as the uC does when its
+ *   buffer is full. Aired frames can take bit errors and are written to a
+ *   capture in the rf_decode hex format.
+ *
+ *   A scenario file changes the model over time and injects faults. Each
+ *   line is a time in ms from the start, a keyword and its values; '#'
+ *   starts a comment:
+ *
+ *     buffer  BYTES          transmit buffer size
+ *     air     US_PER_BYTE US_PER_FRAME
+ *     i2c     US US_PER_BYTE transaction cost
+ *     nak     P              chance a transfer is NAKed
+ *     timeout P              chance a transfer hangs until the driver
+ *                            gives up and recovers the bus
+ *     ber     P              chance an aired bit is flipped
+ *     stuck   MS             bus held low for MS, recovery does not help
+ *     outage  MS             radio off for MS, the buffer does not drain
+ *
+ *   Faults are drawn from a seeded generator, so a scenario replays the same
+ *   way for a given seed and call sequence.
+ */
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "rf_emu.h"
+
+#define RF_EMU_EVENTS     256
+#define RF_EMU_FRAMES     256
+#define RF_EMU_LINE_MAX   256
+
+/*
+** A stalled transfer returns on its own after this many deadlines, in case
+** the driver runs without one
+*/
+#define RF_EMU_STALL_DEADLINES 4
+
+typedef enum
+{
+    RF_EMU_BUFFER,
+    RF_EMU_AIR,
+    RF_EMU_I2C,
+    RF_EMU_NAK,
+    RF_EMU_TIMEOUT,
+    RF_EMU_BER,
+    RF_EMU_STUCK,
+    RF_EMU_OUTAGE
+} rf_emu_kind_t;
+
+typedef struct
+{
+    uint32_t      AtMsec;
+    rf_emu_kind_t Kind;
+    double        A;
+    double        B;
+} rf_emu_event_t;
+
+typedef struct
+{
+    uint16_t Len;
+    uint64_t EnqueuedNs;
+    uint8_t  Data[UC_XFER_MAX];
+} rf_emu_frame_t;
+
+static const struct
+{
+    const char   *Name;
+    rf_emu_kind_t Kind;
+    int           Args;
+} rf_emu_keywords[] = {
+    {"buffer", RF_EMU_BUFFER, 1}, {"air", RF_EMU_AIR, 2},         {"i2c", RF_EMU_I2C, 2},
+    {"nak", RF_EMU_NAK, 1},       {"timeout", RF_EMU_TIMEOUT, 1}, {"ber", RF_EMU_BER, 1},
+    {"stuck", RF_EMU_STUCK, 1},   {"outage", RF_EMU_OUTAGE, 1},
+};
+
+static struct
+{
+    pthread_mutex_t Lock;
+    rf_emu_model_t  Model;
+    rf_emu_stats_t  Stats;
+    rf_emu_event_t  Events[RF_EMU_EVENTS];
+    int             EventCount;
+    int             NextEvent;
+    uint64_t        StartNs;
+    uint64_t        StuckUntilNs;
+    uint64_t        OutageFromNs;
+    uint64_t        OutageUntilNs;
+    volatile int    Hung;
+    uint64_t        AirFreeNs;
+    rf_emu_frame_t  Frames[RF_EMU_FRAMES];
+    uint32_t        Head;
+    uint32_t        Count;
+    uint32_t        Buffered;
+    uint64_t        Rand;
+    FILE           *Capture;
+} rf_emu = {
+    .Lock  = PTHREAD_MUTEX_INITIALIZER,
+    .Model = {
+        .BufferBytes    = 256,
+        .AirUsecPerByte = 833, /* 9600 bit/s */
+        .AirUsecFrame   = 5000,
+        .I2cUsec        = 50,
+        .I2cUsecPerByte = 90,
+    },
+    .Rand = 1,
+};
+
+/*
+** Uniform in [0, 1), xorshift64*
+*/
+static double rf_emu_random(void)
+{
+    rf_emu.Rand ^= rf_emu.Rand >> 12;
+    rf_emu.Rand ^= rf_emu.Rand << 25;
+    rf_emu.Rand ^= rf_emu.Rand >> 27;
+
+    return (double)((rf_emu.Rand * 2685821657736338717ull) >> 11) / 9007199254740992.0;
+}
+
+static void rf_emu_sleep_usec(uint64_t Usec)
+{
+    struct timespec ts;
+
+    ts.tv_sec  = (time_t)(Usec / 1000000u);
+    ts.tv_nsec = (long)(Usec % 1000000u) * 1000L;
+    while (nanosleep(&ts, &ts) != 0 && errno == EINTR)
+    {
+    }
+}
+
+/*
+** Put the frame at the head of the buffer on the air
+*/
+static void rf_emu_air(uint64_t DoneNs)
+{
+    rf_emu_frame_t *frame = &rf_emu.Frames[rf_emu.Head];
+    double          wait  = (double)(DoneNs - frame->EnqueuedNs) / 1e9;
+    int             flips = 0;
+
+    if (rf_emu.Model.BitErrorRate > 0.0)
+    {
+        for (int bit = 0; bit < frame->Len * 8; bit++)
+        {
+            if (rf_emu_random() < rf_emu.Model.BitErrorRate)
+            {
+                frame->Data[bit / 8] ^= (uint8_t)(0x80u >> (bit % 8));
+                ++flips;
+            }
+        }
+    }
+
+    if (rf_emu.Capture != NULL)
+    {
+        for (int i = 0; i < frame->Len; i++)
+        {
+            fprintf(rf_emu.Capture, "%02X", frame->Data[i]);
+        }
+        fputc('\n', rf_emu.Capture);
+    }
+
+    ++rf_emu.Stats.Aired;
+    rf_emu.Stats.AiredBytes += frame->Len;
+    rf_emu.Stats.Corrupted += (flips != 0);
+    rf_emu.Stats.WaitSecSum += wait;
+    if (wait > rf_emu.Stats.WaitSecMax)
+    {
+        rf_emu.Stats.WaitSecMax = wait;
+    }
+
+    rf_emu.AirFreeNs = DoneNs;
+    rf_emu.Buffered -= frame->Len;
+    rf_emu.Head = (rf_emu.Head + 1) % RF_EMU_FRAMES;
+    --rf_emu.Count;
+}
+
+/*
+** Send the frames whose air time ended by Now
+*/
+static void rf_emu_drain(uint64_t Now)
+{
+    rf_emu_frame_t *frame;
+    uint64_t        start;
+    uint64_t        done;
+
+    while (rf_emu.Count > 0)
+    {
+        frame = &rf_emu.Frames[rf_emu.Head];
+
+        start = (rf_emu.AirFreeNs > frame->EnqueuedNs) ? rf_emu.AirFreeNs : frame->EnqueuedNs;
+        if (start >= rf_emu.OutageFromNs && start < rf_emu.OutageUntilNs)
+        {
+            start = rf_emu.OutageUntilNs;
+        }
+
+        done = start + ((uint64_t)rf_emu.Model.AirUsecFrame + (uint64_t)frame->Len * rf_emu.Model.AirUsecPerByte) * 1000u;
+        if (done > Now)
+        {
+            break;
+        }
+
+        rf_emu_air(done);
+    }
+}
+
+/*
+** Bring the emulator up to Now: scenario events in order, each after the
+** buffer drained up to its time
+*/
+static void rf_emu_advance(uint64_t Now)
+{
+    rf_emu_event_t *event;
+    uint64_t        at;
+
+    while (rf_emu.NextEvent < rf_emu.EventCount)
+    {
+        event = &rf_emu.Events[rf_emu.NextEvent];
+        at    = rf_emu.StartNs + (uint64_t)event->AtMsec * 1000000u;
+        if (at > Now)
+        {
+            break;
+        }
+
+        rf_emu_drain(at);
+
+        switch (event->Kind)
+        {
+            case RF_EMU_BUFFER:
+                rf_emu.Model.BufferBytes = (uint32_t)event->A;
+                break;
+            case RF_EMU_AIR:
+                rf_emu.Model.AirUsecPerByte = (uint32_t)event->A;
+                rf_emu.Model.AirUsecFrame   = (uint32_t)event->B;
+                break;
+            case RF_EMU_I2C:
+                rf_emu.Model.I2cUsec        = (uint32_t)event->A;
+                rf_emu.Model.I2cUsecPerByte = (uint32_t)event->B;
+                break;
+            case RF_EMU_NAK:
+                rf_emu.Model.NakProb = event->A;
+                break;
+            case RF_EMU_TIMEOUT:
+                rf_emu.Model.TimeoutProb = event->A;
+                break;
+            case RF_EMU_BER:
+                rf_emu.Model.BitErrorRate = event->A;
+                break;
+            case RF_EMU_STUCK:
+                rf_emu.StuckUntilNs = at + (uint64_t)(event->A * 1e6);
+                break;
+            case RF_EMU_OUTAGE:
+                rf_emu.OutageFromNs  = at;
+                rf_emu.OutageUntilNs = at + (uint64_t)(event->A * 1e6);
+                break;
+        }
+
+        ++rf_emu.NextEvent;
+    }
+
+    rf_emu_drain(Now);
+}
+
+/*
+** Wait out a stuck or hung bus, until it is released or the wait gives up
+*/
+static int rf_emu_stall(void)
+{
+    uint64_t start = uC_monotonic_ns();
+    uint64_t limit = (uint64_t)uC_get_deadline_ms() * RF_EMU_STALL_DEADLINES * 1000000u;
+    int      held;
+
+    for (;;)
+    {
+        pthread_mutex_lock(&rf_emu.Lock);
+        held = rf_emu.Hung || uC_monotonic_ns() < rf_emu.StuckUntilNs;
+        pthread_mutex_unlock(&rf_emu.Lock);
+
+        if (!held)
+        {
+            return 0;
+        }
+        if (uC_monotonic_ns() - start >= limit)
+        {
+            return -EIO;
+        }
+        rf_emu_sleep_usec(1000);
+    }
+}
+
+/*
+** Common part of every transfer: faults, then the bus time for Len bytes
+*/
+static int rf_emu_xfer(uint16_t Len)
+{
+    uint32_t usec;
+    int      stuck;
+    int      hang;
+    int      nak;
+
+    pthread_mutex_lock(&rf_emu.Lock);
+    rf_emu_advance(uC_monotonic_ns());
+    stuck = uC_monotonic_ns() < rf_emu.StuckUntilNs;
+    hang  = !stuck && rf_emu.Model.TimeoutProb > 0.0 && rf_emu_random() < rf_emu.Model.TimeoutProb;
+    nak   = !stuck && !hang && rf_emu.Model.NakProb > 0.0 && rf_emu_random() < rf_emu.Model.NakProb;
+    usec  = rf_emu.Model.I2cUsec + (uint32_t)Len * rf_emu.Model.I2cUsecPerByte;
+    if (stuck)
+    {
+        ++rf_emu.Stats.StuckXfers;
+    }
+    if (hang)
+    {
+        ++rf_emu.Stats.Timeouts;
+        rf_emu.Hung = 1;
+    }
+    if (nak)
+    {
+        ++rf_emu.Stats.Naks;
+    }
+    pthread_mutex_unlock(&rf_emu.Lock);
+
+    if (stuck || hang)
+    {
+        /* Returns late: the driver has abandoned the transfer by then */
+        rf_emu_stall();
+        return -EIO;
+    }
+
+    rf_emu_sleep_usec(usec);
+
+    return nak ? -EIO : 0;
+}
+
+static int rf_emu_attach(const char *BusPath, const char *DevPath)
+{
+    (void)BusPath;
+    (void)DevPath;
+
+    return 0;
+}
+
+static int rf_emu_probe(void)
+{
+    pthread_mutex_lock(&rf_emu.Lock);
+    ++rf_emu.Stats.Probes;
+    pthread_mutex_unlock(&rf_emu.Lock);
+
+    return rf_emu_xfer(0);
+}
+
+static int rf_emu_write(uint16_t Addr, const uint8_t *Buf, uint16_t Len)
+{
+    rf_emu_frame_t *frame;
+    int             rv;
+
+    (void)Addr;
+
+    rv = rf_emu_xfer(Len);
+    if (rv < 0)
+    {
+        return rv;
+    }
+
+    pthread_mutex_lock(&rf_emu.Lock);
+    rf_emu_advance(uC_monotonic_ns());
+
+    ++rf_emu.Stats.Writes;
+    if (rf_emu.Buffered + Len > rf_emu.Model.BufferBytes || rf_emu.Count == RF_EMU_FRAMES)
+    {
+        ++rf_emu.Stats.FullNaks;
+        pthread_mutex_unlock(&rf_emu.Lock);
+        return -EIO;
+    }
+
+    frame             = &rf_emu.Frames[(rf_emu.Head + rf_emu.Count) % RF_EMU_FRAMES];
+    frame->Len        = Len;
+    frame->EnqueuedNs = uC_monotonic_ns();
+    memcpy(frame->Data, Buf, Len);
+    ++rf_emu.Count;
+
+    rf_emu.Buffered += Len;
+    if (rf_emu.Buffered > rf_emu.Stats.MaxBuffered)
+    {
+        rf_emu.Stats.MaxBuffered = rf_emu.Buffered;
+    }
+    pthread_mutex_unlock(&rf_emu.Lock);
+
+    return 0;
+}
+
+static int rf_emu_read(uint16_t Addr, uint8_t Reg, uint8_t *Buf, uint16_t Len)
+{
+    int rv;
+
+    (void)Addr;
+    (void)Reg;
+
+    pthread_mutex_lock(&rf_emu.Lock);
+    ++rf_emu.Stats.Reads;
+    pthread_mutex_unlock(&rf_emu.Lock);
+
+    /* The register byte goes out before the data comes back */
+    rv = rf_emu_xfer((uint16_t)(Len + 1));
+    if (rv < 0)
+    {
+        return rv;
+    }
+
+    /* Nothing in the uplink mailbox */
+    memset(Buf, 0, Len);
+
+    return Len;
+}
+
+static int rf_emu_recover(void)
+{
+    pthread_mutex_lock(&rf_emu.Lock);
+    ++rf_emu.Stats.Recoveries;
+    rf_emu.Hung = 0;
+    pthread_mutex_unlock(&rf_emu.Lock);
+
+    /* A stuck bus stays stuck however many clocks it gets */
+    return (uC_monotonic_ns() < rf_emu.StuckUntilNs) ? -EIO : 0;
+}
+
+const uC_transport rf_emu_transport = {
+    .name    = "rf_emu",
+    .attach  = rf_emu_attach,
+    .probe   = rf_emu_probe,
+    .write   = rf_emu_write,
+    .read    = rf_emu_read,
+    .recover = rf_emu_recover,
+};
+
+/*
+** Read a scenario file, returns 0 or -1 after printing the error
+*/
+int rf_emu_load(const char *Path)
+{
+    FILE           *file;
+    char            line[RF_EMU_LINE_MAX];
+    char            word[16];
+    rf_emu_event_t *event;
+    unsigned long   at;
+    uint32_t        last = 0;
+    int             lineno = 0;
+    int             fields;
+    size_t          k;
+
+    file = fopen(Path, "r");
+    if (file == NULL)
+    {
+        perror(Path);
+        return -1;
+    }
+
+    rf_emu.EventCount = 0;
+    while (fgets(line, sizeof(line), file) != NULL)
+    {
+        ++lineno;
+        line[strcspn(line, "#\r\n")] = '\0';
+        if (line[strspn(line, " \t")] == '\0')
+        {
+            continue;
+        }
+
+        if (rf_emu.EventCount == RF_EMU_EVENTS)
+        {
+            fprintf(stderr, "%s:%d: more than %d events\n", Path, lineno, RF_EMU_EVENTS);
+            fclose(file);
+            return -1;
+        }
+
+        event  = &rf_emu.Events[rf_emu.EventCount];
+        event->B = 0.0;
+        fields = sscanf(line, "%lu %15s %lf %lf", &at, word, &event->A, &event->B);
+
+        for (k = 0; k < sizeof(rf_emu_keywords) / sizeof(rf_emu_keywords[0]); k++)
+        {
+            if (fields >= 2 && strcmp(word, rf_emu_keywords[k].Name) == 0)
+            {
+                break;
+            }
+        }
+
+        if (k == sizeof(rf_emu_keywords) / sizeof(rf_emu_keywords[0]) || fields != 2 + rf_emu_keywords[k].Args ||
+            event->A < 0.0 || event->B < 0.0 || at < last)
+        {
+            fprintf(stderr, "%s:%d: bad event '%s'\n", Path, lineno, line);
+            fclose(file);
+            return -1;
+        }
+
+        event->AtMsec = (uint32_t)at;
+        event->Kind   = rf_emu_keywords[k].Kind;
+        last          = (uint32_t)at;
+        ++rf_emu.EventCount;
+    }
+
+    fclose(file);
+
+    return 0;
+}
+
+/*
+** Start the clock the scenario times count from
+*/
+void rf_emu_start(uint32_t Seed, FILE *Capture)
+{
+    pthread_mutex_lock(&rf_emu.Lock);
+    rf_emu.StartNs   = uC_monotonic_ns();
+    rf_emu.AirFreeNs = rf_emu.StartNs;
+    rf_emu.NextEvent = 0;
+    rf_emu.Rand      = ((uint64_t)Seed << 1) | 1u;
+    rf_emu.Capture   = Capture;
+    rf_emu_advance(rf_emu.StartNs);
+    pthread_mutex_unlock(&rf_emu.Lock);
+}
+
+/*
+** Apply the events and air the frames due by now, between transfers
+*/
+void rf_emu_step(void)
+{
+    pthread_mutex_lock(&rf_emu.Lock);
+    rf_emu_advance(uC_monotonic_ns());
+    pthread_mutex_unlock(&rf_emu.Lock);
+}
+
+void rf_emu_get_stats(rf_emu_stats_t *Stats)
+{
+    pthread_mutex_lock(&rf_emu.Lock);
+    *Stats = rf_emu.Stats;
+    pthread_mutex_unlock(&rf_emu.Lock);
+}
@@ -0,0 +1,73 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ * Host emulator of the RF microcontroller and its radio link
+ */
+
+#ifndef RF_EMU_H
+#define RF_EMU_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include "gen-uC.h"
+
+/*
+** Link model, changed over time by the scenario
+*/
+typedef struct
+{
+    uint32_t BufferBytes;    /* uC transmit buffer; a write that does not fit is NAKed */
+    uint32_t AirUsecPerByte; /* On-air time per frame byte */
+    uint32_t AirUsecFrame;   /* On-air overhead per frame: preamble, sync, turnaround */
+    uint32_t I2cUsec;        /* Fixed cost of an I2C transaction */
+    uint32_t I2cUsecPerByte; /* Per byte transferred, about 90 us at 100 kHz */
+    double   NakProb;        /* Chance a transfer is NAKed */
+    double   TimeoutProb;    /* Chance a transfer hangs past the deadline */
+    double   BitErrorRate;   /* Chance each aired bit is flipped */
+} rf_emu_model_t;
+
+typedef struct
+{
+    unsigned long Writes;
+    unsigned long Reads;
+    unsigned long Probes;
+    unsigned long Naks;        /* Injected NAKs */
+    unsigned long FullNaks;    /* Writes NAKed because the buffer was full */
+    unsigned long Timeouts;    /* Injected hangs */
+    unsigned long StuckXfers;  /* Transfers that found the bus stuck */
+    unsigned long Recoveries;  /* Recoveries run by the driver */
+    unsigned long Aired;       /* Frames sent on air */
+    unsigned long AiredBytes;
+    unsigned long Corrupted;   /* Frames aired with bit errors */
+    uint32_t      MaxBuffered; /* Buffer high-water mark, bytes */
+    double        WaitSecSum;  /* Buffer entry to end of air time, all frames */
+    double        WaitSecMax;
+} rf_emu_stats_t;
+
+extern const uC_transport rf_emu_transport;
+
+int  rf_emu_load(const char *Path);
+void rf_emu_start(uint32_t Seed, FILE *Capture);
+void rf_emu_step(void);
+void rf_emu_get_stats(rf_emu_stats_t *Stats);
+
+#endif /* RF_EMU_H */
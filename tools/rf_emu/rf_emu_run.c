@@ -0,0 +1,384 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * \file
+ *   Runs the RF Telemetry Output forwarding path against the uC emulator.
+ *
+ *   The flight sources are built against the cFE stand-in of rf_bench. The
+ *   run loop is driven the way RF_TLM_Main() drives it, with every source
+ *   publishing samples at a set rate, for a set time. At the end the app's
+ *   counters, the gen-uC bus statistics and the emulator's view of the link
+ *   are printed, so pacing and retry settings can be compared under the
+ *   same scenario and seed.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "rf_tlm_events.h"
+#include "rf_tlm.h"
+#include "rf_emu.h"
+
+static void rf_emu_usage(const char *Prog)
+{
+    fprintf(stderr,
+            "usage: %s [-d seconds] [-r hz] [-p profile] [-s seed] [-w capture] [-C] [-Z] [-c open/period] [-q seconds]\n"
+            "          [scenario]\n"
+            "  -d  run time (default 10 s)\n"
+            "  -r  samples per second from each source (default 10)\n"
+            "  -p  link profile to run with (default the startup one)\n"
+            "  -s  fault generator seed (default 1)\n"
+            "  -w  write the aired frames, one hex frame per line, for rf_decode\n"
+            "  -C  send CCSDS transfer frames (decode the capture with rf_decode -C)\n"
+            "  -Z  compress the downlink\n"
+            "  -c  contact windows of open seconds every period seconds, the first after one period\n"
+            "  -q  put every source on pull and request a snapshot of all of them every seconds\n",
+            Prog);
+}
+
+/*
+** Publish one sample of a source on the telemetry pipe and forward it
+*/
+static void rf_emu_publish(CFE_SB_MsgId_Atom_t MsgId, uint32 Count)
+{
+    static union
+    {
+        CFE_SB_Buffer_t    Buf;
+        SUBS_APP_OutData_t Sample;
+    } sample;
+
+    memset(&sample, 0, sizeof(sample));
+    CFE_MSG_Init(CFE_MSG_PTR(sample.Sample.TelemetryHeader), CFE_SB_ValueToMsgId(MsgId), sizeof(sample.Sample));
+    sample.Sample.AppID_H = (uint8)(MsgId >> 8);
+    sample.Sample.AppID_L = (uint8)MsgId;
+
+    /* A ramp, so the deadband lets every sample through */
+    for (int i = 0; i < 4; i++)
+    {
+        sample.Sample.byte_group_1[i] = (uint8)(Count >> (8 * (3 - i)));
+        sample.Sample.byte_group_2[i] = (uint8)((Count * 7) >> (8 * (3 - i)));
+        sample.Sample.byte_group_3[i] = (uint8)((Count * 13) >> (8 * (3 - i)));
+    }
+
+    CFE_Shim_QueueBuffer(RF_TLM_Data.TlmPipe, &sample.Buf);
+    RF_TLM_forward_telemetry();
+}
+
+int main(int argc, char *argv[])
+{
+    const char     *scenario = NULL;
+    const char     *profile  = NULL;
+    const char     *capture_path = NULL;
+    FILE           *capture  = NULL;
+    double          seconds  = 10.0;
+    double          rate     = 10.0;
+    uint32_t        seed     = 1;
+    bool            ccsds    = false;
+    bool            compress = false;
+    unsigned int    contact_open   = 0;
+    unsigned int    contact_period = 0;
+    RF_TLM_ContactTable_t contacts;
+    double          snap_secs = 0.0;
+    RF_TLM_SnapshotCmd_t snap;
+    uint64_t        next_snap = 0;
+    uint64_t        now;
+    uint64_t        end;
+    uint64_t        next_sample;
+    uint64_t        period;
+    uint32          wait;
+    uint32          samples  = 0;
+    unsigned long   drops    = 0;
+    int32           id;
+    uC_stats        bus;
+    rf_emu_stats_t  emu;
+    struct timespec ts;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (i + 1 < argc && strcmp(argv[i], "-d") == 0)
+        {
+            seconds = atof(argv[++i]);
+        }
+        else if (i + 1 < argc && strcmp(argv[i], "-r") == 0)
+        {
+            rate = atof(argv[++i]);
+        }
+        else if (i + 1 < argc && strcmp(argv[i], "-p") == 0)
+        {
+            profile = argv[++i];
+        }
+        else if (i + 1 < argc && strcmp(argv[i], "-s") == 0)
+        {
+            seed = (uint32_t)strtoul(argv[++i], NULL, 0);
+        }
+        else if (i + 1 < argc && strcmp(argv[i], "-w") == 0)
+        {
+            capture_path = argv[++i];
+        }
+        else if (strcmp(argv[i], "-C") == 0)
+        {
+            ccsds = true;
+        }
+        else if (strcmp(argv[i], "-Z") == 0)
+        {
+            compress = true;
+        }
+        else if (i + 1 < argc && strcmp(argv[i], "-c") == 0)
+        {
+            if (sscanf(argv[++i], "%u/%u", &contact_open, &contact_period) != 2 || contact_open == 0 ||
+                contact_open >= contact_period)
+            {
+                rf_emu_usage(argv[0]);
+                return 2;
+            }
+        }
+        else if (i + 1 < argc && strcmp(argv[i], "-q") == 0)
+        {
+            snap_secs = atof(argv[++i]);
+            if (snap_secs <= 0.0)
+            {
+                rf_emu_usage(argv[0]);
+                return 2;
+            }
+        }
+        else if (argv[i][0] != '-' && scenario == NULL)
+        {
+            scenario = argv[i];
+        }
+        else
+        {
+            rf_emu_usage(argv[0]);
+            return 2;
+        }
+    }
+
+    if (seconds <= 0.0 || rate <= 0.0)
+    {
+        rf_emu_usage(argv[0]);
+        return 2;
+    }
+
+    if (scenario != NULL && rf_emu_load(scenario) < 0)
+    {
+        return 1;
+    }
+
+    if (capture_path != NULL)
+    {
+        capture = fopen(capture_path, "w");
+        if (capture == NULL)
+        {
+            perror(capture_path);
+            return 1;
+        }
+    }
+
+    /* Start up as RF_TLM_Main() does, on the emulated uC */
+    uC_set_transport(&rf_emu_transport);
+    if (RF_TLM_Init() != CFE_SUCCESS)
+    {
+        fprintf(stderr, "RF_TLM_Init failed\n");
+        return 1;
+    }
+    if (profile != NULL)
+    {
+        id = RF_TLM_Profile_Find(profile);
+        if (id < 0)
+        {
+            fprintf(stderr, "unknown profile '%s'\n", profile);
+            return 2;
+        }
+        RF_TLM_Profile_Apply((uint8)id);
+    }
+    uC_set_deadline_ms(RF_TLM_I2C_DEADLINE_MSEC);
+    uC_start(RF_TLM_I2C_WORKER_PRIORITY);
+    RF_TLM_Dev_Init(RF_TLM_GetMsec());
+    RF_TLM_Uplink_Init();
+    RF_TLM_Cpu_Init(RF_TLM_CPU_BUDGET_PERMILLE);
+    RF_TLM_Slot_Init();
+    RF_TLM_Contact_Init();
+    RF_TLM_Cds_Init();
+    RF_TLM_Data.downlink_on = true;
+    if (ccsds)
+    {
+        RF_TLM_Ccsds_Configure(RF_TLM_FRAMING_CCSDS, RF_TLM_CCSDS_SCID, RF_TLM_CCSDS_VCID);
+    }
+    if (compress)
+    {
+        RF_TLM_Lz_Configure(RF_TLM_COMPRESS_LZSS);
+    }
+    if (contact_period != 0)
+    {
+        memset(&contacts, 0, sizeof(contacts));
+        contacts.SummaryMsec = contact_period * 1000u / 4;
+        for (uint32 w = 0; w < RF_TLM_MAX_CONTACTS; w++)
+        {
+            contacts.Windows[w].StartSec  = CFE_TIME_GetTime().Seconds + (w + 1) * contact_period;
+            contacts.Windows[w].LengthSec = contact_open;
+        }
+        RF_TLM_Contact_Load(&contacts);
+    }
+
+    if (snap_secs > 0.0)
+    {
+        memset(&snap, 0, sizeof(snap));
+        for (uint16 i = 0; i < RF_TLM_Data.SourceCount && i < RF_TLM_SNAP_MAX_MIDS; i++)
+        {
+            snap.Payload.MsgId[i] = CFE_SB_MsgIdToValue(RF_TLM_Data.Sources[i].MsgId);
+        }
+        snap.Payload.Forward = RF_TLM_SNAP_FWD_PULL;
+    }
+
+    rf_emu_start(seed, capture);
+
+    now         = uC_monotonic_ns();
+    end         = now + (uint64_t)(seconds * 1e9);
+    period      = (uint64_t)(1e9 / rate);
+    next_sample = now;
+    next_snap   = now + (uint64_t)(snap_secs * 1e9);
+
+    while (now < end)
+    {
+        if (now >= next_sample)
+        {
+            for (uint16 i = 0; i < RF_TLM_Data.SourceCount; i++)
+            {
+                rf_emu_publish(CFE_SB_MsgIdToValue(RF_TLM_Data.Sources[i].MsgId), samples);
+            }
+            ++samples;
+            next_sample += period;
+
+            /* After a stall, carry on at the set rate rather than catching up in a burst */
+            if (next_sample < now)
+            {
+                next_sample = now + period;
+            }
+        }
+
+        /* The first request also puts the sources on pull, the samples before it are forwarded */
+        if (snap_secs > 0.0 && now >= next_snap)
+        {
+            RF_TLM_Snapshot(&snap);
+            snap.Payload.Forward = RF_TLM_SNAP_FWD_KEEP;
+            next_snap += (uint64_t)(snap_secs * 1e9);
+        }
+
+        RF_TLM_Dev_Step();
+        RF_TLM_forward_events();
+        RF_TLM_forward_telemetry();
+        RF_TLM_Uplink_Step();
+        RF_TLM_Contact_Step();
+        RF_TLM_send_queued();
+        RF_TLM_Cds_Step();
+        rf_emu_step();
+
+        wait = RF_TLM_Uplink_WaitMsec(RF_TLM_Slot_WaitMsec(RF_TLM_Contact_WaitMsec(
+            (RF_TLM_Contact_IntervalMsec() < RF_TLM_TASK_MSEC) ? RF_TLM_Contact_IntervalMsec() : RF_TLM_TASK_MSEC)));
+        if (wait < 1)
+        {
+            wait = 1;
+        }
+
+        /* Wake for the next sample, rounded up so the loop does not spin on it */
+        now = uC_monotonic_ns();
+        if (next_sample <= now)
+        {
+            wait = 0;
+        }
+        else if ((next_sample - now + 999999u) / 1000000u < wait)
+        {
+            wait = (uint32)((next_sample - now + 999999u) / 1000000u);
+        }
+        if (snap_secs > 0.0 && wait > 0)
+        {
+            if (next_snap <= now)
+            {
+                wait = 0;
+            }
+            else if ((next_snap - now + 999999u) / 1000000u < wait)
+            {
+                wait = (uint32)((next_snap - now + 999999u) / 1000000u);
+            }
+        }
+        ts.tv_sec  = wait / 1000;
+        ts.tv_nsec = (long)(wait % 1000) * 1000000L;
+        nanosleep(&ts, NULL);
+
+        now = uC_monotonic_ns();
+    }
+
+    rf_emu_step();
+    uC_get_stats(&bus);
+    rf_emu_get_stats(&emu);
+
+    for (uint16 i = 0; i < RF_TLM_Data.SourceCount; i++)
+    {
+        drops += RF_TLM_Data.Sources[i].Queue.DroppedCount;
+    }
+
+    printf("app  samples %lu, frames sent %lu, send errors %lu, queue drops %lu, probes %lu, probe failures %lu\n",
+           (unsigned long)samples * RF_TLM_Data.SourceCount, (unsigned long)RF_TLM_Data.PcktCounter,
+           (unsigned long)RF_TLM_Data.PcktErrCounter, drops, (unsigned long)RF_TLM_Data.Dev.ProbeAttempts,
+           (unsigned long)RF_TLM_Data.Dev.ProbeFailures);
+    printf("bus  writes %lu, reads %lu, errors %lu, timeouts %lu, recoveries %lu, recovery failures %lu, "
+           "busy rejects %lu, max transfer %.2f ms\n",
+           (unsigned long)bus.writes, (unsigned long)bus.reads, (unsigned long)bus.errors,
+           (unsigned long)bus.timeouts, (unsigned long)bus.recoveries, (unsigned long)bus.recovery_failures,
+           (unsigned long)bus.busy_rejects, bus.max_ns / 1e6);
+    printf("uc   writes %lu, reads %lu, naks %lu, buffer full %lu, hangs %lu, stuck %lu\n", emu.Writes, emu.Reads,
+           emu.Naks, emu.FullNaks, emu.Timeouts, emu.StuckXfers);
+    printf("air  frames %lu, bytes %lu, corrupted %lu, buffer peak %lu B, wait mean %.1f ms, max %.1f ms\n",
+           emu.Aired, emu.AiredBytes, emu.Corrupted, (unsigned long)emu.MaxBuffered,
+           emu.Aired == 0 ? 0.0 : 1e3 * emu.WaitSecSum / emu.Aired, 1e3 * emu.WaitSecMax);
+
+    if (compress)
+    {
+        printf("lz   blocks %lu, stored %lu, frame bytes %lu, piece bytes %lu, ratio %.1f%%, "
+               "%.2f us/frame last, %.2f max\n",
+               (unsigned long)RF_TLM_Data.Lz.Blocks, (unsigned long)RF_TLM_Data.Lz.Stored,
+               (unsigned long)RF_TLM_Data.Lz.InBytes, (unsigned long)RF_TLM_Data.Lz.OutBytes,
+               RF_TLM_Data.Lz.InBytes == 0 ? 0.0 : 100.0 * RF_TLM_Data.Lz.OutBytes / RF_TLM_Data.Lz.InBytes,
+               RF_TLM_Data.Lz.FrameNsec / 1e3, RF_TLM_Data.Lz.FrameNsecMax / 1e3);
+    }
+
+    if (contact_period != 0)
+    {
+        printf("contact windows %lu, frames %lu, backlog %u, utilization %u/1000, carried %u frames %lu B\n",
+               (unsigned long)RF_TLM_Data.Contact.Windows, (unsigned long)RF_TLM_Data.Contact.Frames,
+               (unsigned int)RF_TLM_Data.Contact.Backlog, (unsigned int)RF_TLM_Data.Contact.UtilPermille,
+               (unsigned int)RF_TLM_Data.Contact.Carried, (unsigned long)RF_TLM_Data.Contact.CarriedBytes);
+    }
+
+    if (snap_secs > 0.0)
+    {
+        printf("snap requests %lu, frames %lu, sent %lu, missing %lu, held %lu, latency %u ms last, %u max\n",
+               (unsigned long)RF_TLM_Data.Snap.Requests, (unsigned long)RF_TLM_Data.Snap.Queued,
+               (unsigned long)RF_TLM_Data.Snap.Sent, (unsigned long)RF_TLM_Data.Snap.Missing,
+               (unsigned long)RF_TLM_Data.Snap.Held, (unsigned int)RF_TLM_Data.Snap.LatencyMsec,
+               (unsigned int)RF_TLM_Data.Snap.LatencyMaxMsec);
+    }
+
+    if (capture != NULL)
+    {
+        fclose(capture);
+    }
+
+    return 0;
+}